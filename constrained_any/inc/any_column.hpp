@@ -0,0 +1,326 @@
+/**
+ * @file any_column.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief structure-of-arrays column of constrained_any values
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#ifndef INC_ANY_COLUMN_HPP_
+#define INC_ANY_COLUMN_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "constrained_any.hpp"
+
+namespace yan {
+
+namespace impl {
+
+/**
+ * @brief interface of a run that keeps the values of same type contiguously
+ */
+template <typename Alias>
+class any_column_run_if {
+public:
+	virtual ~any_column_run_if() = default;
+
+	virtual const std::type_info&              get_type_info( void ) const noexcept = 0;
+	virtual size_t                             size( void ) const noexcept          = 0;
+	virtual size_t                             memory_bytes( void ) const noexcept  = 0;
+	virtual Alias                              make_any( size_t idx ) const         = 0;
+	virtual std::unique_ptr<any_column_run_if> clone( void ) const                  = 0;
+};
+
+template <typename Alias, typename T>
+class any_column_run final : public any_column_run_if<Alias> {
+public:
+	const std::type_info& get_type_info( void ) const noexcept override
+	{
+		return typeid( T );
+	}
+	size_t size( void ) const noexcept override
+	{
+		return values_.size();
+	}
+	size_t memory_bytes( void ) const noexcept override
+	{
+		return sizeof( *this ) + values_.capacity() * sizeof( T );
+	}
+	Alias make_any( size_t idx ) const override
+	{
+		return Alias( std::in_place_type<T>, values_[idx] );
+	}
+	std::unique_ptr<any_column_run_if<Alias>> clone( void ) const override
+	{
+		return std::make_unique<any_column_run>( *this );
+	}
+
+	std::vector<T> values_;
+};
+
+}   // namespace impl
+
+/**
+ * @brief structure-of-arrays column of the values of the specialized type of constrained_any
+ *
+ * Consecutive values of same type are kept as a run, i.e. a raw array of T. A run index of (begin position, type) locates the element.
+ * Therefore, a long run of same type needs only sizeof(T) per element, and the loop per type by for_each_run() is a tight typed loop over T*.
+ *
+ * @tparam Alias specialized type of constrained_any like yan::copyable_any. The value type T should be copy constructible to make Alias from the element.
+ *
+ * @note
+ * Random access by the index is O(log(number of runs)).
+ */
+template <typename Alias>
+class any_column {
+	static_assert( is_specialized_of_constrained_any<Alias>::value, "Alias should be specialized type of constrained_any" );
+
+	template <typename T>
+	using run_t = impl::any_column_run<Alias, T>;
+
+public:
+	using value_type = Alias;
+
+	/**
+	 * @brief read only view of an element that is compatible with constrained_any
+	 */
+	class const_reference {
+	public:
+		const std::type_info& type() const noexcept
+		{
+			return p_column_->type( idx_ );
+		}
+
+		bool has_value() const noexcept
+		{
+			return true;
+		}
+
+		/**
+		 * @brief pointer to the value if the value type is T
+		 *
+		 * @return pointer to the value. If the value type is not T, return nullptr. This is same to constrained_any_cast<T>( const constrained_any* ).
+		 */
+		template <typename T>
+		const T* get_if() const noexcept
+		{
+			return p_column_->template get_if<T>( idx_ );
+		}
+
+		/**
+		 * @brief make Alias that has the copy of the value
+		 */
+		Alias to_any( void ) const
+		{
+			return p_column_->get( idx_ );
+		}
+
+		operator Alias() const
+		{
+			return to_any();
+		}
+
+	private:
+		friend class any_column;
+
+		const_reference( const any_column* p_column, size_t idx ) noexcept
+		  : p_column_( p_column )
+		  , idx_( idx )
+		{
+		}
+
+		const any_column* p_column_;
+		size_t            idx_;
+	};
+
+	any_column()  = default;
+	~any_column() = default;
+	any_column( const any_column& src )
+	  : size_( src.size_ )
+	{
+		runs_.reserve( src.runs_.size() );
+		for ( const auto& cur : src.runs_ ) {
+			runs_.push_back( run_info { cur.begin_, cur.up_run_->clone() } );
+		}
+	}
+	any_column( any_column&& ) = default;
+	any_column& operator=( const any_column& rhs )
+	{
+		if ( this == &rhs ) return *this;
+		any_column( rhs ).swap( *this );
+		return *this;
+	}
+	any_column& operator=( any_column&& ) = default;
+
+	void swap( any_column& src ) noexcept
+	{
+		runs_.swap( src.runs_ );
+		std::swap( size_, src.size_ );
+	}
+
+	/**
+	 * @brief append the value
+	 *
+	 * If the last run has same type, the value is appended to it. Otherwise, new run is started.
+	 */
+	template <typename T, typename VT = std::decay_t<T>,
+	          typename std::enable_if<!std::is_same<VT, Alias>::value && std::is_constructible<Alias, std::in_place_type_t<VT>, const VT&>::value>::type* = nullptr>
+	void push_back( T&& v )
+	{
+		emplace_back<VT>( std::forward<T>( v ) );
+	}
+
+	/**
+	 * @brief construct the value of T at the end
+	 *
+	 * @return reference to the constructed value
+	 */
+	template <typename T, typename... Args>
+	T& emplace_back( Args&&... args )
+	{
+		static_assert( std::is_constructible<Alias, std::in_place_type_t<T>, const T&>::value, "T should be acceptable for Alias and copy constructible" );
+
+		run_t<T>& ref_run = last_run_of<T>();
+		ref_run.values_.emplace_back( std::forward<Args>( args )... );
+		size_++;
+		return ref_run.values_.back();
+	}
+
+	size_t size( void ) const noexcept
+	{
+		return size_;
+	}
+
+	bool empty( void ) const noexcept
+	{
+		return size_ == 0;
+	}
+
+	void clear( void ) noexcept
+	{
+		runs_.clear();
+		size_ = 0;
+	}
+
+	size_t num_of_runs( void ) const noexcept
+	{
+		return runs_.size();
+	}
+
+	/**
+	 * @brief type of the element
+	 *
+	 * @pre idx < size()
+	 */
+	const std::type_info& type( size_t idx ) const noexcept
+	{
+		return find_run( idx ).up_run_->get_type_info();
+	}
+
+	/**
+	 * @brief pointer to the element if the value type is T
+	 *
+	 * @pre idx < size()
+	 */
+	template <typename T>
+	const T* get_if( size_t idx ) const noexcept
+	{
+		const run_info& ref_run = find_run( idx );
+		if ( ref_run.up_run_->get_type_info() != typeid( T ) ) {
+			return nullptr;
+		}
+		return &( static_cast<const run_t<T>&>( *ref_run.up_run_ ).values_[idx - ref_run.begin_] );
+	}
+
+	/**
+	 * @brief make Alias that has the copy of the element
+	 *
+	 * @exception std::out_of_range if idx >= size()
+	 */
+	Alias get( size_t idx ) const
+	{
+		if ( idx >= size_ ) {
+			throw std::out_of_range( "any_column::get() index is out of range" );
+		}
+		const run_info& ref_run = find_run( idx );
+		return ref_run.up_run_->make_any( idx - ref_run.begin_ );
+	}
+
+	/**
+	 * @brief view of the element
+	 *
+	 * @pre idx < size()
+	 */
+	const_reference operator[]( size_t idx ) const noexcept
+	{
+		return const_reference( this, idx );
+	}
+
+	/**
+	 * @brief call f for each run of T
+	 *
+	 * @param f callable object of f( const T* p_values, size_t n ). p_values is the raw array of the run.
+	 */
+	template <typename T, typename F>
+	void for_each_run( F&& f ) const
+	{
+		for ( const auto& cur : runs_ ) {
+			if ( cur.up_run_->get_type_info() != typeid( T ) ) {
+				continue;
+			}
+			const std::vector<T>& ref_values = static_cast<const run_t<T>&>( *cur.up_run_ ).values_;
+			f( ref_values.data(), ref_values.size() );
+		}
+	}
+
+	/**
+	 * @brief heap bytes of this column including the run index
+	 */
+	size_t memory_bytes( void ) const noexcept
+	{
+		size_t ans = runs_.capacity() * sizeof( run_info );
+		for ( const auto& cur : runs_ ) {
+			ans += cur.up_run_->memory_bytes();
+		}
+		return ans;
+	}
+
+private:
+	struct run_info {
+		size_t                                          begin_;   // position of the first element of this run in the column
+		std::unique_ptr<impl::any_column_run_if<Alias>> up_run_;
+	};
+
+	template <typename T>
+	run_t<T>& last_run_of( void )
+	{
+		if ( runs_.empty() || ( runs_.back().up_run_->get_type_info() != typeid( T ) ) ) {
+			runs_.push_back( run_info { size_, std::make_unique<run_t<T>>() } );
+		}
+		return static_cast<run_t<T>&>( *runs_.back().up_run_ );
+	}
+
+	const run_info& find_run( size_t idx ) const noexcept
+	{
+		auto it = std::upper_bound( runs_.begin(), runs_.end(), idx, []( size_t v, const run_info& r ) { return v < r.begin_; } );
+		return *( it - 1 );
+	}
+
+	std::vector<run_info> runs_;
+	size_t                size_ = 0;
+};
+
+}   // namespace yan
+
+#endif
@@ -0,0 +1,512 @@
+/**
+ * @file any_key_archive.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief memory mapped read only archive of keys of constrained_any
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * write_any_key_archive() writes the sorted and unique keys to a file. any_key_archive maps the file by mmap(), and answers
+ * contains() and lower_bound() without constructing any constrained_any.
+ *
+ * File layout(all integers are little endian and 8 bytes aligned)
+ * @li header: magic "YANKARC1", uint32 version, uint32 number of partitions, uint64 number of keys
+ * @li partition table: for each type, uint64 type id, uint64 number of keys, uint64 position of offsets, uint64 position of hash index, uint64 position of payloads
+ * @li offsets: uint64 x (number of keys + 1). begin and end of the payload of each key in the payloads. The keys are sorted by operator< of the value type.
+ * @li hash index: pair of uint64 hash value and uint64 index of the key, sorted by the hash value
+ * @li payloads: payload of serialize_traits<T> of each key
+ *
+ * The type id is same to serialize_registry<Alias>. The reader orders the partitions by std::type_index of the registered type in the reader process.
+ * Therefore, the order of the keys is same to Alias::less() of the reader process.
+ *
+ * @note
+ * This needs POSIX mmap(). The payloads are trusted, i.e. the reader checks the header and the table but does not check each offset.
+ */
+
+#ifndef INC_ANY_KEY_ARCHIVE_HPP_
+#define INC_ANY_KEY_ARCHIVE_HPP_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "constrained_any_serialize.hpp"
+
+namespace yan {
+
+namespace impl {
+
+static constexpr char     any_key_archive_magic[8]       = { 'Y', 'A', 'N', 'K', 'A', 'R', 'C', '1' };
+static constexpr uint32_t any_key_archive_version        = 1;
+static constexpr size_t   any_key_archive_header_size    = 24;
+static constexpr size_t   any_key_archive_partition_size = 40;
+
+inline void any_key_archive_store_u64( unsigned char* p, uint64_t v ) noexcept
+{
+	for ( size_t i = 0; i < 8; i++ ) {
+		p[i] = static_cast<unsigned char>( v >> ( 8 * i ) );
+	}
+}
+
+inline uint64_t any_key_archive_load_u64( const unsigned char* p ) noexcept
+{
+	uint64_t ans;
+	std::memcpy( &ans, p, sizeof( ans ) );
+#if defined( __BYTE_ORDER__ ) && ( __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__ )
+	ans = __builtin_bswap64( ans );
+#endif
+	return ans;
+}
+
+/**
+ * @brief write the blocks to the temporary file and rename it over path
+ *
+ * If a write fails, the temporary file is removed and path is not changed. Therefore, a truncated archive is not left.
+ * std::ofstream does not guarantee errno. Therefore, the failure is reported by std::errc::io_error.
+ */
+inline void any_key_archive_write_file( const std::string& path, const std::vector<unsigned char>* p_blocks, size_t num_of_blocks )
+{
+	std::string tmp_path = path + ".tmp." + std::to_string( ::getpid() );
+
+	bool          is_ok = true;
+	std::ofstream ofs( tmp_path, std::ios::binary | std::ios::trunc );
+	for ( size_t i = 0; is_ok && ( i < num_of_blocks ); i++ ) {
+		is_ok = static_cast<bool>( ofs.write( reinterpret_cast<const char*>( p_blocks[i].data() ), static_cast<std::streamsize>( p_blocks[i].size() ) ) );
+	}
+	if ( is_ok ) {
+		is_ok = static_cast<bool>( ofs.flush() );
+	}
+	ofs.close();
+	is_ok = is_ok && !ofs.fail();
+
+	if ( !is_ok ) {
+		std::remove( tmp_path.c_str() );
+		throw std::system_error( std::make_error_code( std::errc::io_error ), "fail to write any_key_archive: " + path );
+	}
+	if ( std::rename( tmp_path.c_str(), path.c_str() ) != 0 ) {
+		std::remove( tmp_path.c_str() );
+		throw std::system_error( std::make_error_code( std::errc::io_error ), "fail to rename any_key_archive: " + path );
+	}
+}
+
+/**
+ * @brief type to compare the key and the payload
+ *
+ * If serialize_traits<T> has view_type, the payload is compared as view_type without copy.
+ */
+template <typename T, bool = has_serialize_view_type<T>::value>
+struct any_key_archive_compare_type {
+	using type = T;
+
+	static T decode( const unsigned char* p, size_t n )
+	{
+		return serialize_traits<T>::decode( p, n );
+	}
+};
+
+template <typename T>
+struct any_key_archive_compare_type<T, true> {
+	using type = typename serialize_traits<T>::view_type;
+
+	static type decode( const unsigned char* p, size_t n )
+	{
+		return serialize_traits<T>::decode_view( p, n );
+	}
+};
+
+}   // namespace impl
+
+/**
+ * @brief write the keys to the archive file
+ *
+ * The keys are sorted by operator< of Alias, and the duplicated keys are removed.
+ * The archive is written to the temporary file in the same directory, and is renamed over path. Therefore, path has the old file or the complete archive.
+ *
+ * @tparam Alias specialized type of constrained_any that has special_operation_serialize, special_operation_less and special_operation_hash_value, e.g. serializable_keyable_any
+ *
+ * @exception std::system_error if the file could not be written
+ * @exception std::invalid_argument if keys has the empty constrained_any
+ * @exception std::logic_error if the type of a key is not registered to serialize_registry
+ */
+template <typename Alias>
+void write_any_key_archive( const std::string& path, std::vector<Alias> keys )
+{
+	std::sort( keys.begin(), keys.end(), []( const Alias& a, const Alias& b ) { return a.less( b ); } );
+	keys.erase( std::unique( keys.begin(), keys.end(), []( const Alias& a, const Alias& b ) { return !a.less( b ) && !b.less( a ); } ), keys.end() );
+
+	struct partition_work {
+		uint64_t                                   id_;
+		std::vector<uint64_t>                      offsets_;
+		std::vector<std::pair<uint64_t, uint64_t>> hashes_;
+		std::vector<unsigned char>                 payloads_;
+	};
+	std::vector<partition_work> partitions;
+
+	std::vector<unsigned char> buff;
+	for ( const auto& key : keys ) {
+		if ( !key.has_value() ) {
+			throw std::invalid_argument( "empty constrained_any is not acceptable as the key of any_key_archive" );
+		}
+		buff.resize( key.serialized_size() );
+		key.serialize( buff.data(), buff.size() );
+
+		uint64_t id           = 0;
+		uint64_t payload_size = 0;
+		size_t   pos          = impl::decode_varint( buff.data(), buff.size(), id );
+		pos += impl::decode_varint( buff.data() + pos, buff.size() - pos, payload_size );
+
+		if ( partitions.empty() || ( partitions.back().id_ != id ) ) {
+			partitions.push_back( partition_work { id, { 0 }, {}, {} } );
+		}
+		partition_work& ref_p = partitions.back();
+		ref_p.hashes_.emplace_back( static_cast<uint64_t>( key.hash_value() ), static_cast<uint64_t>( ref_p.offsets_.size() - 1 ) );
+		ref_p.payloads_.insert( ref_p.payloads_.end(), buff.begin() + static_cast<ptrdiff_t>( pos ), buff.end() );
+		ref_p.offsets_.push_back( ref_p.payloads_.size() );
+	}
+
+	std::vector<unsigned char> header( impl::any_key_archive_header_size + partitions.size() * impl::any_key_archive_partition_size );
+	std::memcpy( header.data(), impl::any_key_archive_magic, sizeof( impl::any_key_archive_magic ) );
+	uint64_t version_and_num = impl::any_key_archive_version | ( static_cast<uint64_t>( partitions.size() ) << 32 );
+	impl::any_key_archive_store_u64( header.data() + 8, version_and_num );
+	impl::any_key_archive_store_u64( header.data() + 16, keys.size() );
+
+	std::vector<unsigned char> body;
+	auto append_u64 = [&body]( uint64_t v ) {
+		size_t pos = body.size();
+		body.resize( pos + 8 );
+		impl::any_key_archive_store_u64( body.data() + pos, v );
+	};
+	for ( size_t i = 0; i < partitions.size(); i++ ) {
+		partition_work& ref_p = partitions[i];
+		std::sort( ref_p.hashes_.begin(), ref_p.hashes_.end() );
+
+		unsigned char* p_entry = header.data() + impl::any_key_archive_header_size + i * impl::any_key_archive_partition_size;
+		impl::any_key_archive_store_u64( p_entry, ref_p.id_ );
+		impl::any_key_archive_store_u64( p_entry + 8, ref_p.hashes_.size() );
+
+		impl::any_key_archive_store_u64( p_entry + 16, header.size() + body.size() );
+		for ( uint64_t off : ref_p.offsets_ ) {
+			append_u64( off );
+		}
+		impl::any_key_archive_store_u64( p_entry + 24, header.size() + body.size() );
+		for ( const auto& h : ref_p.hashes_ ) {
+			append_u64( h.first );
+			append_u64( h.second );
+		}
+		impl::any_key_archive_store_u64( p_entry + 32, header.size() + body.size() );
+		body.insert( body.end(), ref_p.payloads_.begin(), ref_p.payloads_.end() );
+		body.resize( ( body.size() + 7 ) & ~static_cast<size_t>( 7 ) );
+	}
+
+	const std::vector<unsigned char> blocks[] = { std::move( header ), std::move( body ) };
+	impl::any_key_archive_write_file( path, blocks, 2 );
+}
+
+/**
+ * @brief read only archive of the keys that is mapped by mmap()
+ *
+ * Open of the archive reads only the header and the partition table. The keys are not constructed.
+ *
+ * @tparam Alias same type to write_any_key_archive(). The types of the keys should be registered to serialize_registry<Alias> before open.
+ */
+template <typename Alias>
+class any_key_archive {
+	static_assert( is_specialized_of_constrained_any<Alias>::value, "Alias should be specialized type of constrained_any" );
+
+public:
+	/**
+	 * @brief open the archive
+	 *
+	 * @exception std::system_error if the file could not be opened or mapped
+	 * @exception std::invalid_argument if the file is not any_key_archive or has unregistered type id
+	 */
+	explicit any_key_archive( const std::string& path )
+	{
+		int fd = ::open( path.c_str(), O_RDONLY );
+		if ( fd < 0 ) {
+			throw std::system_error( errno, std::generic_category(), "fail to open any_key_archive: " + path );
+		}
+		struct stat st;
+		if ( ::fstat( fd, &st ) != 0 ) {
+			int e = errno;
+			::close( fd );
+			throw std::system_error( e, std::generic_category(), "fail to stat any_key_archive: " + path );
+		}
+		file_size_ = static_cast<size_t>( st.st_size );
+		if ( file_size_ > 0 ) {
+			void* p = ::mmap( nullptr, file_size_, PROT_READ, MAP_PRIVATE, fd, 0 );
+			if ( p == MAP_FAILED ) {
+				int e = errno;
+				::close( fd );
+				throw std::system_error( e, std::generic_category(), "fail to mmap any_key_archive: " + path );
+			}
+			p_top_ = static_cast<const unsigned char*>( p );
+		}
+		::close( fd );
+
+		try {
+			load_partition_table();
+		} catch ( ... ) {
+			unmap();
+			throw;
+		}
+	}
+	~any_key_archive()
+	{
+		unmap();
+	}
+	any_key_archive( const any_key_archive& )            = delete;
+	any_key_archive& operator=( const any_key_archive& ) = delete;
+	any_key_archive( any_key_archive&& src ) noexcept
+	  : p_top_( src.p_top_ )
+	  , file_size_( src.file_size_ )
+	  , num_of_keys_( src.num_of_keys_ )
+	  , partitions_( std::move( src.partitions_ ) )
+	{
+		src.p_top_     = nullptr;
+		src.file_size_ = 0;
+	}
+	any_key_archive& operator=( any_key_archive&& ) = delete;
+
+	size_t size( void ) const noexcept
+	{
+		return num_of_keys_;
+	}
+
+	size_t num_of_partitions( void ) const noexcept
+	{
+		return partitions_.size();
+	}
+
+	/**
+	 * @brief check the key is in the archive by the precomputed hash values
+	 */
+	template <typename T>
+	bool contains( const T& key ) const
+	{
+		const partition* p_part = find_partition<T>();
+		if ( p_part == nullptr ) {
+			return false;
+		}
+		using cmp_t                        = impl::any_key_archive_compare_type<T>;
+		const typename cmp_t::type cmp_key = key;
+
+		uint64_t h  = static_cast<uint64_t>( std::hash<T>()( key ) );
+		size_t   lo = 0;
+		size_t   hi = p_part->count_;
+		while ( lo < hi ) {
+			size_t mid = lo + ( hi - lo ) / 2;
+			if ( hash_entry( *p_part, mid ) < h ) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		for ( ; ( lo < p_part->count_ ) && ( hash_entry( *p_part, lo ) == h ); lo++ ) {
+			size_t idx = static_cast<size_t>( impl::any_key_archive_load_u64( p_top_ + p_part->hash_pos_ + lo * 16 + 8 ) );
+			if ( payload_as<T>( *p_part, idx ) == cmp_key ) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief position of the first key that is not less than key
+	 *
+	 * @return position in the order of Alias::less(). If all keys are less than key, return size().
+	 */
+	template <typename T>
+	size_t lower_bound( const T& key ) const
+	{
+		using cmp_t                        = impl::any_key_archive_compare_type<T>;
+		const typename cmp_t::type cmp_key = key;
+
+		std::type_index ti( typeid( T ) );
+		for ( const auto& part : partitions_ ) {
+			std::type_index ti_part( *part.p_type_ );
+			if ( ti < ti_part ) {
+				return part.begin_;
+			}
+			if ( ti == ti_part ) {
+				size_t lo = 0;
+				size_t hi = part.count_;
+				while ( lo < hi ) {
+					size_t mid = lo + ( hi - lo ) / 2;
+					if ( payload_as<T>( part, mid ) < cmp_key ) {
+						lo = mid + 1;
+					} else {
+						hi = mid;
+					}
+				}
+				return part.begin_ + lo;
+			}
+		}
+		return num_of_keys_;
+	}
+
+	/**
+	 * @brief type of the key
+	 *
+	 * @pre pos < size()
+	 */
+	const std::type_info& type( size_t pos ) const noexcept
+	{
+		return *partition_of( pos ).p_type_;
+	}
+
+	/**
+	 * @brief construct the key into out
+	 *
+	 * @param is_view if true, string like type is decoded as its view type that refers the mapped file
+	 *
+	 * @pre pos < size()
+	 */
+	void load( size_t pos, Alias& out, bool is_view = false ) const
+	{
+		const partition& ref_p = partition_of( pos );
+		size_t           idx   = pos - ref_p.begin_;
+		size_t           b     = payload_offset( ref_p, idx );
+		size_t           e     = payload_offset( ref_p, idx + 1 );
+		serialize_registry<Alias>::get_instance().decode_payload( ref_p.id_, p_top_ + ref_p.payload_pos_ + b, e - b, out, is_view );
+	}
+
+private:
+	struct partition {
+		uint64_t              id_;
+		const std::type_info* p_type_;
+		size_t                begin_;   // position of the first key of this partition
+		size_t                count_;
+		size_t                offsets_pos_;
+		size_t                hash_pos_;
+		size_t                payload_pos_;
+	};
+
+	void unmap( void ) noexcept
+	{
+		if ( p_top_ != nullptr ) {
+			::munmap( const_cast<unsigned char*>( p_top_ ), file_size_ );
+			p_top_ = nullptr;
+		}
+	}
+
+	void load_partition_table( void )
+	{
+		if ( ( file_size_ < impl::any_key_archive_header_size ) || ( std::memcmp( p_top_, impl::any_key_archive_magic, sizeof( impl::any_key_archive_magic ) ) != 0 ) ) {
+			throw std::invalid_argument( "file is not any_key_archive" );
+		}
+		uint64_t version_and_num = impl::any_key_archive_load_u64( p_top_ + 8 );
+		if ( static_cast<uint32_t>( version_and_num ) != impl::any_key_archive_version ) {
+			throw std::invalid_argument( "unsupported version of any_key_archive" );
+		}
+		size_t num_of_partitions = static_cast<size_t>( version_and_num >> 32 );
+		num_of_keys_             = static_cast<size_t>( impl::any_key_archive_load_u64( p_top_ + 16 ) );
+		if ( num_of_partitions > ( file_size_ - impl::any_key_archive_header_size ) / impl::any_key_archive_partition_size ) {
+			throw std::invalid_argument( "partition table of any_key_archive is truncated" );
+		}
+
+		const serialize_registry<Alias>& ref_registry = serialize_registry<Alias>::get_instance();
+		size_t                           total        = 0;
+		for ( size_t i = 0; i < num_of_partitions; i++ ) {
+			const unsigned char* p_entry = p_top_ + impl::any_key_archive_header_size + i * impl::any_key_archive_partition_size;
+
+			partition part;
+			part.id_          = impl::any_key_archive_load_u64( p_entry );
+			part.p_type_      = ref_registry.find_type( part.id_ );
+			part.begin_       = 0;
+			part.count_       = static_cast<size_t>( impl::any_key_archive_load_u64( p_entry + 8 ) );
+			part.offsets_pos_ = static_cast<size_t>( impl::any_key_archive_load_u64( p_entry + 16 ) );
+			part.hash_pos_    = static_cast<size_t>( impl::any_key_archive_load_u64( p_entry + 24 ) );
+			part.payload_pos_ = static_cast<size_t>( impl::any_key_archive_load_u64( p_entry + 32 ) );
+			if ( part.p_type_ == nullptr ) {
+				throw std::invalid_argument( "any_key_archive has unregistered type id" );
+			}
+			if ( ( part.count_ > file_size_ / 16 ) ||
+			     ( part.offsets_pos_ + ( part.count_ + 1 ) * 8 > file_size_ ) ||
+			     ( part.hash_pos_ + part.count_ * 16 > file_size_ ) ||
+			     ( part.payload_pos_ + payload_offset( part, part.count_ ) > file_size_ ) ) {
+				throw std::invalid_argument( "partition of any_key_archive is truncated" );
+			}
+			total += part.count_;
+			partitions_.push_back( part );
+		}
+		if ( total != num_of_keys_ ) {
+			throw std::invalid_argument( "number of keys of any_key_archive is wrong" );
+		}
+
+		std::sort( partitions_.begin(), partitions_.end(), []( const partition& a, const partition& b ) {
+			return std::type_index( *a.p_type_ ) < std::type_index( *b.p_type_ );
+		} );
+		size_t begin = 0;
+		for ( auto& part : partitions_ ) {
+			part.begin_ = begin;
+			begin += part.count_;
+		}
+	}
+
+	template <typename T>
+	const partition* find_partition( void ) const noexcept
+	{
+		uint64_t id = impl::serialize_type_id_slot<Alias, T>::id_;
+		for ( const auto& part : partitions_ ) {
+			if ( part.id_ == id ) {
+				return &part;
+			}
+		}
+		return nullptr;
+	}
+
+	const partition& partition_of( size_t pos ) const noexcept
+	{
+		auto it = std::upper_bound( partitions_.begin(), partitions_.end(), pos, []( size_t v, const partition& p ) { return v < p.begin_; } );
+		return *( it - 1 );
+	}
+
+	size_t payload_offset( const partition& ref_p, size_t idx ) const noexcept
+	{
+		return static_cast<size_t>( impl::any_key_archive_load_u64( p_top_ + ref_p.offsets_pos_ + idx * 8 ) );
+	}
+
+	uint64_t hash_entry( const partition& ref_p, size_t i ) const noexcept
+	{
+		return impl::any_key_archive_load_u64( p_top_ + ref_p.hash_pos_ + i * 16 );
+	}
+
+	template <typename T>
+	typename impl::any_key_archive_compare_type<T>::type payload_as( const partition& ref_p, size_t idx ) const
+	{
+		size_t b = payload_offset( ref_p, idx );
+		size_t e = payload_offset( ref_p, idx + 1 );
+		return impl::any_key_archive_compare_type<T>::decode( p_top_ + ref_p.payload_pos_ + b, e - b );
+	}
+
+	const unsigned char*   p_top_       = nullptr;
+	size_t                 file_size_   = 0;
+	size_t                 num_of_keys_ = 0;
+	std::vector<partition> partitions_;   // sorted by std::type_index of the reader process
+};
+
+}   // namespace yan
+
+#endif
@@ -0,0 +1,302 @@
+/**
+ * @file any_key_batch.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief batch hash and equality of the arrays of constrained_any
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * hash_value() and equal_to() of each element find the shared special operation and call it by the virtual function.
+ * hash_batch() and equal_batch() process the elements by the chunk. The chunk is split into the runs of same type of the value carrier
+ * that is read from its vtable without virtual function call. Then, the run of the listed value type runs the typed loop
+ * that reads the value from the value carrier directly. The value of the arithmetic type is loaded to the plain array at first,
+ * and the loop of std::hash over it is able to be vectorized by the compiler.
+ * The short runs of finely interleaved types are processed by hash_value() and equal_to() of each element,
+ * because the lookup of the typed loop costs more than it saves for them.
+ *
+ * The results are same to hash_value() and equal_to() of each element.
+ */
+
+#ifndef INC_ANY_KEY_BATCH_HPP_
+#define INC_ANY_KEY_BATCH_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
+#include "constrained_any.hpp"
+
+namespace yan {
+
+namespace impl {
+
+/**
+ * @brief list of value types of Alias that are processed by the typed loop
+ */
+template <typename Alias, typename... Ts>
+struct any_key_batch_type_list { };
+
+/**
+ * @brief value types that hash_batch() and equal_batch() process by the typed loop if no type is specified
+ */
+template <typename Alias>
+using any_key_batch_default_type_list = any_key_batch_type_list<Alias, int, long, long long, unsigned int, unsigned long, unsigned long long, float, double, std::string>;
+
+/**
+ * @brief value carrier type of T in Alias
+ */
+template <typename Alias, typename T>
+struct any_key_batch_carrier;
+
+template <template <class> class... ConstrainAndOperationArgs, typename T>
+struct any_key_batch_carrier<constrained_any<ConstrainAndOperationArgs...>, T> {
+	using type = value_carrier<T,
+	                           do_any_constraints_require_copy_constructible<ConstrainAndOperationArgs...>::value,
+	                           do_any_constraints_require_move_constructible<ConstrainAndOperationArgs...>::value,
+	                           ConstrainAndOperationArgs...>;
+};
+
+/**
+ * @brief number of the elements of the chunk
+ */
+constexpr size_t any_key_batch_chunk_size = 256;
+
+/**
+ * @brief maximum number of the value types in one call. The elements of the other value types are processed one by one.
+ */
+constexpr size_t any_key_batch_max_groups = 16;
+
+/**
+ * @brief number of the bits of the slot index that finds the handler of the value carrier type
+ */
+constexpr size_t any_key_batch_slot_bits = 6;
+
+/**
+ * @brief minimum length of the run of same type that is processed by the typed loop
+ *
+ * The shorter runs are processed one by one together, because the lookup of the typed loop costs more than it saves for them.
+ */
+constexpr size_t any_key_batch_min_run_length = 8;
+
+/**
+ * @brief number of the consecutive short runs that the rest of the chunk is processed one by one without the split
+ */
+constexpr size_t any_key_batch_max_short_runs = 4;
+
+/**
+ * @brief typed loop of the run of the elements that have same value carrier type
+ *
+ * p_carriers[j] is the value carrier of the element j of the run, for j in [0, m).
+ */
+template <typename Alias>
+struct any_key_batch_handler {
+	const std::type_info* p_carrier_type_;
+	void ( *p_hash_ )( const value_carrier_if_common* const* p_carriers, const Alias* p_keys, size_t m, size_t* p_out );
+	void ( *p_equal_ )( const std::type_info* p_carrier_type, const value_carrier_if_common* const* p_carriers, const Alias* p_a, const Alias* p_b, size_t m, bool* p_out );
+};
+
+template <typename Alias>
+void any_key_batch_hash_each( const value_carrier_if_common* const*, const Alias* p_keys, size_t m, size_t* p_out )
+{
+	for ( size_t j = 0; j < m; j++ ) {
+		p_out[j] = p_keys[j].hash_value();
+	}
+}
+
+template <typename Alias>
+void any_key_batch_equal_each( const std::type_info*, const value_carrier_if_common* const*, const Alias* p_a, const Alias* p_b, size_t m, bool* p_out )
+{
+	for ( size_t j = 0; j < m; j++ ) {
+		p_out[j] = p_a[j].equal_to( p_b[j] );
+	}
+}
+
+template <typename Alias, typename T>
+void any_key_batch_hash_typed( const value_carrier_if_common* const* p_carriers, const Alias*, size_t m, size_t* p_out )
+{
+	using carrier_t = typename any_key_batch_carrier<Alias, T>::type;
+
+	if constexpr ( std::is_arithmetic<T>::value ) {
+		T values[any_key_batch_chunk_size];
+		for ( size_t j = 0; j < m; j++ ) {
+			values[j] = static_cast<const carrier_t*>( p_carriers[j] )->ref();
+		}
+		for ( size_t j = 0; j < m; j++ ) {
+			p_out[j] = std::hash<T>()( values[j] );
+		}
+	} else {
+		for ( size_t j = 0; j < m; j++ ) {
+			p_out[j] = std::hash<T>()( static_cast<const carrier_t*>( p_carriers[j] )->ref() );
+		}
+	}
+}
+
+template <typename Alias, typename T>
+void any_key_batch_equal_typed( const std::type_info* p_carrier_type, const value_carrier_if_common* const* p_carriers, const Alias* p_a, const Alias* p_b, size_t m, bool* p_out )
+{
+	using carrier_t = typename any_key_batch_carrier<Alias, T>::type;
+
+	for ( size_t j = 0; j < m; j++ ) {
+		const value_carrier_if_common& b = p_b[j].get_value_carrier();
+		if ( &typeid( b ) == p_carrier_type ) {
+			p_out[j] = static_cast<const carrier_t*>( p_carriers[j] )->ref() == static_cast<const carrier_t&>( b ).ref();
+		} else {
+			// different type, or same type that has the other type_info object.
+			p_out[j] = p_a[j].equal_to( p_b[j] );
+		}
+	}
+}
+
+template <typename Alias>
+any_key_batch_handler<Alias> any_key_batch_find_handler( const std::type_info* p_carrier_type, any_key_batch_type_list<Alias> )
+{
+	return any_key_batch_handler<Alias> { p_carrier_type, &any_key_batch_hash_each<Alias>, &any_key_batch_equal_each<Alias> };
+}
+
+template <typename Alias, typename T, typename... Ts>
+any_key_batch_handler<Alias> any_key_batch_find_handler( const std::type_info* p_carrier_type, any_key_batch_type_list<Alias, T, Ts...> )
+{
+	if constexpr ( std::is_constructible<Alias, T>::value ) {
+		if ( *p_carrier_type == typeid( typename any_key_batch_carrier<Alias, T>::type ) ) {
+			return any_key_batch_handler<Alias> { p_carrier_type, &any_key_batch_hash_typed<Alias, T>, &any_key_batch_equal_typed<Alias, T> };
+		}
+	}
+	return any_key_batch_find_handler( p_carrier_type, any_key_batch_type_list<Alias, Ts...> {} );
+}
+
+/**
+ * @brief split each chunk of p_keys into the runs of same value carrier type, and call f( handler, p_carriers, begin, m ) for each run
+ *
+ * The run of any_key_batch_min_run_length elements or more is given with the handler of its type.
+ * The consecutive shorter runs are given together with the handler that processes the elements one by one.
+ */
+template <typename Alias, typename TypeList, typename F>
+void any_key_batch_for_each_run( const Alias* p_keys, size_t n, TypeList type_list, F&& f )
+{
+	// the last handler processes the elements one by one. It is for the short runs and the types over any_key_batch_max_groups.
+	// its type is typeid( void ). Therefore, it never matches to the type of the value carrier.
+	any_key_batch_handler<Alias> handlers[any_key_batch_max_groups + 1];
+	size_t                       num_of_handlers = 0;
+	size_t                       last_hit        = any_key_batch_max_groups;
+	handlers[any_key_batch_max_groups]           = any_key_batch_find_handler( &typeid( void ), any_key_batch_type_list<Alias> {} );
+
+	// handler of the value carrier type by the hash of the address of its type_info
+	const std::type_info* slot_types[size_t { 1 } << any_key_batch_slot_bits] = {};
+	uint8_t               slot_handlers[size_t { 1 } << any_key_batch_slot_bits];
+
+	for ( size_t base = 0; base < n; base += any_key_batch_chunk_size ) {
+		size_t                         m = std::min( n - base, any_key_batch_chunk_size );
+		const value_carrier_if_common* carriers[any_key_batch_chunk_size];
+
+		size_t short_begin       = 0;   // begin of the consecutive short runs
+		size_t num_of_short_runs = 0;
+		size_t i                 = 0;
+		while ( i < m ) {
+			// typeid of the polymorphic object is read from its vtable without virtual function call.
+			carriers[i]                  = &( p_keys[base + i].get_value_carrier() );
+			const std::type_info* p_type = &typeid( *carriers[i] );
+			size_t                j      = i + 1;
+			for ( ; j < m; j++ ) {
+				carriers[j] = &( p_keys[base + j].get_value_carrier() );
+				if ( &typeid( *carriers[j] ) != p_type ) {
+					break;
+				}
+			}
+			if ( j - i < any_key_batch_min_run_length ) {
+				i = j;
+				num_of_short_runs++;
+				if ( num_of_short_runs == any_key_batch_max_short_runs ) {
+					// finely interleaved types. the split costs more than it saves for the rest of the chunk.
+					i = m;
+					break;
+				}
+				continue;
+			}
+
+			if ( handlers[last_hit].p_carrier_type_ != p_type ) {
+				size_t slot = type_info_slot_of<any_key_batch_slot_bits>( p_type );
+				if ( slot_types[slot] == p_type ) {
+					last_hit = slot_handlers[slot];
+				} else {
+					last_hit = 0;
+					while ( ( last_hit < num_of_handlers ) && ( handlers[last_hit].p_carrier_type_ != p_type ) ) {
+						last_hit++;
+					}
+					if ( last_hit == num_of_handlers ) {
+						if ( num_of_handlers < any_key_batch_max_groups ) {
+							handlers[num_of_handlers] = any_key_batch_find_handler( p_type, type_list );
+							num_of_handlers++;
+						} else {
+							last_hit = any_key_batch_max_groups;
+						}
+					}
+					slot_types[slot]    = p_type;
+					slot_handlers[slot] = static_cast<uint8_t>( last_hit );
+				}
+			}
+			if ( short_begin < i ) {
+				f( handlers[any_key_batch_max_groups], carriers + short_begin, base + short_begin, i - short_begin );
+			}
+			f( handlers[last_hit], carriers + i, base + i, j - i );
+			i                 = j;
+			short_begin       = j;
+			num_of_short_runs = 0;
+		}
+		if ( short_begin < m ) {
+			f( handlers[any_key_batch_max_groups], carriers + short_begin, base + short_begin, m - short_begin );
+		}
+	}
+}
+
+template <typename Alias, typename... Ts>
+using any_key_batch_type_list_t = typename std::conditional<sizeof...( Ts ) == 0,
+                                                            any_key_batch_default_type_list<Alias>,
+                                                            any_key_batch_type_list<Alias, Ts...>>::type;
+
+}   // namespace impl
+
+/**
+ * @brief p_out[i] = p_keys[i].hash_value() for i in [0, n)
+ *
+ * @tparam Ts value types that are hashed by the typed loop. If empty, the arithmetic types and std::string are used.
+ *
+ * @note
+ * The result is same to hash_value(), therefore it is usable with std::hash of Alias, e.g. for the bulk insertion to std::unordered_map.
+ */
+template <typename... Ts, typename Alias,
+          typename std::enable_if<is_specialized_of_constrained_any<Alias>::value && impl::is_alias_with_hash_value<Alias>::value>::type* = nullptr>
+void hash_batch( const Alias* p_keys, size_t* p_out, size_t n )
+{
+	impl::any_key_batch_for_each_run( p_keys, n, impl::any_key_batch_type_list_t<Alias, Ts...> {},
+	                                  [p_keys, p_out]( const impl::any_key_batch_handler<Alias>& h, const impl::value_carrier_if_common* const* p_carriers, size_t begin, size_t m ) {
+		                                  h.p_hash_( p_carriers, p_keys + begin, m, p_out + begin );
+	                                  } );
+}
+
+/**
+ * @brief p_out[i] = p_a[i].equal_to( p_b[i] ) for i in [0, n)
+ *
+ * @tparam Ts value types that are compared by the typed loop. If empty, the arithmetic types and std::string are used.
+ *
+ * @note
+ * p_out is the array of bool. std::vector<bool> is not usable because it has no data().
+ */
+template <typename... Ts, typename Alias,
+          typename std::enable_if<is_specialized_of_constrained_any<Alias>::value && impl::is_alias_with_equal_to<Alias>::value>::type* = nullptr>
+void equal_batch( const Alias* p_a, const Alias* p_b, bool* p_out, size_t n )
+{
+	impl::any_key_batch_for_each_run( p_a, n, impl::any_key_batch_type_list_t<Alias, Ts...> {},
+	                                  [p_a, p_b, p_out]( const impl::any_key_batch_handler<Alias>& h, const impl::value_carrier_if_common* const* p_carriers, size_t begin, size_t m ) {
+		                                  h.p_equal_( h.p_carrier_type_, p_carriers, p_a + begin, p_b + begin, m, p_out + begin );
+	                                  } );
+}
+
+}   // namespace yan
+
+#endif
@@ -0,0 +1,290 @@
+/**
+ * @file any_queue.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief bounded lock-free MPMC queue of constrained_any
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#ifndef INC_ANY_QUEUE_HPP_
+#define INC_ANY_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "constrained_any.hpp"
+
+namespace yan {
+
+namespace impl {
+
+// std::hardware_destructive_interference_size is not stable among compilers and compile options. Therefore, fixed size is used.
+static constexpr size_t any_queue_cache_line_size = 64;
+
+}   // namespace impl
+
+/**
+ * @brief bounded lock-free multi-producer/multi-consumer queue of constrained_any
+ *
+ * Each slot of the ring buffer embeds the storage of Alias itself.
+ * Therefore, producer constructs a value directly in a slot, and a value that fits in the inline buffer of Alias does not need any extra allocation.
+ *
+ * @tparam Alias specialized type of constrained_any like yan::move_only_any. Alias should be move constructible.
+ *
+ * @note
+ * The algorithm is the bounded MPMC queue by sequence number of each slot.
+ * push/pop are lock-free in the meaning of no mutex, but a producer/consumer that claims a slot should complete its operation before other threads reuse that slot.
+ */
+template <typename Alias>
+class any_queue {
+	static_assert( is_specialized_of_constrained_any<Alias>::value, "Alias should be specialized type of constrained_any" );
+	static_assert( std::is_move_constructible<Alias>::value, "Alias should be move constructible" );
+
+public:
+	using value_type = Alias;
+
+	/**
+	 * @brief constructor
+	 *
+	 * @param capacity required capacity. Actual capacity is rounded up to power of 2.
+	 *
+	 * @exception std::invalid_argument if capacity is 0
+	 * @exception std::length_error if capacity is larger than the maximum power of 2 of size_t
+	 */
+	explicit any_queue( size_t capacity )
+	  : mask_( round_up_to_power_of_2( capacity ) - 1 )
+	  , up_slots_( std::make_unique<slot[]>( mask_ + 1 ) )
+	  , enqueue_pos_( 0 )
+	  , dequeue_pos_( 0 )
+	{
+		for ( size_t i = 0; i <= mask_; i++ ) {
+			up_slots_[i].seq_.store( i, std::memory_order_relaxed );
+		}
+	}
+
+	~any_queue()
+	{
+		while ( try_consume( []( Alias& ) {} ) ) { }
+	}
+
+	any_queue( const any_queue& )            = delete;
+	any_queue( any_queue&& )                 = delete;
+	any_queue& operator=( const any_queue& ) = delete;
+	any_queue& operator=( any_queue&& )      = delete;
+
+	/**
+	 * @brief construct a value of type T with args in a free slot directly
+	 *
+	 * @tparam T type of the value which you want to store
+	 * @tparam Args constructor argument types for the value type
+	 * @param args constructor arguments for the value type
+	 * @retval true success to push
+	 * @retval false queue is full
+	 *
+	 * @exception if the constructor of T throws an exception, the exception is re-thrown after the claimed slot is released as an empty slot.
+	 */
+	template <class T, class... Args>
+	bool try_emplace( Args&&... args )
+	{
+		return try_push_impl( [&]( void* p_storage ) {
+			new ( p_storage ) Alias( std::in_place_type<T>, std::forward<Args>( args )... );
+		} );
+	}
+
+	/**
+	 * @brief push a value
+	 *
+	 * @param v value to push. If v is Alias, Alias is moved/copied to a slot. Otherwise, v is stored as the value of Alias.
+	 * @retval true success to push
+	 * @retval false queue is full
+	 */
+	template <class T>
+	bool try_push( T&& v )
+	{
+		return try_push_impl( [&]( void* p_storage ) {
+			new ( p_storage ) Alias( std::forward<T>( v ) );
+		} );
+	}
+
+	/**
+	 * @brief pop a value by moving it to out
+	 *
+	 * @param out destination of the popped value. The previous value of out is destructed.
+	 * @retval true success to pop
+	 * @retval false queue is empty
+	 *
+	 * @note
+	 * The popped value is handed over by swapping the value carriers of the slot and out.
+	 * Therefore, the value is neither moved nor allocated again, and the value type whose move constructor may throw does not make this function throw.
+	 */
+	bool try_pop( Alias& out )
+	{
+		return try_consume( [&out]( Alias& v ) {
+			out.swap( v );
+		} );
+	}
+
+	/**
+	 * @brief pop a value and pass it to f in the slot directly
+	 *
+	 * @tparam F callable type that accepts Alias&
+	 * @param f callable that is called with the reference to the value in the slot. After f returns, the value is destructed.
+	 * @retval true success to pop
+	 * @retval false queue is empty
+	 *
+	 * @exception if f throws an exception, the exception is re-thrown after the value is destructed and the slot is released. The popped value is lost.
+	 */
+	template <class F>
+	bool try_consume( F&& f )
+	{
+		while ( true ) {
+			size_t pos    = 0;
+			slot*  p_slot = claim_slot_for_pop( &pos );
+			if ( p_slot == nullptr ) return false;
+
+			if ( p_slot->has_value_ ) {
+				slot_releaser_after_pop releaser { p_slot, pos + mask_ + 1 };
+				f( *( p_slot->value_ptr() ) );
+				return true;
+			}
+
+			// producer failed to construct the value. skip this slot.
+			p_slot->seq_.store( pos + mask_ + 1, std::memory_order_release );
+		}
+	}
+
+	/**
+	 * @brief capacity of this queue
+	 */
+	size_t capacity( void ) const noexcept
+	{
+		return mask_ + 1;
+	}
+
+	/**
+	 * @brief approximate number of values in this queue
+	 *
+	 * @note
+	 * Returned value may be stale under concurrent push/pop.
+	 */
+	size_t size_approx( void ) const noexcept
+	{
+		size_t deq = dequeue_pos_.load( std::memory_order_acquire );
+		size_t enq = enqueue_pos_.load( std::memory_order_acquire );
+		return ( enq > deq ) ? ( enq - deq ) : 0;
+	}
+
+private:
+	struct alignas( impl::any_queue_cache_line_size ) slot {
+		std::atomic<size_t> seq_;
+		bool                has_value_;
+		alignas( Alias ) unsigned char storage_[sizeof( Alias )];
+
+		Alias* value_ptr( void ) noexcept
+		{
+			return std::launder( reinterpret_cast<Alias*>( storage_ ) );
+		}
+	};
+
+	/**
+	 * @brief destruct the popped value and release the slot for the producers, even if the consumer throws an exception
+	 */
+	struct slot_releaser_after_pop {
+		slot*  p_slot_;
+		size_t next_seq_;
+
+		~slot_releaser_after_pop()
+		{
+			p_slot_->value_ptr()->~Alias();
+			p_slot_->has_value_ = false;
+			p_slot_->seq_.store( next_seq_, std::memory_order_release );
+		}
+	};
+
+	static size_t round_up_to_power_of_2( size_t capacity )
+	{
+		if ( capacity == 0 ) {
+			throw std::invalid_argument( "capacity of any_queue should be larger than 0" );
+		}
+		if ( capacity > ( std::numeric_limits<size_t>::max() >> 1 ) + 1 ) {
+			throw std::length_error( "capacity of any_queue is too large" );
+		}
+		size_t ans = 1;
+		while ( ans < capacity ) {
+			ans <<= 1;
+		}
+		return ans;
+	}
+
+	template <class ConstructFunc>
+	bool try_push_impl( ConstructFunc&& construct_func )
+	{
+		slot*  p_slot = nullptr;
+		size_t pos    = enqueue_pos_.load( std::memory_order_relaxed );
+		while ( true ) {
+			p_slot        = &( up_slots_[pos & mask_] );
+			size_t   seq  = p_slot->seq_.load( std::memory_order_acquire );
+			intptr_t diff = static_cast<intptr_t>( seq ) - static_cast<intptr_t>( pos );
+			if ( diff == 0 ) {
+				if ( enqueue_pos_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+					break;
+				}
+			} else if ( diff < 0 ) {
+				return false;   // full
+			} else {
+				pos = enqueue_pos_.load( std::memory_order_relaxed );
+			}
+		}
+
+		try {
+			construct_func( static_cast<void*>( p_slot->storage_ ) );
+			p_slot->has_value_ = true;
+		} catch ( ... ) {
+			p_slot->has_value_ = false;
+			p_slot->seq_.store( pos + 1, std::memory_order_release );
+			throw;
+		}
+		p_slot->seq_.store( pos + 1, std::memory_order_release );
+		return true;
+	}
+
+	slot* claim_slot_for_pop( size_t* p_pos )
+	{
+		size_t pos = dequeue_pos_.load( std::memory_order_relaxed );
+		while ( true ) {
+			slot*    p_slot = &( up_slots_[pos & mask_] );
+			size_t   seq    = p_slot->seq_.load( std::memory_order_acquire );
+			intptr_t diff   = static_cast<intptr_t>( seq ) - static_cast<intptr_t>( pos + 1 );
+			if ( diff == 0 ) {
+				if ( dequeue_pos_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+					*p_pos = pos;
+					return p_slot;
+				}
+			} else if ( diff < 0 ) {
+				return nullptr;   // empty
+			} else {
+				pos = dequeue_pos_.load( std::memory_order_relaxed );
+			}
+		}
+	}
+
+	const size_t            mask_;
+	std::unique_ptr<slot[]> up_slots_;
+
+	alignas( impl::any_queue_cache_line_size ) std::atomic<size_t> enqueue_pos_;
+	alignas( impl::any_queue_cache_line_size ) std::atomic<size_t> dequeue_pos_;
+};
+
+}   // namespace yan
+
+#endif
@@ -0,0 +1,473 @@
+/**
+ * @file any_sort.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief sort of the range of constrained_any by partitioning by type
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * std::sort of the range of constrained_any calls less() for each comparison, and it moves constrained_any itself.
+ * yan::any_sort() partitions the elements by type at first. The partitions are ordered by std::type_index same to less().
+ * Then, each partition sorts the indices of the elements by the typed comparison,
+ * i.e. LSD radix sort for the integral and floating point types, operator< for the other listed types and less() for the types not listed.
+ * The value of the radix sorted partition is restored from the key. Therefore, it does not access the elements randomly after sorting.
+ * The partitions are sorted and moved to the temporary buffer in parallel. At last, the elements are moved back to the range sequentially.
+ *
+ * The result order is the order by less(). The elements that are equivalent by less() keep their relative order, i.e. it is same to std::stable_sort.
+ */
+
+#ifndef INC_ANY_SORT_HPP_
+#define INC_ANY_SORT_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "constrained_any.hpp"
+
+namespace yan {
+
+namespace impl {
+
+/**
+ * @brief list of value types of Alias that are sorted by the typed comparison
+ */
+template <typename Alias, typename... Ts>
+struct any_sort_type_list { };
+
+template <typename T>
+using any_sort_radix_uint_t = typename std::conditional<sizeof( T ) == 1, uint8_t,
+                                                        typename std::conditional<sizeof( T ) == 2, uint16_t,
+                                                                                  typename std::conditional<sizeof( T ) == 4, uint32_t, uint64_t>::type>::type>::type;
+
+template <typename T>
+struct is_any_sort_radix_sortable {
+	static constexpr bool value = ( std::is_integral<T>::value && !std::is_same<T, bool>::value ) ||
+	                              ( std::is_floating_point<T>::value && std::numeric_limits<T>::is_iec559 && ( sizeof( T ) <= 8 ) );
+};
+
+/**
+ * @brief unsigned integer that has same order to operator< of T
+ */
+template <typename T>
+any_sort_radix_uint_t<T> any_sort_radix_key_of( const T& v ) noexcept
+{
+	using uint_t              = any_sort_radix_uint_t<T>;
+	constexpr uint_t sign_bit = static_cast<uint_t>( uint_t { 1 } << ( sizeof( T ) * 8 - 1 ) );
+	if constexpr ( std::is_integral<T>::value ) {
+		uint_t u = static_cast<uint_t>( v );
+		if constexpr ( std::is_signed<T>::value ) {
+			u ^= sign_bit;
+		}
+		return u;
+	} else {
+		// -0.0 == 0.0. therefore, -0.0 is treated as 0.0
+		T      nv = ( v == T( 0 ) ) ? T( 0 ) : v;
+		uint_t u;
+		std::memcpy( &u, &nv, sizeof( T ) );
+		return ( ( u & sign_bit ) != 0 ) ? static_cast<uint_t>( ~u ) : static_cast<uint_t>( u | sign_bit );
+	}
+}
+
+/**
+ * @brief inverse of any_sort_radix_key_of()
+ *
+ * @note -0.0 is returned as 0.0
+ */
+template <typename T>
+T any_sort_radix_value_of( any_sort_radix_uint_t<T> key ) noexcept
+{
+	using uint_t              = any_sort_radix_uint_t<T>;
+	constexpr uint_t sign_bit = static_cast<uint_t>( uint_t { 1 } << ( sizeof( T ) * 8 - 1 ) );
+	if constexpr ( std::is_integral<T>::value ) {
+		if constexpr ( std::is_signed<T>::value ) {
+			key ^= sign_bit;
+		}
+		return static_cast<T>( key );
+	} else {
+		uint_t u = ( ( key & sign_bit ) != 0 ) ? static_cast<uint_t>( key & static_cast<uint_t>( ~sign_bit ) ) : static_cast<uint_t>( ~key );
+		T      ans;
+		std::memcpy( &ans, &u, sizeof( T ) );
+		return ans;
+	}
+}
+
+/**
+ * @brief stable LSD radix sort of the pairs of the key and the index by 8 bits digit
+ *
+ * The pass that all keys have same digit is skipped.
+ */
+template <typename UInt>
+void any_sort_radix_sort( std::vector<std::pair<UInt, uint32_t>>& v )
+{
+	std::vector<std::pair<UInt, uint32_t>> tmp( v.size() );
+	for ( size_t shift = 0; shift < sizeof( UInt ) * 8; shift += 8 ) {
+		size_t counts[256] = {};
+		for ( const auto& e : v ) {
+			counts[static_cast<size_t>( e.first >> shift ) & 0xFFU]++;
+		}
+		if ( counts[static_cast<size_t>( v.front().first >> shift ) & 0xFFU] == v.size() ) {
+			continue;
+		}
+		size_t pos = 0;
+		for ( auto& c : counts ) {
+			size_t n = c;
+			c        = pos;
+			pos += n;
+		}
+		for ( const auto& e : v ) {
+			tmp[counts[static_cast<size_t>( e.first >> shift ) & 0xFFU]++] = e;
+		}
+		v.swap( tmp );
+	}
+}
+
+/**
+ * @brief hint to load the cache lines of the element that is accessed soon
+ */
+template <typename T>
+inline void any_sort_prefetch( const T* p ) noexcept
+{
+#if defined( __clang__ ) || defined( __GNUC__ )
+	const char* p_c = reinterpret_cast<const char*>( p );
+	for ( size_t offset = 0; offset < sizeof( T ); offset += 64 ) {
+		__builtin_prefetch( p_c + offset );
+	}
+#else
+	(void)p;
+#endif
+}
+
+/**
+ * @brief distance of the prefetch in the number of the elements
+ */
+constexpr size_t any_sort_prefetch_distance = 16;
+
+template <typename T>
+struct is_any_sort_prefix_sortable {
+	static constexpr bool value = std::is_same<T, std::string>::value || std::is_same<T, std::string_view>::value;
+};
+
+/**
+ * @brief unsigned integer of the first 8 bytes of the text in big endian
+ *
+ * The order of the prefix is same to the order of operator< of the text, if the prefixes are different.
+ */
+inline uint64_t any_sort_prefix_of( std::string_view v ) noexcept
+{
+	uint64_t ans = 0;
+	size_t   len = std::min<size_t>( v.size(), sizeof( uint64_t ) );
+	for ( size_t i = 0; i < sizeof( uint64_t ); i++ ) {
+		ans = ( ans << 8 ) | ( ( i < len ) ? static_cast<unsigned char>( v[i] ) : 0U );
+	}
+	return ans;
+}
+
+struct any_sort_partition {
+	const std::type_info* p_type_;
+	std::vector<uint32_t> indices_;   //!< indices of the elements of this type. ascending order before sorting
+};
+
+/**
+ * @brief move the elements in the order of the indices to p_dst
+ */
+template <typename RandomIt>
+void any_sort_move_partition( RandomIt first, const std::vector<uint32_t>& indices, typename std::iterator_traits<RandomIt>::value_type* p_dst )
+{
+	for ( size_t i = 0; i < indices.size(); i++ ) {
+		if ( i + any_sort_prefetch_distance < indices.size() ) {
+			any_sort_prefetch( &first[indices[i + any_sort_prefetch_distance]] );
+		}
+		p_dst[i] = std::move( first[indices[i]] );
+	}
+}
+
+/**
+ * @brief sort the elements of the partition by the typed comparison of T, and move them to p_dst
+ */
+template <typename T, typename RandomIt>
+void any_sort_typed_partition( RandomIt first, std::vector<uint32_t>& indices, typename std::iterator_traits<RandomIt>::value_type* p_dst )
+{
+	using alias_t = typename std::iterator_traits<RandomIt>::value_type;
+
+	if constexpr ( is_any_sort_radix_sortable<T>::value ) {
+		using uint_t = any_sort_radix_uint_t<T>;
+		std::vector<std::pair<uint_t, uint32_t>> keys( indices.size() );
+		for ( size_t i = 0; i < indices.size(); i++ ) {
+			const T* p = constrained_any_cast<T>( static_cast<const alias_t*>( &first[indices[i]] ) );
+			keys[i]    = std::pair<uint_t, uint32_t>( any_sort_radix_key_of<T>( *p ), indices[i] );
+		}
+		any_sort_radix_sort<uint_t>( keys );
+		// the value is restored from the key. therefore, the elements in the range are not accessed randomly.
+		for ( size_t i = 0; i < keys.size(); i++ ) {
+			T v = any_sort_radix_value_of<T>( keys[i].first );
+			if constexpr ( std::is_floating_point<T>::value ) {
+				if ( v == T( 0 ) ) {
+					v = *constrained_any_cast<T>( static_cast<const alias_t*>( &first[keys[i].second] ) );   // keep the sign of zero
+				}
+			}
+			p_dst[i] = v;
+		}
+	} else if constexpr ( is_any_sort_prefix_sortable<T>::value ) {
+		// the text is compared only if the prefixes are same. it reduces the random access to the elements.
+		struct prefix_ref {
+			uint64_t prefix_;
+			const T* p_;
+			uint32_t index_;
+		};
+		std::vector<prefix_ref> refs( indices.size() );
+		for ( size_t i = 0; i < indices.size(); i++ ) {
+			refs[i] = prefix_ref { 0, constrained_any_cast<T>( static_cast<const alias_t*>( &first[indices[i]] ) ), indices[i] };
+		}
+		// the common prefix of all texts, e.g. "key_", does not affect the order. therefore, the prefix starts after it.
+		std::string_view common( *( refs[0].p_ ) );
+		for ( size_t i = 1; ( i < refs.size() ) && !common.empty(); i++ ) {
+			std::string_view v( *( refs[i].p_ ) );
+			size_t           len = 0;
+			while ( ( len < common.size() ) && ( len < v.size() ) && ( common[len] == v[len] ) ) {
+				len++;
+			}
+			common = common.substr( 0, len );
+		}
+		for ( auto& r : refs ) {
+			r.prefix_ = any_sort_prefix_of( std::string_view( *( r.p_ ) ).substr( common.size() ) );
+		}
+		std::stable_sort( refs.begin(), refs.end(), []( const prefix_ref& a, const prefix_ref& b ) {
+			if ( a.prefix_ != b.prefix_ ) {
+				return a.prefix_ < b.prefix_;
+			}
+			return *( a.p_ ) < *( b.p_ );
+		} );
+		for ( size_t i = 0; i < indices.size(); i++ ) {
+			indices[i] = refs[i].index_;
+		}
+		any_sort_move_partition( first, indices, p_dst );
+	} else {
+		std::vector<std::pair<const T*, uint32_t>> refs( indices.size() );
+		for ( size_t i = 0; i < indices.size(); i++ ) {
+			refs[i] = std::pair<const T*, uint32_t>( constrained_any_cast<T>( static_cast<const alias_t*>( &first[indices[i]] ) ), indices[i] );
+		}
+		std::stable_sort( refs.begin(), refs.end(), []( const std::pair<const T*, uint32_t>& a, const std::pair<const T*, uint32_t>& b ) {
+			return *( a.first ) < *( b.first );
+		} );
+		for ( size_t i = 0; i < indices.size(); i++ ) {
+			indices[i] = refs[i].second;
+		}
+		any_sort_move_partition( first, indices, p_dst );
+	}
+}
+
+template <typename RandomIt>
+bool any_sort_try_typed_partition( RandomIt, any_sort_partition&, typename std::iterator_traits<RandomIt>::value_type*,
+                                   any_sort_type_list<typename std::iterator_traits<RandomIt>::value_type> )
+{
+	return false;
+}
+
+template <typename RandomIt, typename T, typename... Ts>
+bool any_sort_try_typed_partition( RandomIt first, any_sort_partition& partition, typename std::iterator_traits<RandomIt>::value_type* p_dst,
+                                   any_sort_type_list<typename std::iterator_traits<RandomIt>::value_type, T, Ts...> )
+{
+	using alias_t = typename std::iterator_traits<RandomIt>::value_type;
+
+	if constexpr ( std::is_constructible<alias_t, T>::value ) {
+		if ( *( partition.p_type_ ) == typeid( T ) ) {
+			any_sort_typed_partition<T>( first, partition.indices_, p_dst );
+			return true;
+		}
+	}
+	return any_sort_try_typed_partition( first, partition, p_dst, any_sort_type_list<alias_t, Ts...> {} );
+}
+
+/**
+ * @brief sort the elements of the partition, and move them to p_dst
+ */
+template <typename RandomIt, typename TypeList>
+void any_sort_sort_partition( RandomIt first, any_sort_partition& partition, typename std::iterator_traits<RandomIt>::value_type* p_dst, TypeList type_list )
+{
+	if ( ( partition.indices_.size() >= 2 ) && ( *( partition.p_type_ ) != typeid( void ) ) ) {
+		if ( any_sort_try_typed_partition( first, partition, p_dst, type_list ) ) {
+			return;
+		}
+		std::stable_sort( partition.indices_.begin(), partition.indices_.end(), [first]( uint32_t a, uint32_t b ) {
+			return first[a].less( first[b] );
+		} );
+	}
+	any_sort_move_partition( first, partition.indices_, p_dst );
+}
+
+/**
+ * @brief join all threads when it leaves the scope, including the exit by exception
+ */
+struct any_sort_thread_joiner {
+	std::vector<std::thread>& ref_threads_;
+
+	~any_sort_thread_joiner()
+	{
+		for ( auto& t : ref_threads_ ) {
+			if ( t.joinable() ) {
+				t.join();
+			}
+		}
+	}
+};
+
+/**
+ * @brief minimum number of the elements to use the threads
+ */
+constexpr size_t any_sort_parallel_threshold = 1U << 15;
+
+template <typename RandomIt, typename TypeList>
+void any_sort_impl( RandomIt first, RandomIt last, size_t num_of_threads, TypeList type_list )
+{
+	using alias_t = typename std::iterator_traits<RandomIt>::value_type;
+	using diff_t  = typename std::iterator_traits<RandomIt>::difference_type;
+	static_assert( is_specialized_of_constrained_any<alias_t>::value, "value type of the range should be specialized type of constrained_any" );
+
+	size_t n = static_cast<size_t>( last - first );
+	if ( n < 2 ) {
+		return;
+	}
+	if ( n > std::numeric_limits<uint32_t>::max() ) {
+		std::stable_sort( first, last, []( const alias_t& a, const alias_t& b ) { return a.less( b ); } );
+		return;
+	}
+
+	// partition by type. the number of types is expected to be small, and the same type tends to be consecutive.
+	std::vector<any_sort_partition> partitions;
+	size_t                          last_hit = 0;
+	for ( size_t i = 0; i < n; i++ ) {
+		const std::type_info* p_type = &( first[static_cast<diff_t>( i )].type() );
+		if ( ( last_hit >= partitions.size() ) || ( partitions[last_hit].p_type_ != p_type ) ) {
+			last_hit = 0;
+			while ( ( last_hit < partitions.size() ) && ( *( partitions[last_hit].p_type_ ) != *p_type ) ) {
+				last_hit++;
+			}
+			if ( last_hit == partitions.size() ) {
+				partitions.push_back( any_sort_partition { p_type, {} } );
+			}
+		}
+		partitions[last_hit].indices_.push_back( static_cast<uint32_t>( i ) );
+	}
+	std::sort( partitions.begin(), partitions.end(), []( const any_sort_partition& a, const any_sort_partition& b ) {
+		return std::type_index( *( a.p_type_ ) ) < std::type_index( *( b.p_type_ ) );
+	} );
+
+	// sort each partition. the larger partition is taken earlier to balance the threads.
+	std::vector<size_t> order( partitions.size() );
+	for ( size_t i = 0; i < order.size(); i++ ) {
+		order[i] = i;
+	}
+	std::sort( order.begin(), order.end(), [&partitions]( size_t a, size_t b ) {
+		return partitions[a].indices_.size() > partitions[b].indices_.size();
+	} );
+
+	if ( num_of_threads == 0 ) {
+		num_of_threads = std::max<size_t>( std::thread::hardware_concurrency(), 1 );
+	}
+	num_of_threads = std::min( num_of_threads, partitions.size() );
+	if ( n < any_sort_parallel_threshold ) {
+		num_of_threads = 1;
+	}
+
+	// each partition is moved to the temporary buffer at the offset of the partition after sorting.
+	std::vector<size_t> offsets( partitions.size() );
+	for ( size_t i = 1; i < partitions.size(); i++ ) {
+		offsets[i] = offsets[i - 1] + partitions[i - 1].indices_.size();
+	}
+	std::vector<alias_t> tmp( n );
+
+	// the exception in a worker is kept and rethrown after all threads are joined. the other workers stop taking the next partition.
+	std::atomic<size_t> next { 0 };
+	std::atomic<bool>   has_error { false };
+	std::exception_ptr  p_error;
+	auto                worker = [&]() {
+		try {
+			for ( size_t k = next.fetch_add( 1 ); k < order.size(); k = next.fetch_add( 1 ) ) {
+				any_sort_sort_partition( first, partitions[order[k]], tmp.data() + offsets[order[k]], type_list );
+			}
+		} catch ( ... ) {
+			next.store( order.size() );
+			if ( !has_error.exchange( true ) ) {
+				p_error = std::current_exception();
+			}
+		}
+	};
+	{
+		std::vector<std::thread> threads;
+		any_sort_thread_joiner   joiner { threads };
+		for ( size_t i = 1; i < num_of_threads; i++ ) {
+			threads.emplace_back( worker );
+		}
+		worker();
+	}
+	if ( p_error ) {
+		std::rethrow_exception( p_error );
+	}
+
+	for ( size_t i = 0; i < n; i++ ) {
+		first[static_cast<diff_t>( i )] = std::move( tmp[i] );
+	}
+}
+
+/**
+ * @brief value types that yan::any_sort() sorts by the typed comparison if no type is specified
+ */
+template <typename Alias>
+using any_sort_default_type_list = any_sort_type_list<Alias, int, long, long long, unsigned int, unsigned long, unsigned long long, float, double, std::string>;
+
+}   // namespace impl
+
+/**
+ * @brief sort the range of constrained_any in the order of less()
+ *
+ * @tparam Ts value types that are sorted by the typed comparison. If empty, the arithmetic types and std::string are used.
+ *
+ * @param num_of_threads maximum number of the threads. 0 means std::thread::hardware_concurrency().
+ *
+ * @note
+ * Ts should have operator< that is same to less() of constrained_any. The elements of the type not in Ts are sorted by less().
+ *
+ * @exception the exception thrown by the comparison or the move of the value is rethrown after all threads are joined.
+ * In this case, the elements of the range are valid but unspecified, same to std::sort().
+ */
+template <typename... Ts, typename RandomIt,
+          typename std::enable_if<is_specialized_of_constrained_any<typename std::iterator_traits<RandomIt>::value_type>::value>::type* = nullptr>
+void any_sort( RandomIt first, RandomIt last, size_t num_of_threads = 0 )
+{
+	using alias_t = typename std::iterator_traits<RandomIt>::value_type;
+	if constexpr ( sizeof...( Ts ) == 0 ) {
+		impl::any_sort_impl( first, last, num_of_threads, impl::any_sort_default_type_list<alias_t> {} );
+	} else {
+		impl::any_sort_impl( first, last, num_of_threads, impl::any_sort_type_list<alias_t, Ts...> {} );
+	}
+}
+
+/**
+ * @brief sort the range of constrained_any in the order of less()
+ */
+template <typename... Ts, typename Range,
+          typename std::enable_if<is_specialized_of_constrained_any<typename std::iterator_traits<decltype( std::begin( std::declval<Range&>() ) )>::value_type>::value>::type* = nullptr>
+void any_sort( Range& r, size_t num_of_threads = 0 )
+{
+	yan::any_sort<Ts...>( std::begin( r ), std::end( r ), num_of_threads );
+}
+
+}   // namespace yan
+
+#endif
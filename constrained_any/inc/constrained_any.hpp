@@ -17,26 +17,57 @@
 #endif
 
 #include <any>
+#include <cstddef>
+#include <cstdint>
 #include <functional>   // for std::hash
+#include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
 #include <type_traits>
 #include <typeindex>
 #include <typeinfo>
 #include <utility>
+#include <vector>
+
+#include "constrained_any_arena.hpp"
+#include "constrained_any_heap_carrier_pool.hpp"
+#include "constrained_any_instrumentation.hpp"
+#include "constrained_any_type_registry.hpp"
 
 namespace yan {   // yet another
 
 namespace impl {
 
-static constexpr size_t sso_buff_size = 128;
+static constexpr size_t sso_buff_size      = 128 - sizeof( void* );   // inline buffer and the carrier pointer fill 128 bytes
+static constexpr size_t sso_buff_alignment = alignof( std::max_align_t );
 
 class constrained_any_tag { };
 
+/**
+ * @brief interface of the holder of shared special operations
+ *
+ * One holder object is shared by all value carriers of same type. Therefore, a value carrier has only one vptr,
+ * even if constrained_any has many special operations that set share_special_operation to true.
+ */
+struct special_operation_holder_if {
+	virtual ~special_operation_holder_if() = default;
+};
+
 struct value_carrier_if_common {
 	virtual ~value_carrier_if_common() = default;
 
 	virtual const std::type_info& get_type_info() const noexcept = 0;
+
+	virtual uint64_t get_stable_type_id() const noexcept
+	{
+		return 0;
+	}
+
+	virtual special_operation_holder_if* get_special_operations( void ) const noexcept
+	{
+		return nullptr;
+	}
 };
 
 }   // namespace impl
@@ -102,6 +133,31 @@ struct is_related_type_of_constrained_any {
 
 namespace impl {
 
+template <typename Dispatcher>
+struct special_operation_dispatcher_placeholder { };
+
+}   // namespace impl
+
+/**
+ * @brief helper to select the base class of the shared special operation class
+ *
+ * The shared special operation class sets share_special_operation to true, and derives from this type.
+ * @li If Carrier is specialized constrained_any, this is an empty class. Therefore, constrained_any has no vptr of it.
+ * @li Otherwise, this is Dispatcher. Dispatcher derives from the interface class, and implements the proxy functions that receive value carrier as the argument.
+ *
+ * Dispatcher object is not the part of value carrier. It is the part of the holder object that is shared by all value carriers of same type.
+ * Therefore, Dispatcher should access the value via the value carrier argument, not via this pointer.
+ *
+ * @tparam Carrier template parameter of the special operation class
+ * @tparam Dispatcher class that implements the interface class
+ */
+template <typename Carrier, typename Dispatcher>
+using special_operation_dispatcher_base_t = typename std::conditional<is_specialized_of_constrained_any<Carrier>::value,
+                                                                      impl::special_operation_dispatcher_placeholder<Dispatcher>,
+                                                                      Dispatcher>::type;
+
+namespace impl {
+
 // helper metafunction like std::remove cvref for C++17
 #if __cpp_lib_remove_cvref >= 201711L
 template <typename T>
@@ -206,6 +262,312 @@ struct is_acceptable_value_type<std::any, UConstrainAndOperationArgs...> {
 	static constexpr bool value = false;
 };
 
+// =====================
+
+struct specified_inline_buffer_size_impl {
+	template <typename T, typename VT = typename impl::remove_cvref<T>::type>
+	static auto check( T* ) -> std::integral_constant<size_t, VT::inline_buffer_size>;
+	template <typename T>
+	static auto check( ... ) -> std::integral_constant<size_t, 0>;
+};
+
+// 0 means that T does not specify the size of inline buffer
+template <typename T>
+struct specified_inline_buffer_size : public decltype( specified_inline_buffer_size_impl::check<T>( nullptr ) ) { };
+
+constexpr size_t select_inline_buffer_size( std::initializer_list<size_t> specified_sizes )
+{
+	size_t ans = sso_buff_size;
+	for ( size_t sz : specified_sizes ) {
+		if ( ( sz != 0 ) && ( sz < ans ) ) {
+			ans = sz;
+		}
+	}
+	return ans;
+}
+
+/**
+ * @brief size of the inline buffer of constrained_any
+ *
+ * If some of ConstrainAndOperationArgs have static constexpr size_t member variable "inline_buffer_size", the smallest one is selected.
+ * Otherwise, sso_buff_size is selected.
+ */
+template <template <class> class... ConstrainAndOperationArgs>
+struct inline_buffer_size_of {
+	static constexpr size_t value = select_inline_buffer_size( { specified_inline_buffer_size<ConstrainAndOperationArgs<impl::constrained_any_tag>>::value... } );
+};
+
+// =====================
+
+struct specified_heap_carrier_pool_impl {
+	template <typename T, typename VT = typename impl::remove_cvref<T>::type>
+	static auto check( T* ) -> decltype( VT::use_heap_carrier_pool == true, std::integral_constant<bool, VT::use_heap_carrier_pool> {} );
+	template <typename T>
+	static auto check( ... ) -> std::false_type;
+};
+
+template <typename T>
+struct specified_heap_carrier_pool : public decltype( specified_heap_carrier_pool_impl::check<T>( nullptr ) ) { };
+
+/**
+ * @brief whether the value carrier in the heap is allocated from the heap carrier pool
+ *
+ * If YAN_CONSTRAINED_ANY_ENABLE_HEAP_CARRIER_POOL is defined, all constrained_any use the heap carrier pool.
+ * Otherwise, only constrained_any that has a ConstrainAndOperationArgs with static constexpr bool member variable "use_heap_carrier_pool = true" uses it.
+ */
+template <template <class> class... ConstrainAndOperationArgs>
+struct use_heap_carrier_pool_of {
+#ifdef YAN_CONSTRAINED_ANY_ENABLE_HEAP_CARRIER_POOL
+	static constexpr bool value = true;
+#else
+	static constexpr bool value = ( false || ... || specified_heap_carrier_pool<ConstrainAndOperationArgs<impl::constrained_any_tag>>::value );
+#endif
+};
+
+struct specified_arena_heap_impl {
+	template <typename T, typename VT = typename impl::remove_cvref<T>::type>
+	static auto check( T* ) -> decltype( VT::use_arena_heap == true, std::integral_constant<bool, VT::use_arena_heap> {} );
+	template <typename T>
+	static auto check( ... ) -> std::false_type;
+};
+
+template <typename T>
+struct specified_arena_heap : public decltype( specified_arena_heap_impl::check<T>( nullptr ) ) { };
+
+enum class heap_carrier_allocator_kind {
+	global,   //!< global operator new/delete
+	pool,     //!< heap carrier pool
+	arena     //!< active any_arena of the current thread
+};
+
+/**
+ * @brief allocator of the value carrier in the heap
+ *
+ * If some of ConstrainAndOperationArgs have static constexpr bool member variable "use_arena_heap = true", any_arena is selected.
+ * Otherwise, if use_heap_carrier_pool_of is true, the heap carrier pool is selected.
+ */
+template <template <class> class... ConstrainAndOperationArgs>
+struct heap_carrier_allocator_of {
+	static constexpr heap_carrier_allocator_kind value = ( false || ... || specified_arena_heap<ConstrainAndOperationArgs<impl::constrained_any_tag>>::value )
+	                                                         ? heap_carrier_allocator_kind::arena
+	                                                         : ( use_heap_carrier_pool_of<ConstrainAndOperationArgs...>::value ? heap_carrier_allocator_kind::pool : heap_carrier_allocator_kind::global );
+};
+
+/**
+ * @brief selected allocator of the empty value carrier in the heap
+ *
+ * Without C++20, the empty value carrier is also allocated in the heap. It is not allocated from any_arena,
+ * because default construction and reset() should not require the active any_arena.
+ */
+template <template <class> class... ConstrainAndOperationArgs>
+struct empty_heap_carrier_allocator_of {
+	static constexpr heap_carrier_allocator_kind value = ( heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value == heap_carrier_allocator_kind::arena )
+	                                                         ? heap_carrier_allocator_kind::global
+	                                                         : heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value;
+};
+
+template <typename Alias>
+struct is_arena_bound_alias : public std::false_type { };
+
+template <template <class> class... ConstrainAndOperationArgs>
+struct is_arena_bound_alias<constrained_any<ConstrainAndOperationArgs...>>
+  : public std::integral_constant<bool, heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value == heap_carrier_allocator_kind::arena> { };
+
+/**
+ * @brief base class of value carrier to select the allocation function of the value carrier in the heap
+ *
+ * @tparam Kind if not global, class specific operator new/delete allocate the value carrier from the selected allocator.
+ * Otherwise, global operator new/delete are used.
+ */
+template <heap_carrier_allocator_kind Kind>
+struct heap_carrier_allocation { };
+
+template <>
+struct heap_carrier_allocation<heap_carrier_allocator_kind::pool> {
+	static void* operator new( std::size_t sz )
+	{
+		return heap_carrier_pool_allocate( sz );
+	}
+	static void* operator new( std::size_t sz, std::align_val_t al )
+	{
+		return heap_carrier_pool_allocate_over_aligned( sz, al );
+	}
+	static void* operator new( std::size_t, void* p ) noexcept   // placement new for the inline buffer
+	{
+		return p;
+	}
+
+	static void operator delete( void* p, std::size_t sz ) noexcept
+	{
+		heap_carrier_pool_deallocate( p, sz );
+	}
+	static void operator delete( void* p, std::size_t, std::align_val_t al ) noexcept
+	{
+		heap_carrier_pool_deallocate_over_aligned( p, al );
+	}
+	static void operator delete( void*, void* ) noexcept
+	{
+	}
+};
+
+template <>
+struct heap_carrier_allocation<heap_carrier_allocator_kind::arena> {
+	static void* operator new( std::size_t sz )
+	{
+		return any_arena_allocate( sz, alignof( std::max_align_t ) );
+	}
+	static void* operator new( std::size_t sz, std::align_val_t al )
+	{
+		return any_arena_allocate( sz, static_cast<size_t>( al ) );
+	}
+	static void* operator new( std::size_t, void* p ) noexcept   // placement new for the inline buffer
+	{
+		return p;
+	}
+
+	// any_arena releases the memory all at once. Therefore, individual deallocation is nothing to do.
+	static void operator delete( void*, std::size_t ) noexcept
+	{
+	}
+	static void operator delete( void*, std::size_t, std::align_val_t ) noexcept
+	{
+	}
+	static void operator delete( void*, void* ) noexcept
+	{
+	}
+};
+
+// =====================
+
+struct is_shared_special_operation_impl {
+	template <typename T, typename VT = typename impl::remove_cvref<T>::type>
+	static auto check( T* ) -> decltype( VT::share_special_operation == true, std::integral_constant<bool, VT::share_special_operation> {} );
+	template <typename T>
+	static auto check( ... ) -> std::false_type;
+};
+
+template <typename T>
+struct is_shared_special_operation : public decltype( is_shared_special_operation_impl::check<T>( nullptr ) ) { };
+
+template <template <class> class ConstrainAndOperation>
+struct is_shared_special_operation_class {
+	static constexpr bool value = is_shared_special_operation<ConstrainAndOperation<impl::constrained_any_tag>>::value;
+};
+
+template <template <class> class ConstrainAndOperation>
+struct shared_special_operation_placeholder { };
+
+// base class of value carrier. shared special operation is moved to special_operation_holder.
+template <template <class> class ConstrainAndOperation, typename Carrier>
+using carrier_special_operation_base_t = typename std::conditional<is_shared_special_operation_class<ConstrainAndOperation>::value,
+                                                                   shared_special_operation_placeholder<ConstrainAndOperation>,
+                                                                   ConstrainAndOperation<Carrier>>::type;
+
+// base class of special_operation_holder. only shared special operation is held.
+template <template <class> class ConstrainAndOperation, typename Carrier>
+using holder_special_operation_base_t = typename std::conditional<is_shared_special_operation_class<ConstrainAndOperation>::value,
+                                                                  ConstrainAndOperation<Carrier>,
+                                                                  shared_special_operation_placeholder<ConstrainAndOperation>>::type;
+
+/**
+ * @brief holder of shared special operations of Carrier
+ *
+ * @tparam Carrier value carrier type
+ * @tparam ConstrainAndOperationArgs template parameter packs for multiple constrained and specialized operator classes.
+ */
+template <typename Carrier, template <class> class... ConstrainAndOperationArgs>
+class special_operation_holder final : public special_operation_holder_if, public holder_special_operation_base_t<ConstrainAndOperationArgs, Carrier>... {
+public:
+	static constexpr bool has_shared_special_operation = ( ... || is_shared_special_operation_class<ConstrainAndOperationArgs>::value );
+
+	static special_operation_holder_if* get_instance( void ) noexcept
+	{
+		if constexpr ( has_shared_special_operation ) {
+			static special_operation_holder singleton;
+			return &singleton;
+		} else {
+			return nullptr;
+		}
+	}
+};
+
+/**
+ * @brief check that two value carriers are same carrier type, i.e. hold same value type
+ *
+ * typeid of polymorphic object is read from its vtable without virtual function call.
+ * Since value carrier is specialized for each value type, same carrier type means same value type.
+ */
+inline bool is_same_carrier_type( const value_carrier_if_common& a, const value_carrier_if_common& b ) noexcept
+{
+	return typeid( a ) == typeid( b );
+}
+
+/**
+ * @brief index of the direct mapped table of 2^Bits entries that is keyed by the address of type_info
+ *
+ * Fibonacci hashing. type_info objects are placed close together, so the low bits of the address alone collide.
+ */
+template <size_t Bits>
+inline size_t type_info_slot_of( const std::type_info* p_type ) noexcept
+{
+	static_assert( ( 0 < Bits ) && ( Bits < 64 ), "Bits should be in 1..63" );
+	return static_cast<size_t>( ( static_cast<uint64_t>( reinterpret_cast<uintptr_t>( p_type ) ) * 0x9E3779B97F4A7C15ULL ) >> ( 64 - Bits ) );
+}
+
+/**
+ * @brief per thread cache of the shared special operation interface of each value carrier type
+ *
+ * The holder of shared special operations is the singleton of each value carrier type. Therefore, the result of dynamic_cast from the holder
+ * depends only on the value carrier type, and it is cached with the key of typeid of the value carrier that is read from its vtable.
+ * The cache is the small direct mapped table. A miss just falls back to dynamic_cast.
+ */
+template <typename SpecializedOperatorIF>
+struct special_operation_if_cache {
+	struct entry {
+		const std::type_info*  p_carrier_type_;
+		SpecializedOperatorIF* p_if_;
+	};
+
+	static constexpr size_t num_of_entries_bits = 4;
+	static constexpr size_t num_of_entries      = size_t { 1 } << num_of_entries_bits;
+
+	static SpecializedOperatorIF* find_in_holder( const value_carrier_if_common* p_carrier ) noexcept
+	{
+		thread_local entry entries[num_of_entries] = {};
+
+		const std::type_info* p_key = &typeid( *p_carrier );
+		entry&                e     = entries[type_info_slot_of<num_of_entries_bits>( p_key )];
+		if ( e.p_carrier_type_ != p_key ) {
+			e.p_if_           = dynamic_cast<SpecializedOperatorIF*>( p_carrier->get_special_operations() );
+			e.p_carrier_type_ = p_key;
+		}
+		return e.p_if_;
+	}
+};
+
+/**
+ * @brief find special operation interface from the holder of shared special operations, and then from the value carrier itself
+ */
+template <typename SpecializedOperatorIF>
+SpecializedOperatorIF* find_special_operation_if( value_carrier_if_common* p_carrier ) noexcept
+{
+	SpecializedOperatorIF* p_ans = special_operation_if_cache<SpecializedOperatorIF>::find_in_holder( p_carrier );
+	if ( p_ans != nullptr ) {
+		return p_ans;
+	}
+	return dynamic_cast<SpecializedOperatorIF*>( p_carrier );
+}
+
+template <typename SpecializedOperatorIF>
+const SpecializedOperatorIF* find_special_operation_if( const value_carrier_if_common* p_carrier ) noexcept
+{
+	const SpecializedOperatorIF* p_ans = special_operation_if_cache<SpecializedOperatorIF>::find_in_holder( p_carrier );
+	if ( p_ans != nullptr ) {
+		return p_ans;
+	}
+	return dynamic_cast<const SpecializedOperatorIF*>( p_carrier );
+}
+
 }   // namespace impl
 
 // =====================
@@ -217,27 +579,36 @@ namespace impl {
 template <bool SupportUseCopy, bool SupportUseMove>
 struct value_carrier_if;
 
+// destroy() and relocate_to() know the storage class of the value carrier. Therefore, constrained_any does not need to keep where the value carrier is.
+// destroy() destructs the value carrier in the inline buffer or deletes the value carrier in the heap.
+// relocate_to() moves the value carrier in the inline buffer to p_buff, or returns the value carrier in the heap as it is.
 template <bool SupportUseMove>
 struct value_carrier_if<true, SupportUseMove> : public value_carrier_if_common {
 	using abst_if_t = value_carrier_if<true, SupportUseMove>;
 
-	virtual std::unique_ptr<abst_if_t> mk_clone_by_copy_construction( abst_if_t**, unsigned char* ) const      = 0;
-	virtual std::unique_ptr<abst_if_t> mk_clone_by_move_construction( abst_if_t**, unsigned char* )            = 0;
-	virtual std::unique_ptr<abst_if_t> copy_my_value_to_other( abst_if_t&, abst_if_t**, unsigned char* ) const = 0;
-	virtual std::unique_ptr<abst_if_t> move_my_value_to_other( abst_if_t&, abst_if_t**, unsigned char* )       = 0;
+	virtual void       destroy( void ) noexcept                                                  = 0;
+	virtual abst_if_t* relocate_to( unsigned char* p_buff ) noexcept                             = 0;
+	virtual abst_if_t* mk_clone_by_copy_construction( unsigned char* p_buff ) const              = 0;
+	virtual abst_if_t* mk_clone_by_move_construction( unsigned char* p_buff )                    = 0;
+	virtual abst_if_t* copy_my_value_to_other( abst_if_t& other, unsigned char* p_buff ) const = 0;
+	virtual abst_if_t* move_my_value_to_other( abst_if_t& other, unsigned char* p_buff )       = 0;
 };
 
 template <>
 struct value_carrier_if<false, true> : public value_carrier_if_common {
 	using abst_if_t = value_carrier_if<false, true>;
 
-	virtual std::unique_ptr<abst_if_t> mk_clone_by_move_construction( abst_if_t**, unsigned char* )      = 0;
-	virtual std::unique_ptr<abst_if_t> move_my_value_to_other( abst_if_t&, abst_if_t**, unsigned char* ) = 0;
+	virtual void       destroy( void ) noexcept                                            = 0;
+	virtual abst_if_t* relocate_to( unsigned char* p_buff ) noexcept                       = 0;
+	virtual abst_if_t* mk_clone_by_move_construction( unsigned char* p_buff )              = 0;
+	virtual abst_if_t* move_my_value_to_other( abst_if_t& other, unsigned char* p_buff ) = 0;
 };
 
 template <>
 struct value_carrier_if<false, false> : public value_carrier_if_common {
 	using abst_if_t = value_carrier_if<false, false>;
+
+	virtual void destroy( void ) noexcept = 0;
 };
 
 // primary template for value_carrier
@@ -246,11 +617,12 @@ struct value_carrier;
 
 // specialization for void
 template <bool SupportUseMove, template <class> class... ConstrainAndOperationArgs>
-struct value_carrier<void, true, SupportUseMove, ConstrainAndOperationArgs...> : public value_carrier_if<true, SupportUseMove> {
+struct value_carrier<void, true, SupportUseMove, ConstrainAndOperationArgs...> : public value_carrier_if<true, SupportUseMove>, public carrier_instrumentation_probe<value_carrier<void, true, SupportUseMove, ConstrainAndOperationArgs...>, true>, public heap_carrier_allocation<heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value> {
 	using abst_if_t  = typename value_carrier_if<true, SupportUseMove>::abst_if_t;
 	using value_type = void;
 
-	static constexpr bool is_possible_sso = ( sizeof( value_carrier ) < yan::impl::sso_buff_size ) &&
+	static constexpr bool is_possible_sso = ( sizeof( value_carrier ) <= inline_buffer_size_of<ConstrainAndOperationArgs...>::value ) &&
+	                                        ( alignof( value_carrier ) <= yan::impl::sso_buff_alignment ) &&
 	                                        std::is_nothrow_move_constructible<value_carrier>::value;
 
 	~value_carrier()                                 = default;
@@ -270,47 +642,62 @@ struct value_carrier<void, true, SupportUseMove, ConstrainAndOperationArgs...> :
 		return typeid( void );
 	}
 
-	std::unique_ptr<abst_if_t> mk_clone_by_copy_construction( abst_if_t** pp_k, unsigned char* p_buff ) const override
+	void destroy( void ) noexcept override
 	{
-		std::unique_ptr<abst_if_t> up_ans;
 		if constexpr ( is_possible_sso ) {
-			*pp_k = new ( p_buff ) value_carrier( *this );
+			this->~value_carrier();
 		} else {
-			up_ans = std::make_unique<value_carrier>( *this );
-			*pp_k  = up_ans.get();
+			delete this;
 		}
-		return up_ans;
 	}
 
-	std::unique_ptr<abst_if_t> mk_clone_by_move_construction( abst_if_t** pp_k, unsigned char* p_buff ) override
+	abst_if_t* relocate_to( unsigned char* p_buff ) noexcept override
 	{
-		std::unique_ptr<abst_if_t> up_ans;
 		if constexpr ( is_possible_sso ) {
-			*pp_k = new ( p_buff ) value_carrier( std::move( *this ) );
+			abst_if_t* p_ans = new ( p_buff ) value_carrier( std::move( *this ) );
+			this->~value_carrier();
+			return p_ans;
 		} else {
-			up_ans = std::make_unique<value_carrier>( std::move( *this ) );
-			*pp_k  = up_ans.get();
+			return this;
 		}
-		return up_ans;
 	}
 
-	std::unique_ptr<abst_if_t> copy_my_value_to_other( abst_if_t& other, abst_if_t** pp_k, unsigned char* p_buff ) const override
+	abst_if_t* mk_clone_by_copy_construction( unsigned char* p_buff ) const override
 	{
-		return nullptr;
+		if constexpr ( is_possible_sso ) {
+			return new ( p_buff ) value_carrier( *this );
+		} else {
+			return new value_carrier( *this );
+		}
 	}
-	std::unique_ptr<abst_if_t> move_my_value_to_other( abst_if_t& other, abst_if_t** pp_k, unsigned char* p_buff ) override
+
+	abst_if_t* mk_clone_by_move_construction( unsigned char* p_buff ) override
 	{
-		return nullptr;
+		if constexpr ( is_possible_sso ) {
+			return new ( p_buff ) value_carrier( std::move( *this ) );
+		} else {
+			return new value_carrier( std::move( *this ) );
+		}
+	}
+
+	abst_if_t* copy_my_value_to_other( abst_if_t& other, unsigned char* p_buff ) const override
+	{
+		return &other;
+	}
+	abst_if_t* move_my_value_to_other( abst_if_t& other, unsigned char* p_buff ) override
+	{
+		return &other;
 	}
 };
 
 // specialization for void
 template <template <class> class... ConstrainAndOperationArgs>
-struct value_carrier<void, false, true, ConstrainAndOperationArgs...> : public value_carrier_if<false, true> {
+struct value_carrier<void, false, true, ConstrainAndOperationArgs...> : public value_carrier_if<false, true>, public carrier_instrumentation_probe<value_carrier<void, false, true, ConstrainAndOperationArgs...>, true>, public heap_carrier_allocation<heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value> {
 	using abst_if_t  = typename value_carrier_if<false, true>::abst_if_t;
 	using value_type = void;
 
-	static constexpr bool is_possible_sso = ( sizeof( value_carrier ) < yan::impl::sso_buff_size ) &&
+	static constexpr bool is_possible_sso = ( sizeof( value_carrier ) <= inline_buffer_size_of<ConstrainAndOperationArgs...>::value ) &&
+	                                        ( alignof( value_carrier ) <= yan::impl::sso_buff_alignment ) &&
 	                                        std::is_nothrow_move_constructible<value_carrier>::value;
 
 	~value_carrier()                                 = default;
@@ -330,31 +717,49 @@ struct value_carrier<void, false, true, ConstrainAndOperationArgs...> : public v
 		return typeid( void );
 	}
 
-	std::unique_ptr<abst_if_t> mk_clone_by_move_construction( abst_if_t** pp_k, unsigned char* p_buff ) override
+	void destroy( void ) noexcept override
 	{
-		std::unique_ptr<abst_if_t> up_ans;
 		if constexpr ( is_possible_sso ) {
-			*pp_k = new ( p_buff ) value_carrier( std::move( *this ) );
+			this->~value_carrier();
 		} else {
-			up_ans = std::make_unique<value_carrier>( std::move( *this ) );
-			*pp_k  = up_ans.get();
+			delete this;
 		}
-		return up_ans;
 	}
 
-	std::unique_ptr<abst_if_t> move_my_value_to_other( abst_if_t& other, abst_if_t** pp_k, unsigned char* p_buff ) override
+	abst_if_t* relocate_to( unsigned char* p_buff ) noexcept override
 	{
-		return nullptr;
+		if constexpr ( is_possible_sso ) {
+			abst_if_t* p_ans = new ( p_buff ) value_carrier( std::move( *this ) );
+			this->~value_carrier();
+			return p_ans;
+		} else {
+			return this;
+		}
+	}
+
+	abst_if_t* mk_clone_by_move_construction( unsigned char* p_buff ) override
+	{
+		if constexpr ( is_possible_sso ) {
+			return new ( p_buff ) value_carrier( std::move( *this ) );
+		} else {
+			return new value_carrier( std::move( *this ) );
+		}
+	}
+
+	abst_if_t* move_my_value_to_other( abst_if_t& other, unsigned char* p_buff ) override
+	{
+		return &other;
 	}
 };
 
 // specialization for void
 template <template <class> class... ConstrainAndOperationArgs>
-struct value_carrier<void, false, false, ConstrainAndOperationArgs...> : public value_carrier_if<false, false> {
+struct value_carrier<void, false, false, ConstrainAndOperationArgs...> : public value_carrier_if<false, false>, public carrier_instrumentation_probe<value_carrier<void, false, false, ConstrainAndOperationArgs...>, true>, public heap_carrier_allocation<heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value> {
 	using abst_if_t  = typename value_carrier_if<false, false>::abst_if_t;
 	using value_type = void;
 
-	static constexpr bool is_possible_sso = ( sizeof( value_carrier ) < yan::impl::sso_buff_size ) &&
+	static constexpr bool is_possible_sso = ( sizeof( value_carrier ) <= inline_buffer_size_of<ConstrainAndOperationArgs...>::value ) &&
+	                                        ( alignof( value_carrier ) <= yan::impl::sso_buff_alignment ) &&
 	                                        std::is_nothrow_move_constructible<value_carrier>::value;
 
 	~value_carrier()                                 = default;
@@ -373,14 +778,24 @@ struct value_carrier<void, false, false, ConstrainAndOperationArgs...> : public
 	{
 		return typeid( void );
 	}
+
+	void destroy( void ) noexcept override
+	{
+		if constexpr ( is_possible_sso ) {
+			this->~value_carrier();
+		} else {
+			delete this;
+		}
+	}
 };
 
 template <typename T, bool SupportUseMove, template <class> class... ConstrainAndOperationArgs>
-struct value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...> : public value_carrier_if<true, SupportUseMove>, public ConstrainAndOperationArgs<value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...>>... {
+struct value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...> : public value_carrier_if<true, SupportUseMove>, public carrier_instrumentation_probe<value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...>, true>, public heap_carrier_allocation<heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value>, public carrier_special_operation_base_t<ConstrainAndOperationArgs, value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...>>... {
 	using abst_if_t  = typename value_carrier_if<true, SupportUseMove>::abst_if_t;
 	using value_type = T;
 
-	static constexpr bool is_possible_sso = ( sizeof( value_carrier ) < yan::impl::sso_buff_size ) &&
+	static constexpr bool is_possible_sso = ( sizeof( value_carrier ) <= inline_buffer_size_of<ConstrainAndOperationArgs...>::value ) &&
+	                                        ( alignof( value_carrier ) <= yan::impl::sso_buff_alignment ) &&
 	                                        std::is_nothrow_move_constructible<value_carrier>::value;
 
 	~value_carrier()                                 = default;
@@ -411,52 +826,92 @@ struct value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...> : pu
 		return typeid( value_type );
 	}
 
-	std::unique_ptr<abst_if_t> mk_clone_by_copy_construction( abst_if_t** pp_k, unsigned char* p_buff ) const override
+	uint64_t get_stable_type_id() const noexcept override
+	{
+		return type_registry::id_of<value_type>();
+	}
+
+	special_operation_holder_if* get_special_operations( void ) const noexcept override
+	{
+		return special_operation_holder<value_carrier, ConstrainAndOperationArgs...>::get_instance();
+	}
+
+	void destroy( void ) noexcept override
 	{
-		std::unique_ptr<abst_if_t> up_ans;
 		if constexpr ( is_possible_sso ) {
-			*pp_k = new ( p_buff ) value_carrier( *this );
+			this->~value_carrier();
 		} else {
-			up_ans = std::make_unique<value_carrier>( *this );
-			*pp_k  = up_ans.get();
+			delete this;
 		}
-		return up_ans;
 	}
 
-	std::unique_ptr<abst_if_t> mk_clone_by_move_construction( abst_if_t** pp_k, unsigned char* p_buff ) override
+	abst_if_t* relocate_to( unsigned char* p_buff ) noexcept override
 	{
-		std::unique_ptr<abst_if_t> up_ans;
 		if constexpr ( is_possible_sso ) {
-			*pp_k = new ( p_buff ) value_carrier( std::move( *this ) );
+			abst_if_t* p_ans = new ( p_buff ) value_carrier( std::move( *this ) );
+			this->~value_carrier();
+			return p_ans;
 		} else {
-			up_ans = std::make_unique<value_carrier>( std::move( *this ) );
-			*pp_k  = up_ans.get();
+			return this;
+		}
+	}
+
+	abst_if_t* mk_clone_by_copy_construction( unsigned char* p_buff ) const override
+	{
+		if constexpr ( is_possible_sso ) {
+			return new ( p_buff ) value_carrier( *this );
+		} else {
+			return new value_carrier( *this );
 		}
-		return up_ans;
 	}
 
-	std::unique_ptr<abst_if_t> copy_my_value_to_other( abst_if_t& other, abst_if_t** pp_k, unsigned char* p_buff ) const override
+	abst_if_t* mk_clone_by_move_construction( unsigned char* p_buff ) override
 	{
-		value_carrier& ref_other = dynamic_cast<value_carrier&>( other );
+		if constexpr ( is_possible_sso ) {
+			return new ( p_buff ) value_carrier( std::move( *this ) );
+		} else {
+			return new value_carrier( std::move( *this ) );
+		}
+	}
+
+	abst_if_t* copy_my_value_to_other( abst_if_t& other, unsigned char* p_buff ) const override
+	{
+		value_carrier& ref_other = static_cast<value_carrier&>( other );   // caller has already checked that other is same carrier type by is_same_carrier_type()
 		if constexpr ( std::is_copy_assignable<value_carrier>::value ) {
 			ref_other = *this;
 
-			return nullptr;
+			return &ref_other;
 		} else {
-			( *pp_k )->~abst_if_t();   // TODO: ソース変更に対して不安定になりやすい、危険なコード
-			return mk_clone_by_copy_construction( pp_k, p_buff );
+			if constexpr ( is_possible_sso ) {
+				// other is in p_buff. the copy is constructed out of p_buff at first to keep other if the copy construction throws.
+				value_carrier tmp( *this );
+				ref_other.destroy();
+				return new ( p_buff ) value_carrier( std::move( tmp ) );
+			} else {
+				abst_if_t* p_ans = mk_clone_by_copy_construction( p_buff );
+				ref_other.destroy();
+				return p_ans;
+			}
 		}
 	}
-	std::unique_ptr<abst_if_t> move_my_value_to_other( abst_if_t& other, abst_if_t** pp_k, unsigned char* p_buff ) override
+	abst_if_t* move_my_value_to_other( abst_if_t& other, unsigned char* p_buff ) override
 	{
-		value_carrier& ref_other = dynamic_cast<value_carrier&>( other );
+		value_carrier& ref_other = static_cast<value_carrier&>( other );   // caller has already checked that other is same carrier type by is_same_carrier_type()
 		if constexpr ( std::is_move_assignable<value_carrier>::value ) {
 			ref_other = std::move( *this );
 
-			return nullptr;
+			return &ref_other;
 		} else {
-			( *pp_k )->~abst_if_t();   // TODO: ソース変更に対して不安定になりやすい、危険なコード
-			return mk_clone_by_move_construction( pp_k, p_buff );
+			if constexpr ( is_possible_sso ) {
+				// other is in p_buff. the new value carrier is constructed out of p_buff at first to keep other if the construction throws.
+				value_carrier tmp( std::move( *this ) );
+				ref_other.destroy();
+				return new ( p_buff ) value_carrier( std::move( tmp ) );
+			} else {
+				abst_if_t* p_ans = mk_clone_by_move_construction( p_buff );
+				ref_other.destroy();
+				return p_ans;
+			}
 		}
 	}
 
@@ -465,11 +920,12 @@ private:
 };
 
 template <typename T, template <class> class... ConstrainAndOperationArgs>
-struct value_carrier<T, false, true, ConstrainAndOperationArgs...> : public value_carrier_if<false, true>, public ConstrainAndOperationArgs<value_carrier<T, false, true, ConstrainAndOperationArgs...>>... {
+struct value_carrier<T, false, true, ConstrainAndOperationArgs...> : public value_carrier_if<false, true>, public carrier_instrumentation_probe<value_carrier<T, false, true, ConstrainAndOperationArgs...>, true>, public heap_carrier_allocation<heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value>, public carrier_special_operation_base_t<ConstrainAndOperationArgs, value_carrier<T, false, true, ConstrainAndOperationArgs...>>... {
 	using abst_if_t  = typename value_carrier_if<false, true>::abst_if_t;
 	using value_type = T;
 
-	static constexpr bool is_possible_sso = ( sizeof( value_carrier ) < yan::impl::sso_buff_size ) &&
+	static constexpr bool is_possible_sso = ( sizeof( value_carrier ) <= inline_buffer_size_of<ConstrainAndOperationArgs...>::value ) &&
+	                                        ( alignof( value_carrier ) <= yan::impl::sso_buff_alignment ) &&
 	                                        std::is_nothrow_move_constructible<value_carrier>::value;
 
 	~value_carrier()                                 = default;
@@ -500,28 +956,63 @@ struct value_carrier<T, false, true, ConstrainAndOperationArgs...> : public valu
 		return typeid( value_type );
 	}
 
-	std::unique_ptr<abst_if_t> mk_clone_by_move_construction( abst_if_t** pp_k, unsigned char* p_buff ) override
+	uint64_t get_stable_type_id() const noexcept override
+	{
+		return type_registry::id_of<value_type>();
+	}
+
+	special_operation_holder_if* get_special_operations( void ) const noexcept override
+	{
+		return special_operation_holder<value_carrier, ConstrainAndOperationArgs...>::get_instance();
+	}
+
+	void destroy( void ) noexcept override
 	{
-		std::unique_ptr<abst_if_t> up_ans;
 		if constexpr ( is_possible_sso ) {
-			*pp_k = new ( p_buff ) value_carrier( std::move( *this ) );
+			this->~value_carrier();
 		} else {
-			up_ans = std::make_unique<value_carrier>( std::move( *this ) );
-			*pp_k  = up_ans.get();
+			delete this;
+		}
+	}
+
+	abst_if_t* relocate_to( unsigned char* p_buff ) noexcept override
+	{
+		if constexpr ( is_possible_sso ) {
+			abst_if_t* p_ans = new ( p_buff ) value_carrier( std::move( *this ) );
+			this->~value_carrier();
+			return p_ans;
+		} else {
+			return this;
 		}
-		return up_ans;
 	}
 
-	std::unique_ptr<abst_if_t> move_my_value_to_other( abst_if_t& other, abst_if_t** pp_k, unsigned char* p_buff ) override
+	abst_if_t* mk_clone_by_move_construction( unsigned char* p_buff ) override
 	{
-		value_carrier& ref_other = dynamic_cast<value_carrier&>( other );
+		if constexpr ( is_possible_sso ) {
+			return new ( p_buff ) value_carrier( std::move( *this ) );
+		} else {
+			return new value_carrier( std::move( *this ) );
+		}
+	}
+
+	abst_if_t* move_my_value_to_other( abst_if_t& other, unsigned char* p_buff ) override
+	{
+		value_carrier& ref_other = static_cast<value_carrier&>( other );   // caller has already checked that other is same carrier type by is_same_carrier_type()
 		if constexpr ( std::is_move_assignable<value_carrier>::value ) {
 			ref_other = std::move( *this );
 
-			return nullptr;
+			return &ref_other;
 		} else {
-			( *pp_k )->~abst_if_t();   // TODO: ソース変更に対して不安定になりやすい、危険なコード
-			return mk_clone_by_move_construction( pp_k, p_buff );
+			if constexpr ( is_possible_sso ) {
+				// other is in p_buff. the new value carrier is constructed out of p_buff at first to keep other if the construction throws.
+				value_carrier tmp( std::move( *this ) );
+				ref_other.destroy();
+				return new ( p_buff ) value_carrier( std::move( tmp ) );
+			} else {
+				abst_if_t* p_ans = mk_clone_by_move_construction( p_buff );
+				ref_other.destroy();
+				return p_ans;
+			}
 		}
 	}
 
@@ -530,11 +1021,12 @@ private:
 };
 
 template <typename T, template <class> class... ConstrainAndOperationArgs>
-struct value_carrier<T, false, false, ConstrainAndOperationArgs...> : public value_carrier_if<false, false>, public ConstrainAndOperationArgs<value_carrier<T, false, false, ConstrainAndOperationArgs...>>... {
+struct value_carrier<T, false, false, ConstrainAndOperationArgs...> : public value_carrier_if<false, false>, public carrier_instrumentation_probe<value_carrier<T, false, false, ConstrainAndOperationArgs...>, true>, public heap_carrier_allocation<heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value>, public carrier_special_operation_base_t<ConstrainAndOperationArgs, value_carrier<T, false, false, ConstrainAndOperationArgs...>>... {
 	using abst_if_t  = typename value_carrier_if<false, false>::abst_if_t;
 	using value_type = T;
 
-	static constexpr bool is_possible_sso = ( sizeof( value_carrier ) < yan::impl::sso_buff_size ) &&
+	static constexpr bool is_possible_sso = ( sizeof( value_carrier ) <= inline_buffer_size_of<ConstrainAndOperationArgs...>::value ) &&
+	                                        ( alignof( value_carrier ) <= yan::impl::sso_buff_alignment ) &&
 	                                        std::is_nothrow_move_constructible<value_carrier>::value;
 
 	~value_carrier()                                 = default;
@@ -565,6 +1057,25 @@ struct value_carrier<T, false, false, ConstrainAndOperationArgs...> : public val
 		return typeid( value_type );
 	}
 
+	uint64_t get_stable_type_id() const noexcept override
+	{
+		return type_registry::id_of<value_type>();
+	}
+
+	special_operation_holder_if* get_special_operations( void ) const noexcept override
+	{
+		return special_operation_holder<value_carrier, ConstrainAndOperationArgs...>::get_instance();
+	}
+
+	void destroy( void ) noexcept override
+	{
+		if constexpr ( is_possible_sso ) {
+			this->~value_carrier();
+		} else {
+			delete this;
+		}
+	}
+
 private:
 	value_type value_;
 };
@@ -579,35 +1090,39 @@ private:
  * @note
  * It is implemented based on the following concepts:
  * member variable p_cur_carrier_ is always valid (= non nullptr).
+ * p_cur_carrier_ points to buff_ or to the heap. The value carrier itself knows where it is, and destroy()/relocate_to() of it handle the difference.
  */
 template <template <class> class... ConstrainAndOperationArgs>
 class constrained_any : public ConstrainAndOperationArgs<constrained_any<ConstrainAndOperationArgs...>>... {
 	static constexpr bool RequiresCopy = impl::do_any_constraints_require_copy_constructible<ConstrainAndOperationArgs...>::value;
 	static constexpr bool RequiresMove = impl::do_any_constraints_require_move_constructible<ConstrainAndOperationArgs...>::value;
 
+	static constexpr size_t inline_buffer_size = impl::inline_buffer_size_of<ConstrainAndOperationArgs...>::value;
+
+	// the value carrier of arena bound constrained_any in the heap is taken over by the move instead of allocated again, because it should stay in its any_arena.
+	static constexpr bool TakesOverCarrierAtMove = impl::heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value == impl::heap_carrier_allocator_kind::arena;
+
 public:
 	~constrained_any()
 	{
-		destruct_value_carrier();
+		p_cur_carrier_->destroy();
 	}
 
 	constrained_any()
-	  : p_cur_carrier_( nullptr )
-	  , up_carrier_( construct_value_carrier_info<void>( &p_cur_carrier_, buff_ ) )
+	  : p_cur_carrier_( construct_value_carrier_info<void>( buff_ ) )
 	{
 	}
 
 	constrained_any( const constrained_any& src )
 		requires RequiresCopy
-	  : p_cur_carrier_( nullptr )
-	  , up_carrier_( src.p_cur_carrier_->mk_clone_by_copy_construction( &p_cur_carrier_, buff_ ) )
+	  : p_cur_carrier_( src.p_cur_carrier_->mk_clone_by_copy_construction( buff_ ) )
 	{
 	}
 
-	constrained_any( constrained_any&& src )
+	// noexcept of arena bound constrained_any lets std::vector move it at the growth instead of the copy that needs the active any_arena.
+	constrained_any( constrained_any&& src ) noexcept( TakesOverCarrierAtMove )
 		requires RequiresCopy || RequiresMove
-	  : p_cur_carrier_( nullptr )
-	  , up_carrier_( src.p_cur_carrier_->mk_clone_by_move_construction( &p_cur_carrier_, buff_ ) )
+	  : p_cur_carrier_( mk_carrier_by_move( src, buff_ ) )
 	{
 	}
 
@@ -616,11 +1131,13 @@ public:
 	{
 		if ( this == &rhs ) return *this;
 
-		if ( this->type() == rhs.type() ) {
-			up_carrier_ = rhs.p_cur_carrier_->copy_my_value_to_other( *p_cur_carrier_, &p_cur_carrier_, buff_ );
+		if ( impl::is_same_carrier_type( *p_cur_carrier_, *rhs.p_cur_carrier_ ) ) {
+			impl::instrumentation_count( impl::instrumentation_counter_id::same_type_assign );
+			p_cur_carrier_ = rhs.p_cur_carrier_->copy_my_value_to_other( *p_cur_carrier_, buff_ );
 			return *this;
 		}
 
+		impl::instrumentation_count( impl::instrumentation_counter_id::type_changing_reconstruct );
 		constrained_any( rhs ).swap( *this );
 
 		return *this;
@@ -631,11 +1148,13 @@ public:
 	{
 		if ( this == &rhs ) return *this;
 
-		if ( this->type() == rhs.type() ) {
-			up_carrier_ = rhs.p_cur_carrier_->move_my_value_to_other( *p_cur_carrier_, &p_cur_carrier_, buff_ );
+		if ( !TakesOverCarrierAtMove && impl::is_same_carrier_type( *p_cur_carrier_, *rhs.p_cur_carrier_ ) ) {
+			impl::instrumentation_count( impl::instrumentation_counter_id::same_type_assign );
+			p_cur_carrier_ = rhs.p_cur_carrier_->move_my_value_to_other( *p_cur_carrier_, buff_ );
 			return *this;
 		}
 
+		impl::instrumentation_count( impl::instrumentation_counter_id::type_changing_reconstruct );
 		constrained_any( std::move( rhs ) ).swap( *this );
 
 		return *this;
@@ -646,8 +1165,7 @@ public:
 				  impl::is_acceptable_value_type<VT, ConstrainAndOperationArgs...>::value &&
 				  std::is_constructible<VT, Args...>::value>::type* = nullptr>
 	explicit constrained_any( std::in_place_type_t<T>, Args&&... args )
-	  : p_cur_carrier_( nullptr )
-	  , up_carrier_( construct_value_carrier_info<VT>( &p_cur_carrier_, buff_, std::forward<Args>( args )... ) )
+	  : p_cur_carrier_( construct_value_carrier_info<VT>( buff_, std::forward<Args>( args )... ) )
 	{
 	}
 
@@ -666,44 +1184,12 @@ public:
 	{
 		if ( this == &src ) return;
 
-		if ( ( up_carrier_ != nullptr ) && ( src.up_carrier_ != nullptr ) ) {
-			up_carrier_.swap( src.up_carrier_ );
-			std::swap( p_cur_carrier_, src.p_cur_carrier_ );
-		} else if ( ( up_carrier_ == nullptr ) && ( src.up_carrier_ != nullptr ) ) {
-			std::unique_ptr<value_carrier_keeper_t> up_keeper = std::move( src.up_carrier_ );
-
-			src.up_carrier_ = p_cur_carrier_->mk_clone_by_move_construction( &src.p_cur_carrier_, src.buff_ );
-
-			destruct_value_carrier();
-			up_carrier_    = std::move( up_keeper );
-			p_cur_carrier_ = up_carrier_.get();
-		} else if ( ( up_carrier_ != nullptr ) && ( src.up_carrier_ == nullptr ) ) {
-			std::unique_ptr<value_carrier_keeper_t> up_keeper = std::move( up_carrier_ );
-
-			up_carrier_ = src.p_cur_carrier_->mk_clone_by_move_construction( &p_cur_carrier_, buff_ );
-
-			src.destruct_value_carrier();
-			src.up_carrier_    = std::move( up_keeper );
-			src.p_cur_carrier_ = src.up_carrier_.get();
-		} else {   // ( up_carrier_ == nullptr ) && ( src.up_carrier_ == nullptr )
-			unsigned char                           backup_buff_[impl::sso_buff_size];
-			value_carrier_keeper_t*                 p_backup_cur_carrier_;
-			std::unique_ptr<value_carrier_keeper_t> up_backup_keeper;
-
-			up_backup_keeper = p_cur_carrier_->mk_clone_by_move_construction( &p_backup_cur_carrier_, backup_buff_ );
-			destruct_value_carrier();
-
-			up_carrier_ = src.p_cur_carrier_->mk_clone_by_move_construction( &p_cur_carrier_, buff_ );
-			src.destruct_value_carrier();
-
-			src.up_carrier_ = p_backup_cur_carrier_->mk_clone_by_move_construction( &src.p_cur_carrier_, src.buff_ );
+		// heap value carrier is relocated by the pointer. inline value carrier is relocated by the move construction.
+		alignas( impl::sso_buff_alignment ) unsigned char tmp_buff[inline_buffer_size];
+		value_carrier_keeper_t*                           p_tmp_carrier = p_cur_carrier_->relocate_to( tmp_buff );
 
-			if ( up_backup_keeper == nullptr ) {
-				p_backup_cur_carrier_->~value_carrier_keeper_t();
-			} else {
-				up_backup_keeper.reset();
-			}
-		}
+		p_cur_carrier_     = src.p_cur_carrier_->relocate_to( buff_ );
+		src.p_cur_carrier_ = p_tmp_carrier->relocate_to( src.buff_ );
 	}
 
 	void reset() noexcept
@@ -742,9 +1228,10 @@ public:
 				  impl::is_acceptable_value_type<VT, ConstrainAndOperationArgs...>::value>::type* = nullptr>
 	constrained_any& operator=( T&& rhs )
 	{
-		if ( this->type() == typeid( VT ) ) {
-			using carrier_t    = impl::value_carrier<VT, RequiresCopy, RequiresMove, ConstrainAndOperationArgs...>;
-			carrier_t& ref_src = dynamic_cast<carrier_t&>( *( p_cur_carrier_ ) );   // TODO: should be static_cast
+		using carrier_t = impl::value_carrier<VT, RequiresCopy, RequiresMove, ConstrainAndOperationArgs...>;
+		if ( typeid( *p_cur_carrier_ ) == typeid( carrier_t ) ) {
+			carrier_t& ref_src = static_cast<carrier_t&>( *p_cur_carrier_ );
+			impl::instrumentation_count( impl::instrumentation_counter_id::same_type_assign );
 			ref_src.ref()      = std::forward<T>( rhs );
 			return *this;
 		}
@@ -764,15 +1251,33 @@ public:
 		return p_cur_carrier_->get_type_info();
 	}
 
+	/**
+	 * @brief stable type id of the value type that is registered to type_registry
+	 *
+	 * @return stable type id. If no value or the value type is not registered, return 0.
+	 */
+	uint64_t stable_type_id() const noexcept
+	{
+		return p_cur_carrier_->get_stable_type_id();
+	}
+
 	template <typename SpecializedOperatorIF>
 	SpecializedOperatorIF* get_special_operation_if() noexcept
 	{
-		return dynamic_cast<SpecializedOperatorIF*>( p_cur_carrier_ );
+		return impl::find_special_operation_if<SpecializedOperatorIF>( p_cur_carrier_ );
 	}
 	template <typename SpecializedOperatorIF>
 	const SpecializedOperatorIF* get_special_operation_if() const noexcept
 	{
-		return dynamic_cast<const SpecializedOperatorIF*>( p_cur_carrier_ );
+		return impl::find_special_operation_if<SpecializedOperatorIF>( static_cast<const impl::value_carrier_if_common*>( p_cur_carrier_ ) );
+	}
+
+	/**
+	 * @brief get the value carrier to pass it to the dispatcher of shared special operation
+	 */
+	const impl::value_carrier_if_common& get_value_carrier( void ) const noexcept
+	{
+		return *( p_cur_carrier_ );
 	}
 
 private:
@@ -782,45 +1287,55 @@ private:
 	using value_carrier_keeper_t = impl::value_carrier_if<RequiresCopy, RequiresMove>;
 
 	template <typename T>
-	static constexpr bool is_possible_sso = ( sizeof( value_carrier_t<T> ) < yan::impl::sso_buff_size ) &&
-	                                        std::is_nothrow_move_constructible<value_carrier_t<T>>::value;
+	static constexpr bool is_possible_sso = value_carrier_t<T>::is_possible_sso;
 
-	void destruct_value_carrier( void )
+	template <typename T, class... Args, typename std::enable_if<!is_possible_sso<T>>::type* = nullptr>
+	static value_carrier_keeper_t* construct_value_carrier_info( unsigned char* p_buff, Args&&... args )
 	{
-		if ( up_carrier_ == nullptr ) {
-			p_cur_carrier_->~value_carrier_keeper_t();
-		} else {
-			up_carrier_.reset();
-		}
+		return new value_carrier_t<T>( std::in_place_type_t<T> {}, std::forward<Args>( args )... );
 	}
 
-	template <typename T, class... Args, typename std::enable_if<!is_possible_sso<T>>::type* = nullptr>
-	static auto construct_value_carrier_info( value_carrier_keeper_t** pp_k, unsigned char* p_buff, Args&&... args ) -> std::unique_ptr<value_carrier_t<T>>
+	template <typename T, class... Args, typename std::enable_if<is_possible_sso<T>>::type* = nullptr>
+	static value_carrier_keeper_t* construct_value_carrier_info( unsigned char* p_buff, Args&&... args )
 	{
-		auto up_ans = std::make_unique<value_carrier_t<T>>( std::in_place_type_t<T> {}, std::forward<Args>( args )... );
-		*pp_k       = up_ans.get();
-		return up_ans;
+		return new ( p_buff ) value_carrier_t<T>( std::in_place_type_t<T> {}, std::forward<Args>( args )... );
 	}
 
-	template <typename T, class... Args, typename std::enable_if<is_possible_sso<T>>::type* = nullptr>
-	static auto construct_value_carrier_info( value_carrier_keeper_t** pp_k, unsigned char* p_buff, Args&&... args ) -> std::unique_ptr<value_carrier_t<T>>
+	// If TakesOverCarrierAtMove, the value carrier of src is relocated to p_buff(the value carrier in the heap is returned as it is), and src gets the empty value carrier in its inline buffer.
+	static value_carrier_keeper_t* mk_carrier_by_move( constrained_any& src, unsigned char* p_buff ) noexcept( TakesOverCarrierAtMove )
 	{
-		*pp_k = new ( p_buff ) value_carrier_t<T>( std::in_place_type_t<T> {}, std::forward<Args>( args )... );
-		return nullptr;
+		if constexpr ( TakesOverCarrierAtMove ) {
+			static_assert( is_possible_sso<void>, "the empty value carrier should be in the inline buffer to take over the value carrier without allocation" );
+			value_carrier_keeper_t* p_ans = src.p_cur_carrier_->relocate_to( p_buff );
+			src.p_cur_carrier_            = construct_value_carrier_info<void>( src.buff_ );
+			return p_ans;
+		} else {
+			return src.p_cur_carrier_->mk_clone_by_move_construction( p_buff );
+		}
+	}
+
+	// emplace() and reset() reconstruct the value carrier even if the type is not changed. Therefore, the type is checked only for the counter.
+	template <typename T>
+	void count_type_changing_reconstruct( void ) const noexcept
+	{
+		if constexpr ( is_instrumentation_enabled ) {
+			if ( typeid( *p_cur_carrier_ ) != typeid( value_carrier_t<T> ) ) {
+				impl::instrumentation_count( impl::instrumentation_counter_id::type_changing_reconstruct );
+			}
+		}
 	}
 
 	template <typename T, class... Args, typename std::enable_if<!is_possible_sso<T>>::type* = nullptr>
 	auto reconstruct_value_carrier_info( Args&&... args )
 	{
+		count_type_changing_reconstruct<T>();
 		auto up_vc = std::make_unique<value_carrier_t<T>>( std::in_place_type_t<T> {}, std::forward<Args>( args )... );
-		destruct_value_carrier();
+		p_cur_carrier_->destroy();
 		if constexpr ( std::is_void<T>::value ) {
-			p_cur_carrier_ = up_vc.get();
-			up_carrier_    = std::move( up_vc );
+			p_cur_carrier_ = up_vc.release();
 		} else {
 			std::decay_t<T>* p_ans = &( up_vc->ref() );
-			p_cur_carrier_         = up_vc.get();
-			up_carrier_            = std::move( up_vc );
+			p_cur_carrier_         = up_vc.release();
 			return p_ans;
 		}
 	}
@@ -828,8 +1343,9 @@ private:
 	template <typename T, class... Args, typename std::enable_if<is_possible_sso<T>>::type* = nullptr>
 	auto reconstruct_value_carrier_info( Args&&... args )
 	{
+		count_type_changing_reconstruct<T>();
 		value_carrier_t<T> tmp( std::in_place_type_t<T> {}, std::forward<Args>( args )... );
-		destruct_value_carrier();
+		p_cur_carrier_->destroy();
 		auto p_vc      = new ( buff_ ) value_carrier_t<T>( std::move( tmp ) );
 		p_cur_carrier_ = p_vc;
 		if constexpr ( std::is_void<T>::value ) {
@@ -862,9 +1378,8 @@ private:
 		return static_cast<value_carrier_t<T>*>( p_cur_carrier_ );
 	}
 
-	unsigned char                           buff_[impl::sso_buff_size];
-	value_carrier_keeper_t*                 p_cur_carrier_;
-	std::unique_ptr<value_carrier_keeper_t> up_carrier_;
+	alignas( impl::sso_buff_alignment ) unsigned char buff_[inline_buffer_size];
+	value_carrier_keeper_t*                           p_cur_carrier_;
 
 	template <class T, template <class> class... USpecializedOperator>
 	friend T constrained_any_cast( const constrained_any<USpecializedOperator...>& operand );
@@ -918,7 +1433,7 @@ struct value_carrier;
 
 // specialization for void
 template <bool SupportUseMove, template <class> class... ConstrainAndOperationArgs>
-struct value_carrier<void, true, SupportUseMove, ConstrainAndOperationArgs...> : public value_carrier_if<true, SupportUseMove> {
+struct value_carrier<void, true, SupportUseMove, ConstrainAndOperationArgs...> : public value_carrier_if<true, SupportUseMove>, public carrier_instrumentation_probe<value_carrier<void, true, SupportUseMove, ConstrainAndOperationArgs...>, false>, public heap_carrier_allocation<empty_heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value> {
 	using abst_if_t  = typename value_carrier_if<true, SupportUseMove>::abst_if_t;
 	using value_type = void;
 
@@ -961,7 +1476,7 @@ struct value_carrier<void, true, SupportUseMove, ConstrainAndOperationArgs...> :
 
 // specialization for void
 template <template <class> class... ConstrainAndOperationArgs>
-struct value_carrier<void, false, true, ConstrainAndOperationArgs...> : public value_carrier_if<false, true> {
+struct value_carrier<void, false, true, ConstrainAndOperationArgs...> : public value_carrier_if<false, true>, public carrier_instrumentation_probe<value_carrier<void, false, true, ConstrainAndOperationArgs...>, false>, public heap_carrier_allocation<empty_heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value> {
 	using abst_if_t  = typename value_carrier_if<false, true>::abst_if_t;
 	using value_type = void;
 
@@ -998,7 +1513,7 @@ struct value_carrier<void, false, true, ConstrainAndOperationArgs...> : public v
 
 // specialization for void
 template <template <class> class... ConstrainAndOperationArgs>
-struct value_carrier<void, false, false, ConstrainAndOperationArgs...> : public value_carrier_if<false, false> {
+struct value_carrier<void, false, false, ConstrainAndOperationArgs...> : public value_carrier_if<false, false>, public carrier_instrumentation_probe<value_carrier<void, false, false, ConstrainAndOperationArgs...>, false>, public heap_carrier_allocation<empty_heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value> {
 	using abst_if_t  = typename value_carrier_if<false, false>::abst_if_t;
 	using value_type = void;
 
@@ -1024,7 +1539,7 @@ struct value_carrier<void, false, false, ConstrainAndOperationArgs...> : public
 };
 
 template <typename T, bool SupportUseMove, template <class> class... ConstrainAndOperationArgs>
-struct value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...> : public value_carrier_if<true, SupportUseMove>, public ConstrainAndOperationArgs<value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...>>... {
+struct value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...> : public value_carrier_if<true, SupportUseMove>, public carrier_instrumentation_probe<value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...>, false>, public heap_carrier_allocation<heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value>, public carrier_special_operation_base_t<ConstrainAndOperationArgs, value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...>>... {
 	using abst_if_t  = typename value_carrier_if<true, SupportUseMove>::abst_if_t;
 	using value_type = T;
 
@@ -1056,6 +1571,16 @@ struct value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...> : pu
 		return typeid( value_type );
 	}
 
+	uint64_t get_stable_type_id() const noexcept override
+	{
+		return type_registry::id_of<value_type>();
+	}
+
+	special_operation_holder_if* get_special_operations( void ) const noexcept override
+	{
+		return special_operation_holder<value_carrier, ConstrainAndOperationArgs...>::get_instance();
+	}
+
 	std::unique_ptr<abst_if_t> mk_clone_by_copy_construction( void ) const override
 	{
 		return std::make_unique<value_carrier>( *this );
@@ -1068,7 +1593,7 @@ struct value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...> : pu
 
 	std::unique_ptr<abst_if_t> copy_my_value_to_other( abst_if_t& other ) const override
 	{
-		value_carrier& ref_other = dynamic_cast<value_carrier&>( other );
+		value_carrier& ref_other = static_cast<value_carrier&>( other );   // caller has already checked that other is same carrier type by is_same_carrier_type()
 		if constexpr ( std::is_copy_assignable<value_carrier>::value ) {
 			ref_other = *this;
 
@@ -1079,7 +1604,7 @@ struct value_carrier<T, true, SupportUseMove, ConstrainAndOperationArgs...> : pu
 	}
 	std::unique_ptr<abst_if_t> move_my_value_to_other( abst_if_t& other ) override
 	{
-		value_carrier& ref_other = dynamic_cast<value_carrier&>( other );
+		value_carrier& ref_other = static_cast<value_carrier&>( other );   // caller has already checked that other is same carrier type by is_same_carrier_type()
 		if constexpr ( std::is_move_assignable<value_carrier>::value ) {
 			ref_other = std::move( *this );
 
@@ -1094,7 +1619,7 @@ private:
 };
 
 template <typename T, template <class> class... ConstrainAndOperationArgs>
-struct value_carrier<T, false, true, ConstrainAndOperationArgs...> : public value_carrier_if<false, true>, public ConstrainAndOperationArgs<value_carrier<T, false, true, ConstrainAndOperationArgs...>>... {
+struct value_carrier<T, false, true, ConstrainAndOperationArgs...> : public value_carrier_if<false, true>, public carrier_instrumentation_probe<value_carrier<T, false, true, ConstrainAndOperationArgs...>, false>, public heap_carrier_allocation<heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value>, public carrier_special_operation_base_t<ConstrainAndOperationArgs, value_carrier<T, false, true, ConstrainAndOperationArgs...>>... {
 	using abst_if_t  = typename value_carrier_if<false, true>::abst_if_t;
 	using value_type = T;
 
@@ -1129,6 +1654,16 @@ struct value_carrier<T, false, true, ConstrainAndOperationArgs...> : public valu
 		return typeid( value_type );
 	}
 
+	uint64_t get_stable_type_id() const noexcept override
+	{
+		return type_registry::id_of<value_type>();
+	}
+
+	special_operation_holder_if* get_special_operations( void ) const noexcept override
+	{
+		return special_operation_holder<value_carrier, ConstrainAndOperationArgs...>::get_instance();
+	}
+
 	std::unique_ptr<abst_if_t> mk_clone_by_move_construction( void ) override
 	{
 		return std::make_unique<value_carrier>( std::move( *this ) );
@@ -1136,7 +1671,7 @@ struct value_carrier<T, false, true, ConstrainAndOperationArgs...> : public valu
 
 	std::unique_ptr<abst_if_t> move_my_value_to_other( abst_if_t& other ) override
 	{
-		value_carrier& ref_other = dynamic_cast<value_carrier&>( other );
+		value_carrier& ref_other = static_cast<value_carrier&>( other );   // caller has already checked that other is same carrier type by is_same_carrier_type()
 		if constexpr ( std::is_move_assignable<value_carrier>::value ) {
 			ref_other = std::move( *this );
 
@@ -1151,7 +1686,7 @@ private:
 };
 
 template <typename T, template <class> class... ConstrainAndOperationArgs>
-struct value_carrier<T, false, false, ConstrainAndOperationArgs...> : public value_carrier_if<false, false>, public ConstrainAndOperationArgs<value_carrier<T, false, false, ConstrainAndOperationArgs...>>... {
+struct value_carrier<T, false, false, ConstrainAndOperationArgs...> : public value_carrier_if<false, false>, public carrier_instrumentation_probe<value_carrier<T, false, false, ConstrainAndOperationArgs...>, false>, public heap_carrier_allocation<heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value>, public carrier_special_operation_base_t<ConstrainAndOperationArgs, value_carrier<T, false, false, ConstrainAndOperationArgs...>>... {
 	using abst_if_t  = typename value_carrier_if<false, false>::abst_if_t;
 	using value_type = T;
 
@@ -1186,14 +1721,33 @@ struct value_carrier<T, false, false, ConstrainAndOperationArgs...> : public val
 		return typeid( value_type );
 	}
 
+	uint64_t get_stable_type_id() const noexcept override
+	{
+		return type_registry::id_of<value_type>();
+	}
+
+	special_operation_holder_if* get_special_operations( void ) const noexcept override
+	{
+		return special_operation_holder<value_carrier, ConstrainAndOperationArgs...>::get_instance();
+	}
+
 private:
 	value_type value_;
 };
 
-template <bool RequiresCopy, bool RequiresMove>
+/**
+ * @brief base of the implementation of constrained_any
+ *
+ * @tparam EmptyCarrierMaker void, or the class that has static function make() to make the empty value carrier.
+ * If not void, the move construction takes over the value carrier of the source, and the source gets the empty value carrier.
+ * This is for arena bound constrained_any, whose value carrier in the heap should not be allocated again out of its any_arena.
+ */
+template <bool RequiresCopy, bool RequiresMove, typename EmptyCarrierMaker>
 struct constrained_any_impl_base {
 	using value_carrier_keeper_t = impl::value_carrier_if<RequiresCopy, RequiresMove>;
 
+	static constexpr bool takes_over_carrier_at_move = !std::is_void<EmptyCarrierMaker>::value;
+
 	virtual ~constrained_any_impl_base() = default;
 
 	constrained_any_impl_base( std::unique_ptr<value_carrier_keeper_t>&& up_carrier )
@@ -1212,15 +1766,27 @@ struct constrained_any_impl_base {
 		up_carrier_.swap( src.up_carrier_ );
 	}
 
+	// like reset(), the allocation of the empty value carrier is regarded as no failure. Then, std::vector moves arena bound constrained_any at the growth.
+	static std::unique_ptr<value_carrier_keeper_t> mk_carrier_by_move( constrained_any_impl_base& src ) noexcept( takes_over_carrier_at_move )
+	{
+		if constexpr ( takes_over_carrier_at_move ) {
+			std::unique_ptr<value_carrier_keeper_t> up_ans = EmptyCarrierMaker::make();
+			up_ans.swap( src.up_carrier_ );
+			return up_ans;
+		} else {
+			return src.up_carrier_->mk_clone_by_move_construction();
+		}
+	}
+
 	std::unique_ptr<value_carrier_keeper_t> up_carrier_;
 };
 
-template <bool RequiresCopy, bool RequiresMove>
+template <bool RequiresCopy, bool RequiresMove, typename EmptyCarrierMaker>
 struct constrained_any_impl_copy_move_layer;
 
-template <bool RequiresMove>
-struct constrained_any_impl_copy_move_layer<true, RequiresMove> : public constrained_any_impl_base<true, RequiresMove> {
-	using base_t                 = constrained_any_impl_base<true, RequiresMove>;
+template <bool RequiresMove, typename EmptyCarrierMaker>
+struct constrained_any_impl_copy_move_layer<true, RequiresMove, EmptyCarrierMaker> : public constrained_any_impl_base<true, RequiresMove, EmptyCarrierMaker> {
+	using base_t                 = constrained_any_impl_base<true, RequiresMove, EmptyCarrierMaker>;
 	using value_carrier_keeper_t = impl::value_carrier_if<true, RequiresMove>;
 
 	~constrained_any_impl_copy_move_layer() = default;
@@ -1237,7 +1803,8 @@ struct constrained_any_impl_copy_move_layer<true, RequiresMove> : public constra
 	{
 		if ( this == &rhs ) return *this;
 
-		if ( base_t::up_carrier_->get_type_info() == rhs.up_carrier_->get_type_info() ) {
+		if ( is_same_carrier_type( *base_t::up_carrier_, *rhs.up_carrier_ ) ) {
+			instrumentation_count( instrumentation_counter_id::same_type_assign );
 			auto up_copy = rhs.up_carrier_->copy_my_value_to_other( *base_t::up_carrier_ );
 			if ( up_copy != nullptr ) {
 				base_t::up_carrier_ = std::move( up_copy );
@@ -1245,20 +1812,23 @@ struct constrained_any_impl_copy_move_layer<true, RequiresMove> : public constra
 			return *this;
 		}
 
+		instrumentation_count( instrumentation_counter_id::type_changing_reconstruct );
 		constrained_any_impl_copy_move_layer( rhs ).swap( *this );
 
 		return *this;
 	}
 
-	constrained_any_impl_copy_move_layer( constrained_any_impl_copy_move_layer&& src )
-	  : base_t( src.up_carrier_->mk_clone_by_move_construction() )
+	constrained_any_impl_copy_move_layer( constrained_any_impl_copy_move_layer&& src ) noexcept( base_t::takes_over_carrier_at_move )
+	  : base_t( base_t::mk_carrier_by_move( src ) )
 	{
 	}
 	constrained_any_impl_copy_move_layer& operator=( constrained_any_impl_copy_move_layer&& rhs ) noexcept
 	{
 		if ( this == &rhs ) return *this;
 
-		if ( base_t::up_carrier_->get_type_info() == rhs.up_carrier_->get_type_info() ) {
+		// the value carrier of arena bound constrained_any is taken over by the move construction below.
+		if ( !base_t::takes_over_carrier_at_move && is_same_carrier_type( *base_t::up_carrier_, *rhs.up_carrier_ ) ) {
+			instrumentation_count( instrumentation_counter_id::same_type_assign );
 			auto up_move = rhs.up_carrier_->move_my_value_to_other( *base_t::up_carrier_ );
 			if ( up_move != nullptr ) {
 				base_t::up_carrier_ = std::move( up_move );
@@ -1266,15 +1836,16 @@ struct constrained_any_impl_copy_move_layer<true, RequiresMove> : public constra
 			return *this;
 		}
 
+		instrumentation_count( instrumentation_counter_id::type_changing_reconstruct );
 		constrained_any_impl_copy_move_layer( std::move( rhs ) ).swap( *this );
 
 		return *this;
 	}
 };
 
-template <>
-struct constrained_any_impl_copy_move_layer<false, true> : public constrained_any_impl_base<false, true> {
-	using base_t                 = constrained_any_impl_base<false, true>;
+template <typename EmptyCarrierMaker>
+struct constrained_any_impl_copy_move_layer<false, true, EmptyCarrierMaker> : public constrained_any_impl_base<false, true, EmptyCarrierMaker> {
+	using base_t                 = constrained_any_impl_base<false, true, EmptyCarrierMaker>;
 	using value_carrier_keeper_t = impl::value_carrier_if<false, true>;
 
 	~constrained_any_impl_copy_move_layer() = default;
@@ -1284,15 +1855,17 @@ struct constrained_any_impl_copy_move_layer<false, true> : public constrained_an
 	}
 	constrained_any_impl_copy_move_layer( const constrained_any_impl_copy_move_layer& src )            = delete;
 	constrained_any_impl_copy_move_layer& operator=( const constrained_any_impl_copy_move_layer& rhs ) = delete;
-	constrained_any_impl_copy_move_layer( constrained_any_impl_copy_move_layer&& src )
-	  : base_t( src.up_carrier_->mk_clone_by_move_construction() )
+	constrained_any_impl_copy_move_layer( constrained_any_impl_copy_move_layer&& src ) noexcept( base_t::takes_over_carrier_at_move )
+	  : base_t( base_t::mk_carrier_by_move( src ) )
 	{
 	}
 	constrained_any_impl_copy_move_layer& operator=( constrained_any_impl_copy_move_layer&& rhs ) noexcept
 	{
 		if ( this == &rhs ) return *this;
 
-		if ( base_t::up_carrier_->get_type_info() == rhs.up_carrier_->get_type_info() ) {
+		// the value carrier of arena bound constrained_any is taken over by the move construction below.
+		if ( !base_t::takes_over_carrier_at_move && is_same_carrier_type( *base_t::up_carrier_, *rhs.up_carrier_ ) ) {
+			instrumentation_count( instrumentation_counter_id::same_type_assign );
 			auto up_move = rhs.up_carrier_->move_my_value_to_other( *base_t::up_carrier_ );
 			if ( up_move != nullptr ) {
 				base_t::up_carrier_ = std::move( up_move );
@@ -1300,14 +1873,15 @@ struct constrained_any_impl_copy_move_layer<false, true> : public constrained_an
 			return *this;
 		}
 
+		instrumentation_count( instrumentation_counter_id::type_changing_reconstruct );
 		constrained_any_impl_copy_move_layer( std::move( rhs ) ).swap( *this );
 		return *this;
 	}
 };
 
-template <>
-struct constrained_any_impl_copy_move_layer<false, false> : public constrained_any_impl_base<false, false> {
-	using base_t                 = constrained_any_impl_base<false, false>;
+template <typename EmptyCarrierMaker>
+struct constrained_any_impl_copy_move_layer<false, false, EmptyCarrierMaker> : public constrained_any_impl_base<false, false, EmptyCarrierMaker> {
+	using base_t                 = constrained_any_impl_base<false, false, EmptyCarrierMaker>;
 	using value_carrier_keeper_t = impl::value_carrier_if<false, false>;
 
 	~constrained_any_impl_copy_move_layer() = default;
@@ -1321,9 +1895,9 @@ struct constrained_any_impl_copy_move_layer<false, false> : public constrained_a
 	constrained_any_impl_copy_move_layer& operator=( constrained_any_impl_copy_move_layer&& rhs ) noexcept = delete;
 };
 
-template <bool RequiresCopy, bool RequiresMove>
-struct constrained_any_impl : public constrained_any_impl_copy_move_layer<RequiresCopy, RequiresMove> {
-	using base_t                 = constrained_any_impl_copy_move_layer<RequiresCopy, RequiresMove>;
+template <bool RequiresCopy, bool RequiresMove, typename EmptyCarrierMaker>
+struct constrained_any_impl : public constrained_any_impl_copy_move_layer<RequiresCopy, RequiresMove, EmptyCarrierMaker> {
+	using base_t                 = constrained_any_impl_copy_move_layer<RequiresCopy, RequiresMove, EmptyCarrierMaker>;
 	using value_carrier_keeper_t = impl::value_carrier_if<RequiresCopy, RequiresMove>;
 
 	~constrained_any_impl() = default;
@@ -1411,9 +1985,10 @@ public:
 				  impl::is_acceptable_value_type<VT, ConstrainAndOperationArgs...>::value>::type* = nullptr>
 	constrained_any& operator=( T&& rhs )
 	{
-		if ( type() == typeid( VT ) ) {
-			using carrier_t    = impl::value_carrier<VT, RequiresCopy, RequiresMove, ConstrainAndOperationArgs...>;
-			carrier_t& ref_src = dynamic_cast<carrier_t&>( *( impl_.up_carrier_.get() ) );   // TODO: should be static_cast
+		using carrier_t = impl::value_carrier<VT, RequiresCopy, RequiresMove, ConstrainAndOperationArgs...>;
+		if ( typeid( *impl_.up_carrier_ ) == typeid( carrier_t ) ) {
+			carrier_t& ref_src = static_cast<carrier_t&>( *impl_.up_carrier_ );
+			impl::instrumentation_count( impl::instrumentation_counter_id::same_type_assign );
 			ref_src.ref()      = std::forward<T>( rhs );
 			return *this;
 		}
@@ -1428,6 +2003,16 @@ public:
 		return impl_.up_carrier_->get_type_info();
 	}
 
+	/**
+	 * @brief stable type id of the value type that is registered to type_registry
+	 *
+	 * @return stable type id. If no value or the value type is not registered, return 0.
+	 */
+	uint64_t stable_type_id() const noexcept
+	{
+		return impl_.up_carrier_->get_stable_type_id();
+	}
+
 	bool has_value() const noexcept
 	{
 		return ( type() != typeid( void ) );
@@ -1441,12 +2026,20 @@ public:
 	template <typename SpecializedOperatorIF>
 	SpecializedOperatorIF* get_special_operation_if() noexcept
 	{
-		return dynamic_cast<SpecializedOperatorIF*>( impl_.up_carrier_.get() );
+		return impl::find_special_operation_if<SpecializedOperatorIF>( impl_.up_carrier_.get() );
 	}
 	template <typename SpecializedOperatorIF>
 	const SpecializedOperatorIF* get_special_operation_if() const noexcept
 	{
-		return dynamic_cast<const SpecializedOperatorIF*>( impl_.up_carrier_.get() );
+		return impl::find_special_operation_if<SpecializedOperatorIF>( static_cast<const impl::value_carrier_if_common*>( impl_.up_carrier_.get() ) );
+	}
+
+	/**
+	 * @brief get the value carrier to pass it to the dispatcher of shared special operation
+	 */
+	const impl::value_carrier_if_common& get_value_carrier( void ) const noexcept
+	{
+		return *( impl_.up_carrier_.get() );
 	}
 
 private:
@@ -1456,13 +2049,25 @@ private:
 	template <typename T, class... Args>
 	static auto construct_value_carrier_info( Args&&... args ) -> std::unique_ptr<value_carrier_t<T>>
 	{
-		auto up_ans = std::make_unique<value_carrier_t<T>>( std::in_place_type_t<T> {}, std::forward<Args>( args )... );
-		return up_ans;
+		auto up_ans = std::make_unique<value_carrier_t<T>>( std::in_place_type_t<T> {}, std::forward<Args>( args )... );
+		return up_ans;
+	}
+
+	// emplace() and reset() reconstruct the value carrier even if the type is not changed. Therefore, the type is checked only for the counter.
+	template <typename T>
+	void count_type_changing_reconstruct( void ) const noexcept
+	{
+		if constexpr ( is_instrumentation_enabled ) {
+			if ( typeid( *impl_.up_carrier_ ) != typeid( value_carrier_t<T> ) ) {
+				impl::instrumentation_count( impl::instrumentation_counter_id::type_changing_reconstruct );
+			}
+		}
 	}
 
 	template <typename T, class... Args>
 	auto reconstruct_value_carrier_info( Args&&... args )
 	{
+		count_type_changing_reconstruct<T>();
 		auto up_vc = std::make_unique<value_carrier_t<T>>( std::in_place_type_t<T> {}, std::forward<Args>( args )... );
 		if constexpr ( std::is_void<T>::value ) {
 			impl_.up_carrier_ = std::move( up_vc );
@@ -1505,7 +2110,19 @@ private:
 #endif
 	}
 
-	impl::constrained_any_impl<RequiresCopy, RequiresMove> impl_;
+	/**
+	 * @brief maker of the empty value carrier for the source of the move construction of arena bound constrained_any
+	 */
+	struct empty_carrier_maker {
+		static std::unique_ptr<impl::value_carrier_if<RequiresCopy, RequiresMove>> make( void )
+		{
+			return construct_value_carrier_info<void>();
+		}
+	};
+	using empty_carrier_maker_t = typename std::conditional<impl::heap_carrier_allocator_of<ConstrainAndOperationArgs...>::value == impl::heap_carrier_allocator_kind::arena,
+	                                                        empty_carrier_maker, void>::type;
+
+	impl::constrained_any_impl<RequiresCopy, RequiresMove, empty_carrier_maker_t> impl_;
 
 	template <class T, template <class> class... USpecializedOperator>
 	friend T constrained_any_cast( const constrained_any<USpecializedOperator...>& operand );
@@ -1525,6 +2142,129 @@ private:
 
 #endif   // #if __cpp_concepts >= 201907L
 
+namespace impl {
+
+/**
+ * @brief specialized type of constrained_any that has Carrier as its value carrier
+ *
+ * If Carrier is not value carrier, it has no member type.
+ */
+template <typename Carrier>
+struct alias_of_value_carrier { };
+
+template <typename T, bool RequiresCopy, bool RequiresMove, template <class> class... ConstrainAndOperationArgs>
+struct alias_of_value_carrier<value_carrier<T, RequiresCopy, RequiresMove, ConstrainAndOperationArgs...>> {
+	using type = constrained_any<ConstrainAndOperationArgs...>;
+};
+
+}   // namespace impl
+
+/**
+ * @brief reason why a value is stored in the heap instead of the inline buffer
+ */
+enum class storage_spill_reason {
+	none,                //!< not spilled. the value is stored in the inline buffer
+	size,                //!< value carrier is larger than the inline buffer
+	alignment,           //!< alignment of value carrier is larger than the alignment of the inline buffer
+	non_noexcept_move,   //!< move constructor of value carrier is not noexcept
+	no_inline_buffer     //!< constrained_any has no inline buffer(C++17 implementation)
+};
+
+namespace impl {
+
+constexpr storage_spill_reason select_storage_spill_reason( bool spills_by_size, bool spills_by_alignment, bool spills_by_non_noexcept_move )
+{
+	if ( spills_by_size ) return storage_spill_reason::size;
+	if ( spills_by_alignment ) return storage_spill_reason::alignment;
+	if ( spills_by_non_noexcept_move ) return storage_spill_reason::non_noexcept_move;
+	return storage_spill_reason::none;
+}
+
+}   // namespace impl
+
+/**
+ * @brief primary template of storage layout report of T in Alias
+ *
+ * @tparam Alias specialized type of constrained_any
+ * @tparam T type of the value which you want to store
+ */
+template <typename Alias, typename T>
+struct storage_traits;
+
+/**
+ * @brief storage layout report of T in constrained_any<ConstrainAndOperationArgs...>
+ *
+ * @code {.cpp}
+ * using traits = yan::storage_traits<yan::keyable_any, my_key>;
+ * printf( "carrier %zu bytes, overhead %zu bytes, inline: %d\n", traits::carrier_size, traits::overhead_bytes, traits::is_inline );
+ * @endcode
+ */
+template <template <class> class... ConstrainAndOperationArgs, typename T>
+struct storage_traits<constrained_any<ConstrainAndOperationArgs...>, T> {
+	using value_type   = std::decay_t<T>;
+	using carrier_type = impl::value_carrier<value_type,
+	                                         impl::do_any_constraints_require_copy_constructible<ConstrainAndOperationArgs...>::value,
+	                                         impl::do_any_constraints_require_move_constructible<ConstrainAndOperationArgs...>::value,
+	                                         ConstrainAndOperationArgs...>;
+
+	static_assert( impl::is_acceptable_value_type<value_type, ConstrainAndOperationArgs...>::value, "T is not acceptable value type of Alias" );
+
+	static constexpr size_t value_size        = sizeof( value_type );
+	static constexpr size_t carrier_size      = sizeof( carrier_type );
+	static constexpr size_t carrier_alignment = alignof( carrier_type );
+	static constexpr size_t overhead_bytes    = carrier_size - value_size;   //!< vptr of value carrier, vptrs of not shared special operations, and padding
+
+#if __cpp_concepts >= 201907L
+	static constexpr size_t inline_buffer_size      = impl::inline_buffer_size_of<ConstrainAndOperationArgs...>::value;
+	static constexpr size_t inline_buffer_alignment = impl::sso_buff_alignment;
+
+	static constexpr bool spills_by_size              = ( carrier_size > inline_buffer_size );
+	static constexpr bool spills_by_alignment         = ( carrier_alignment > inline_buffer_alignment );
+	static constexpr bool spills_by_non_noexcept_move = !std::is_nothrow_move_constructible<carrier_type>::value;
+
+	static constexpr bool is_inline = carrier_type::is_possible_sso;
+
+	static constexpr storage_spill_reason spill_reason = impl::select_storage_spill_reason( spills_by_size, spills_by_alignment, spills_by_non_noexcept_move );
+#else
+	static constexpr size_t inline_buffer_size      = 0;
+	static constexpr size_t inline_buffer_alignment = 0;
+
+	static constexpr bool spills_by_size              = false;
+	static constexpr bool spills_by_alignment         = false;
+	static constexpr bool spills_by_non_noexcept_move = false;
+
+	static constexpr bool is_inline = false;
+
+	static constexpr storage_spill_reason spill_reason = storage_spill_reason::no_inline_buffer;
+#endif
+};
+
+/**
+ * @brief compile time guard to lock T to the inline buffer of Alias
+ *
+ * If T is stored in the heap, static_assert reports the reason of the spill.
+ * @code {.cpp}
+ * static_assert( yan::require_inline<yan::keyable_any, my_key>::value );
+ * @endcode
+ *
+ * @note
+ * C++17 implementation has no inline buffer. Therefore, this guard always fails in C++17.
+ */
+template <typename Alias, typename T>
+struct require_inline {
+	using traits_t = storage_traits<Alias, T>;
+
+	static_assert( traits_t::spill_reason != storage_spill_reason::no_inline_buffer, "constrained_any has no inline buffer in this C++ standard" );
+	static_assert( !traits_t::spills_by_size, "value carrier of T is too large for the inline buffer" );
+	static_assert( !traits_t::spills_by_alignment, "alignment of T is larger than the alignment of the inline buffer" );
+	static_assert( !traits_t::spills_by_non_noexcept_move, "move constructor of T is not noexcept" );
+
+	static constexpr bool value = traits_t::is_inline;
+};
+
+template <typename Alias, typename T>
+inline constexpr bool require_inline_v = require_inline<Alias, T>::value;
+
 /**
  * @brief helper function to create constrained_any object
  *
@@ -1556,6 +2296,116 @@ SpecializedConstraintAny make_constrained_any( Args&&... args )
 	return SpecializedConstraintAny( std::in_place_type<T>, std::forward<Args>( args )... );
 }
 
+namespace impl {
+
+struct is_iterator_impl {
+	template <typename T>
+	static auto check( T* ) -> decltype( std::declval<typename std::iterator_traits<T>::iterator_category>(), std::true_type() );
+	template <typename T>
+	static auto check( ... ) -> std::false_type;
+};
+
+template <typename T>
+struct is_iterator : public decltype( is_iterator_impl::check<T>( nullptr ) ) { };
+
+template <typename InputIt>
+using range_value_t = typename std::decay<typename std::iterator_traits<InputIt>::reference>::type;
+
+}   // namespace impl
+
+/**
+ * @brief construct SpecializedConstraintAny objects from the range of values
+ *
+ * The value type of the range is resolved at compile time. Therefore, each element is constructed by the value carrier of that type directly,
+ * without overload resolution of the converting constructor.
+ *
+ * @tparam SpecializedConstraintAny specialized constrained_any class what you want to create.
+ * @param first begin of the range of values
+ * @param last end of the range of values
+ * @param d_first begin of the destination range. e.g. std::back_inserter
+ * @return output iterator to the element past the last element constructed
+ */
+template <typename SpecializedConstraintAny, typename InputIt, typename OutputIt,
+          typename std::enable_if<is_specialized_of_constrained_any<SpecializedConstraintAny>::value && impl::is_iterator<OutputIt>::value>::type* = nullptr>
+OutputIt make_any_range( InputIt first, InputIt last, OutputIt d_first )
+{
+	using value_t = impl::range_value_t<InputIt>;
+	for ( ; first != last; ++first, ++d_first ) {
+		*d_first = SpecializedConstraintAny( std::in_place_type<value_t>, *first );
+	}
+	return d_first;
+}
+
+/**
+ * @brief append SpecializedConstraintAny objects that are constructed from the range of values to std::vector
+ *
+ * Each element is constructed in dst directly. Therefore, move construction of SpecializedConstraintAny is not required.
+ * If InputIt is forward iterator, dst reserves the capacity at once.
+ *
+ * @tparam SpecializedConstraintAny specialized constrained_any class what you want to create.
+ * @param first begin of the range of values
+ * @param last end of the range of values
+ * @param dst destination vector
+ */
+template <typename SpecializedConstraintAny, typename InputIt, typename Allocator,
+          typename std::enable_if<is_specialized_of_constrained_any<SpecializedConstraintAny>::value>::type* = nullptr>
+void make_any_range( InputIt first, InputIt last, std::vector<SpecializedConstraintAny, Allocator>& dst )
+{
+	using value_t = impl::range_value_t<InputIt>;
+	if constexpr ( std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>::value ) {
+		dst.reserve( dst.size() + static_cast<size_t>( std::distance( first, last ) ) );
+	}
+	for ( ; first != last; ++first ) {
+		dst.emplace_back( std::in_place_type<value_t>, *first );
+	}
+}
+
+/**
+ * @brief assign the range of values to the range of constrained_any
+ *
+ * If the element holds same type of the value already, the value is assigned without reconstruction of the value carrier.
+ *
+ * @param d_first begin of the destination range of constrained_any
+ * @param d_last end of the destination range of constrained_any
+ * @param s_first begin of the range of values. It should have d_last - d_first elements at least.
+ * @return input iterator to the element past the last element assigned
+ */
+template <typename ForwardIt, typename InputIt,
+          typename std::enable_if<is_specialized_of_constrained_any<typename std::iterator_traits<ForwardIt>::value_type>::value>::type* = nullptr>
+InputIt assign_all( ForwardIt d_first, ForwardIt d_last, InputIt s_first )
+{
+	for ( ; d_first != d_last; ++d_first, ++s_first ) {
+		*d_first = *s_first;
+	}
+	return s_first;
+}
+
+/**
+ * @brief assign the range of values to std::vector of constrained_any
+ *
+ * The elements of dst are assigned by the corresponding elements of src, and then dst is resized to the size of src.
+ *
+ * @param dst destination vector
+ * @param src range of values. std::begin(src) and std::end(src) should be valid.
+ */
+template <typename SpecializedConstraintAny, typename Allocator, typename Range,
+          typename std::enable_if<is_specialized_of_constrained_any<SpecializedConstraintAny>::value>::type* = nullptr>
+void assign_all( std::vector<SpecializedConstraintAny, Allocator>& dst, const Range& src )
+{
+	auto   it_src   = std::begin( src );
+	auto   it_end   = std::end( src );
+	size_t n_assign = 0;
+	for ( auto it_dst = dst.begin(); ( it_dst != dst.end() ) && ( it_src != it_end ); ++it_dst, ++it_src ) {
+		*it_dst = *it_src;
+		n_assign++;
+	}
+	if ( it_src == it_end ) {
+		dst.erase( dst.begin() + static_cast<typename std::vector<SpecializedConstraintAny, Allocator>::difference_type>( n_assign ), dst.end() );
+	} else {
+		make_any_range<SpecializedConstraintAny>( it_src, it_end, dst );
+	}
+}
+
 template <class T, template <class> class... ConstrainAndOperationArgs>
 T constrained_any_cast( const constrained_any<ConstrainAndOperationArgs...>& operand )
 {
@@ -1682,16 +2532,71 @@ public:
 	static constexpr bool require_move_constructible = true;
 };
 
+/**
+ * @brief storage option to shrink the inline buffer to 24 bytes
+ *
+ * value carrier of 16 bytes value or less(e.g. int64_t, double and std::string_view) is stored in the inline buffer, and others are stored in the heap.
+ * Then, sizeof constrained_any is 32 bytes in C++20 implementation.
+ */
+template <typename Carrier>
+class special_operation_compact_storage {
+public:
+	static constexpr size_t inline_buffer_size = 32 - sizeof( void* );
+};
+
+/**
+ * @brief storage option to allocate the value carrier in the heap from the heap carrier pool
+ *
+ * value carrier that is not stored in the inline buffer is allocated from the size class slab pool with thread local free lists, instead of global operator new.
+ * This reduces the cost of construction, copy and type changing assignment of the value that is larger than the inline buffer.
+ *
+ * @see constrained_any_heap_carrier_pool.hpp
+ */
+template <typename Carrier>
+class special_operation_pooled_heap {
+public:
+	static constexpr bool use_heap_carrier_pool = true;
+};
+
+/**
+ * @brief storage option to allocate the value carrier in the heap from the active any_arena of the current thread
+ *
+ * Destruction of the value carrier in the heap runs the destructor of the value only, and any_arena releases the memory all at once.
+ * If no any_arena is active, construction of the value carrier in the heap throws std::logic_error.
+ *
+ * @see constrained_any_arena.hpp
+ */
+template <typename Carrier>
+class special_operation_arena_heap {
+public:
+	static constexpr bool use_arena_heap = true;
+};
+
 class special_operation_less_if {
 public:
 	virtual ~special_operation_less_if() = default;
 
-	virtual bool specialized_operation_less_proxy( const special_operation_less_if* ) const = 0;
+	virtual bool specialized_operation_less_proxy( const value_carrier_if_common& a, const value_carrier_if_common& b ) const = 0;
+};
+
+template <typename Carrier>
+class special_operation_less_dispatcher : public special_operation_less_if {
+private:
+	bool specialized_operation_less_proxy( const value_carrier_if_common& a, const value_carrier_if_common& b ) const override
+	{
+		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
+			// caller has already checked that a and b hold same type. Therefore, both of a and b are Carrier.
+			return static_cast<const Carrier&>( a ).ref() < static_cast<const Carrier&>( b ).ref();
+		} else {
+			throw std::logic_error( "specialized_operation_less_proxy() is not implemented for constrained_any itself" );
+		}
+	}
 };
 
 template <typename Carrier>
-class special_operation_less : public special_operation_less_if {
+class special_operation_less : public special_operation_dispatcher_base_t<Carrier, special_operation_less_dispatcher<Carrier>> {
 public:
+	static constexpr bool share_special_operation = true;
 	static constexpr bool constraint_check_result = !is_related_type_of_constrained_any<Carrier>::value &&
 	                                                is_weak_orderable<Carrier>::value;
 
@@ -1710,7 +2615,6 @@ public:
 		}
 
 		const special_operation_less_if* p_a_soi = p_a->template get_special_operation_if<special_operation_less_if>();
-		const special_operation_less_if* p_b_soi = p_b->template get_special_operation_if<special_operation_less_if>();
 		if ( p_a_soi == nullptr ) {
 			// In case that this is default constructed constrained_any
 			// it does not have special_operation_less_if.
@@ -1718,41 +2622,35 @@ public:
 			return false;
 		}
 
-		return p_a_soi->specialized_operation_less_proxy( p_b_soi );
+		return p_a_soi->specialized_operation_less_proxy( p_a->get_value_carrier(), p_b->get_value_carrier() );
 	}
+};
 
-private:
-	bool specialized_operation_less_proxy( const special_operation_less_if* p_b_if ) const override
-	{
-		return less_by_value( p_b_if );
-	}
+class special_operation_equal_to_if {
+public:
+	virtual ~special_operation_equal_to_if() = default;
+
+	virtual bool specialized_operation_equal_to_proxy( const value_carrier_if_common& a, const value_carrier_if_common& b ) const = 0;
+};
 
-	bool less_by_value( const special_operation_less_if* p_b_if ) const
+template <typename Carrier>
+class special_operation_equal_to_dispatcher : public special_operation_equal_to_if {
+private:
+	bool specialized_operation_equal_to_proxy( const value_carrier_if_common& a, const value_carrier_if_common& b ) const override
 	{
 		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
-			const Carrier* p_a_carrier = static_cast<const Carrier*>( this );
-			const Carrier* p_b_carrier = dynamic_cast<const Carrier*>( p_b_if );
-			if ( p_b_carrier == nullptr ) {
-				throw std::logic_error( "p_b_if of less_by_value() should be success to cast to same type to this. But it failed." );
-			}
-
-			return p_a_carrier->ref() < p_b_carrier->ref();
+			// caller has already checked that a and b hold same type. Therefore, both of a and b are Carrier.
+			return static_cast<const Carrier&>( a ).ref() == static_cast<const Carrier&>( b ).ref();
 		} else {
-			throw std::logic_error( "less_by_value() is not implemented for constrained_any itself" );
+			throw std::logic_error( "specialized_operation_equal_to_proxy() is not implemented for constrained_any itself" );
 		}
 	}
 };
 
-class special_operation_equal_to_if {
-public:
-	virtual ~special_operation_equal_to_if() = default;
-
-	virtual bool specialized_operation_equal_to_proxy( const special_operation_equal_to_if* ) const = 0;
-};
-
 template <typename Carrier>
-class special_operation_equal_to : public special_operation_equal_to_if {
+class special_operation_equal_to : public special_operation_dispatcher_base_t<Carrier, special_operation_equal_to_dispatcher<Carrier>> {
 public:
+	static constexpr bool share_special_operation = true;
 	static constexpr bool constraint_check_result = !is_related_type_of_constrained_any<Carrier>::value &&
 	                                                is_callable_equal_to<Carrier>::value;
 
@@ -1769,7 +2667,6 @@ public:
 		}
 
 		const special_operation_equal_to_if* p_a_soi = p_a->template get_special_operation_if<special_operation_equal_to_if>();
-		const special_operation_equal_to_if* p_b_soi = p_b->template get_special_operation_if<special_operation_equal_to_if>();
 		if ( p_a_soi == nullptr ) {
 			// In case that this is default constructed constrained_any
 			// it does not have special_operation_equal_to_if.
@@ -1777,41 +2674,34 @@ public:
 			return true;
 		}
 
-		return p_a_soi->specialized_operation_equal_to_proxy( p_b_soi );
+		return p_a_soi->specialized_operation_equal_to_proxy( p_a->get_value_carrier(), p_b->get_value_carrier() );
 	}
+};
 
-private:
-	bool specialized_operation_equal_to_proxy( const special_operation_equal_to_if* p_b_if ) const override
-	{
-		return unordered_key_equal_to( p_b_if );
-	}
+class special_operation_hash_value_if {
+public:
+	virtual ~special_operation_hash_value_if() = default;
+
+	virtual size_t specialized_operation_hash_value_proxy( const value_carrier_if_common& a ) const = 0;
+};
 
-	bool unordered_key_equal_to( const special_operation_equal_to_if* p_b_if ) const
+template <typename Carrier>
+class special_operation_hash_value_dispatcher : public special_operation_hash_value_if {
+private:
+	size_t specialized_operation_hash_value_proxy( const value_carrier_if_common& a ) const override
 	{
 		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
-			const Carrier* p_a_carrier = static_cast<const Carrier*>( this );
-			const Carrier* p_b_carrier = dynamic_cast<const Carrier*>( p_b_if );
-			if ( p_b_carrier == nullptr ) {
-				throw std::logic_error( "p_b_if of less_by_value() should be success to cast to same type to this. But it failed." );
-			}
-
-			return p_a_carrier->ref() == p_b_carrier->ref();
+			return std::hash<typename impl::remove_cvref<typename Carrier::value_type>::type>()( static_cast<const Carrier&>( a ).ref() );
 		} else {
-			throw std::logic_error( "unordered_key_equal_to() is not implemented for constrained_any itself" );
+			throw std::logic_error( "specialized_operation_hash_value_proxy() is not implemented for constrained_any itself" );
 		}
 	}
 };
 
-class special_operation_hash_value_if {
-public:
-	virtual ~special_operation_hash_value_if() = default;
-
-	virtual size_t specialized_operation_hash_value_proxy( void ) const = 0;
-};
-
 template <typename Carrier>
-class special_operation_hash_value : public special_operation_hash_value_if {
+class special_operation_hash_value : public special_operation_dispatcher_base_t<Carrier, special_operation_hash_value_dispatcher<Carrier>> {
 public:
+	static constexpr bool share_special_operation = true;
 	static constexpr bool constraint_check_result = !is_related_type_of_constrained_any<Carrier>::value &&
 	                                                is_hashable<Carrier>::value;
 
@@ -1828,23 +2718,37 @@ public:
 			return 0;
 		}
 
-		return p_a_soi->specialized_operation_hash_value_proxy();
+		return p_a_soi->specialized_operation_hash_value_proxy( p_a->get_value_carrier() );
 	}
+};
 
-private:
-	size_t specialized_operation_hash_value_proxy( void ) const override
-	{
-		return hash_value();
-	}
+// check that the specialized constrained_any has the member function of the special operation
+struct is_alias_with_less_impl {
+	template <typename T>
+	static auto check( T* ) -> decltype( std::declval<const T&>().less( std::declval<const T&>() ), std::true_type() );
+	template <typename T>
+	static auto check( ... ) -> std::false_type;
+};
+template <typename T>
+struct is_alias_with_less : public decltype( is_alias_with_less_impl::check<T>( nullptr ) ) { };
 
-	template <typename U = Carrier, typename std::enable_if<is_value_carrier_of_constrained_any<U>::value>::type* = nullptr>
-	size_t hash_value( void ) const
-	{
-		const Carrier* p_a_carrier = static_cast<const Carrier*>( this );
+struct is_alias_with_equal_to_impl {
+	template <typename T>
+	static auto check( T* ) -> decltype( std::declval<const T&>().equal_to( std::declval<const T&>() ), std::true_type() );
+	template <typename T>
+	static auto check( ... ) -> std::false_type;
+};
+template <typename T>
+struct is_alias_with_equal_to : public decltype( is_alias_with_equal_to_impl::check<T>( nullptr ) ) { };
 
-		return std::hash<typename impl::remove_cvref<typename Carrier::value_type>::type>()( p_a_carrier->ref() );
-	}
+struct is_alias_with_hash_value_impl {
+	template <typename T>
+	static auto check( T* ) -> decltype( std::declval<const T&>().hash_value(), std::true_type() );
+	template <typename T>
+	static auto check( ... ) -> std::false_type;
 };
+template <typename T>
+struct is_alias_with_hash_value : public decltype( is_alias_with_hash_value_impl::check<T>( nullptr ) ) { };
 
 }   // namespace impl
 
@@ -1974,6 +2878,75 @@ inline bool operator==( const T& lhs, const T& rhs )
 	return lhs.equal_to( rhs );
 }
 
+/**
+ * @brief arena bound variant of copyable_any
+ *
+ * @details
+ * The value carrier that is not stored in the inline buffer is allocated from the active any_arena of the current thread.
+ * This is suitable for the request scoped values that are dropped all at once.
+ *
+ * @see any_arena, any_arena_scope
+ */
+using arena_copyable_any = constrained_any<impl::special_operation_copyable, impl::special_operation_arena_heap>;
+
+/**
+ * @brief compact variant of copyable_any
+ *
+ * @details
+ * The inline buffer is 24 bytes. Therefore, only a value of 16 bytes or less is stored in the inline buffer, and others are stored in the heap.
+ * This is suitable for the containers of many scalar values.
+ */
+using compact_copyable_any = constrained_any<impl::special_operation_copyable, impl::special_operation_compact_storage>;
+
+/**
+ * @brief compact variant of weak_ordering_any
+ *
+ * @see compact_copyable_any
+ */
+using compact_weak_ordering_any = constrained_any<impl::special_operation_copyable, impl::special_operation_less, impl::special_operation_compact_storage>;
+
+/**
+ * @brief compact variant of unordered_key_any
+ *
+ * @see compact_copyable_any
+ */
+using compact_unordered_key_any = constrained_any<impl::special_operation_copyable, impl::special_operation_hash_value, impl::special_operation_equal_to, impl::special_operation_compact_storage>;
+
+/**
+ * @brief compact variant of keyable_any
+ *
+ * @see compact_copyable_any
+ */
+using compact_keyable_any = constrained_any<impl::special_operation_copyable, impl::special_operation_less, impl::special_operation_hash_value, impl::special_operation_equal_to, impl::special_operation_compact_storage>;
+
+/**
+ * @brief less operator(operator <) of compact_weak_ordering_any and compact_keyable_any
+ *
+ * @tparam T compact_weak_ordering_any or compact_keyable_any is only acceptable
+ * @param lhs left side variable of operator <
+ * @param rhs right side variable of operator <
+ * @return expression result of lhs < rhs
+ */
+template <typename T, typename std::enable_if<std::is_same<T, compact_weak_ordering_any>::value || std::is_same<T, compact_keyable_any>::value>::type* = nullptr>
+inline bool operator<( const T& lhs, const T& rhs )
+{
+	return lhs.less( rhs );
+}
+
+/**
+ * @brief equal operator(operator ==) of compact_unordered_key_any and compact_keyable_any
+ *
+ * @tparam T compact_unordered_key_any or compact_keyable_any is only acceptable
+ * @param lhs left side variable of operator ==
+ * @param rhs right side variable of operator ==
+ * @return expression result of lhs == rhs
+ */
+template <typename T, typename std::enable_if<std::is_same<T, compact_unordered_key_any>::value || std::is_same<T, compact_keyable_any>::value>::type* = nullptr>
+inline bool operator==( const T& lhs, const T& rhs )
+{
+	return lhs.equal_to( rhs );
+}
+
 }   // namespace yan
 
 namespace std {
@@ -1991,6 +2964,20 @@ struct hash<yan::keyable_any> {
 		return key.hash_value();
 	}
 };
+template <>
+struct hash<yan::compact_unordered_key_any> {
+	size_t operator()( const yan::compact_unordered_key_any& key ) const
+	{
+		return key.hash_value();
+	}
+};
+template <>
+struct hash<yan::compact_keyable_any> {
+	size_t operator()( const yan::compact_keyable_any& key ) const
+	{
+		return key.hash_value();
+	}
+};
 
 }   // namespace std
 
@@ -0,0 +1,253 @@
+/**
+ * @file constrained_any_arena.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief arena that allocates value carriers in the heap by bump allocation
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * any_arena is the caller supplied arena for request scoped values.
+ * If the template parameter pack of constrained_any has impl::special_operation_arena_heap(e.g. arena_copyable_any),
+ * the value carrier that is not stored in the inline buffer is bump allocated from the active any_arena of the current thread.
+ * any_arena_scope activates any_arena.
+ *
+ * Destruction of constrained_any runs the destructor of the value, but does not deallocate the value carrier individually.
+ * The memory is released all at once by any_arena::release() or the destructor of any_arena.
+ * The move of arena bound constrained_any takes over the value carrier. Therefore, the moved value stays in the original any_arena and the move does not need the active any_arena.
+ *
+ * any_arena::create() constructs arena bound constrained_any itself in the arena.
+ * If the value type is trivially destructible and the value carrier is in the arena, the destructor of constrained_any is skipped at release().
+ * Otherwise, it is called in reverse order of creation.
+ * Without C++20, the destructor is always called, because the empty value carrier after reset() is allocated by global operator new.
+ *
+ * @warning
+ * constrained_any that has a value carrier in any_arena should be destructed before release() of that any_arena.
+ */
+
+#ifndef INC_CONSTRAINED_ANY_ARENA_HPP_
+#define INC_CONSTRAINED_ANY_ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace yan {
+
+namespace impl {
+
+// defined in constrained_any.hpp
+template <typename Alias>
+struct is_arena_bound_alias;
+
+}   // namespace impl
+
+/**
+ * @brief arena of value carriers in the heap
+ *
+ * This is not thread safe. One any_arena should be used by one thread at a time.
+ */
+class any_arena {
+public:
+	static constexpr size_t default_chunk_size = 64 * 1024;
+
+	explicit any_arena( size_t chunk_size = default_chunk_size ) noexcept
+	  : chunk_size_( chunk_size )
+	{
+	}
+	~any_arena()
+	{
+		release();
+		if ( p_chunk_ != nullptr ) {
+			::operator delete( p_chunk_ );
+		}
+	}
+	any_arena( const any_arena& )            = delete;
+	any_arena& operator=( const any_arena& ) = delete;
+
+	/**
+	 * @brief allocate memory by bump allocation
+	 *
+	 * @param sz size of memory
+	 * @param al alignment of memory. this should be power of 2.
+	 * @return pointer to the allocated memory
+	 *
+	 * @exception std::bad_alloc if global operator new fails to allocate new chunk
+	 */
+	void* allocate( size_t sz, size_t al = alignof( std::max_align_t ) )
+	{
+		uintptr_t cur = ( reinterpret_cast<uintptr_t>( p_cur_ ) + ( al - 1 ) ) & ~static_cast<uintptr_t>( al - 1 );
+		if ( ( p_cur_ == nullptr ) || ( cur + sz > reinterpret_cast<uintptr_t>( p_end_ ) ) ) {
+			add_chunk( sz + al );
+			cur = ( reinterpret_cast<uintptr_t>( p_cur_ ) + ( al - 1 ) ) & ~static_cast<uintptr_t>( al - 1 );
+		}
+		p_cur_ = reinterpret_cast<unsigned char*>( cur + sz );
+		used_bytes_ += sz;
+		return reinterpret_cast<void*>( cur );
+	}
+
+	/**
+	 * @brief construct Alias in the arena
+	 *
+	 * @tparam Alias specialized type of constrained_any that has impl::special_operation_arena_heap
+	 * @tparam T value type
+	 * @param args arguments for the constructor of T
+	 * @return reference to the constructed Alias. It is valid until release().
+	 *
+	 * @note
+	 * If T is trivially destructible, the destructor of Alias may be skipped at release(). Therefore, Alias should not be assigned by the value of other type that is not trivially destructible.
+	 */
+	template <typename Alias, typename T, typename... Args>
+	Alias& create( Args&&... args )
+	{
+		static_assert( impl::is_arena_bound_alias<Alias>::value, "Alias should have impl::special_operation_arena_heap. Otherwise, the value carrier in the heap is not released by any_arena." );
+#if __cpp_concepts >= 201907L
+		// the value carrier is in the inline buffer of Alias or in this arena.
+		constexpr bool is_destructor_skippable = std::is_trivially_destructible<T>::value;
+#else
+		// std::unique_ptr of Alias owns the value carrier, and the empty value carrier is allocated by global operator new.
+		constexpr bool is_destructor_skippable = false;
+#endif
+
+		any_arena* p_prev = get_active_arena();
+		get_active_arena() = this;
+		try {
+			destructor_record* p_rec = nullptr;
+			if constexpr ( !is_destructor_skippable ) {
+				p_rec = new ( allocate( sizeof( destructor_record ), alignof( destructor_record ) ) ) destructor_record;
+			}
+			Alias* p_ans = new ( allocate( sizeof( Alias ), alignof( Alias ) ) ) Alias( std::in_place_type<T>, std::forward<Args>( args )... );
+			if ( p_rec != nullptr ) {
+				p_rec->p_obj_      = p_ans;
+				p_rec->p_destruct_ = []( void* p ) noexcept {
+					static_cast<Alias*>( p )->~Alias();
+				};
+				p_rec->p_next_     = p_destructors_;
+				p_destructors_     = p_rec;
+			}
+			get_active_arena() = p_prev;
+			return *p_ans;
+		} catch ( ... ) {
+			get_active_arena() = p_prev;
+			throw;
+		}
+	}
+
+	/**
+	 * @brief destruct Alias that are created by create() and release the all memory
+	 *
+	 * The last chunk is kept to reuse for next allocation.
+	 */
+	void release( void ) noexcept
+	{
+		for ( destructor_record* p = p_destructors_; p != nullptr; p = p->p_next_ ) {
+			p->p_destruct_( p->p_obj_ );
+		}
+		p_destructors_ = nullptr;
+
+		if ( p_chunk_ == nullptr ) {
+			return;
+		}
+		chunk_header* p_keep = p_chunk_;
+		chunk_header* p_cur  = p_keep->p_next_;
+		while ( p_cur != nullptr ) {
+			chunk_header* p_next = p_cur->p_next_;
+			::operator delete( p_cur );
+			p_cur = p_next;
+		}
+		p_keep->p_next_ = nullptr;
+		p_cur_          = reinterpret_cast<unsigned char*>( p_keep + 1 );
+		used_bytes_     = 0;
+	}
+
+	size_t used_bytes( void ) const noexcept
+	{
+		return used_bytes_;
+	}
+
+	/**
+	 * @brief active arena of the current thread
+	 *
+	 * @return reference to the pointer to the active arena. nullptr means no active arena.
+	 */
+	static any_arena*& get_active_arena( void ) noexcept
+	{
+		thread_local any_arena* p_active = nullptr;
+		return p_active;
+	}
+
+private:
+	struct chunk_header {
+		chunk_header* p_next_;
+		size_t        size_;
+	};
+
+	using destruct_func_t = void ( * )( void* ) noexcept;
+
+	struct destructor_record {
+		void*              p_obj_;
+		destruct_func_t    p_destruct_;
+		destructor_record* p_next_;
+	};
+
+	void add_chunk( size_t min_size )
+	{
+		size_t        sz      = ( min_size > chunk_size_ ) ? min_size : chunk_size_;
+		chunk_header* p_chunk = static_cast<chunk_header*>( ::operator new( sizeof( chunk_header ) + sz ) );
+		p_chunk->p_next_      = p_chunk_;
+		p_chunk->size_        = sz;
+		p_chunk_              = p_chunk;
+		p_cur_                = reinterpret_cast<unsigned char*>( p_chunk + 1 );
+		p_end_                = p_cur_ + sz;
+	}
+
+	size_t             chunk_size_;
+	chunk_header*      p_chunk_       = nullptr;   // the latest chunk. older chunks are linked by p_next_.
+	unsigned char*     p_cur_         = nullptr;
+	unsigned char*     p_end_         = nullptr;
+	size_t             used_bytes_    = 0;
+	destructor_record* p_destructors_ = nullptr;
+};
+
+/**
+ * @brief RAII class to activate any_arena in the current thread
+ *
+ * Nested scope is allowed. The previous active arena is restored by the destructor.
+ */
+class any_arena_scope {
+public:
+	explicit any_arena_scope( any_arena& arena ) noexcept
+	  : p_prev_( any_arena::get_active_arena() )
+	{
+		any_arena::get_active_arena() = &arena;
+	}
+	~any_arena_scope()
+	{
+		any_arena::get_active_arena() = p_prev_;
+	}
+	any_arena_scope( const any_arena_scope& )            = delete;
+	any_arena_scope& operator=( const any_arena_scope& ) = delete;
+
+private:
+	any_arena* p_prev_;
+};
+
+namespace impl {
+
+inline void* any_arena_allocate( size_t sz, size_t al )
+{
+	any_arena* p_arena = any_arena::get_active_arena();
+	if ( p_arena == nullptr ) {
+		throw std::logic_error( "value carrier of arena bound constrained_any is allocated without active any_arena. use any_arena_scope." );
+	}
+	return p_arena->allocate( sz, al );
+}
+
+}   // namespace impl
+}   // namespace yan
+
+#endif
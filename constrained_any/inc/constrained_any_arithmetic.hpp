@@ -0,0 +1,701 @@
+/**
+ * @file constrained_any_arithmetic.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief special operation of the arithmetic between constrained_any that hold arithmetic types
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * special_operation_arithmetic adds add(), sub(), mul() and compare() to constrained_any.
+ * If both values are same type, the operation is done by that type directly. Otherwise, both values are converted to the type of the promotion table,
+ * i.e. the type of the result of the built-in operator between the values, e.g. int + double is double, and int + int64_t is int64_t.
+ * Therefore, the caller does not need to try constrained_any_cast for each candidate type.
+ *
+ * add_batch(), sub_batch(), mul_batch() and compare_batch() operate on the arrays of constrained_any.
+ * If all elements of a chunk hold same arithmetic type, the values are loaded to the array of that type, and the operation runs as the plain loop of it
+ * that the compiler is able to vectorize.
+ */
+
+#ifndef INC_CONSTRAINED_ANY_ARITHMETIC_HPP_
+#define INC_CONSTRAINED_ANY_ARITHMETIC_HPP_
+
+#include <algorithm>
+#include <any>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "constrained_any.hpp"
+
+namespace yan {
+
+/**
+ * @brief result of compare()
+ */
+enum class arithmetic_ordering {
+	less,         //!< a < b
+	equivalent,   //!< a == b
+	greater,      //!< a > b
+	unordered,    //!< a or b is NaN
+};
+
+namespace impl {
+
+/**
+ * @brief arithmetic types after the integral promotion. The index of this list is the kind of the type.
+ */
+using arithmetic_kind_types = std::tuple<int, unsigned int, long, unsigned long, long long, unsigned long long, float, double, long double>;
+
+constexpr size_t num_of_arithmetic_kinds = std::tuple_size<arithmetic_kind_types>::value;
+
+template <size_t I>
+using arithmetic_kind_t = typename std::tuple_element<I, arithmetic_kind_types>::type;
+
+template <typename T>
+using arithmetic_promoted_t = decltype( +std::declval<T>() );
+
+template <typename T, size_t I = 0>
+struct arithmetic_kind_index {
+	static constexpr size_t value = std::is_same<T, arithmetic_kind_t<I>>::value ? I : arithmetic_kind_index<T, I + 1>::value;
+};
+
+template <typename T>
+struct arithmetic_kind_index<T, num_of_arithmetic_kinds> {
+	static constexpr size_t value = num_of_arithmetic_kinds;
+};
+
+/**
+ * @brief kind of the arithmetic type T after the integral promotion
+ */
+template <typename T>
+struct arithmetic_kind_of {
+	static constexpr size_t value = arithmetic_kind_index<arithmetic_promoted_t<T>>::value;
+};
+
+template <typename T>
+struct is_arithmetic_operable {
+	using value_t = typename impl::remove_cvref<T>::type;
+
+	static constexpr bool value = std::is_arithmetic<value_t>::value && !std::is_same<value_t, bool>::value;
+};
+
+template <size_t I, size_t... J>
+constexpr std::array<size_t, num_of_arithmetic_kinds> make_arithmetic_promotion_row( std::index_sequence<J...> )
+{
+	return { arithmetic_kind_index<typename std::common_type<arithmetic_kind_t<I>, arithmetic_kind_t<J>>::type>::value... };
+}
+
+template <size_t... I>
+constexpr std::array<std::array<size_t, num_of_arithmetic_kinds>, num_of_arithmetic_kinds> make_arithmetic_promotion_table( std::index_sequence<I...> )
+{
+	return { make_arithmetic_promotion_row<I>( std::make_index_sequence<num_of_arithmetic_kinds> {} )... };
+}
+
+/**
+ * @brief kind of the result of the built-in operator between the kinds [a][b]
+ */
+inline constexpr std::array<std::array<size_t, num_of_arithmetic_kinds>, num_of_arithmetic_kinds> arithmetic_promotion_table =
+	make_arithmetic_promotion_table( std::make_index_sequence<num_of_arithmetic_kinds> {} );
+
+/**
+ * @brief value of one of the arithmetic kinds
+ */
+struct arithmetic_value {
+	size_t kind_;
+	alignas( long double ) unsigned char buff_[sizeof( long double )];
+
+	template <typename T>
+	void set( T v ) noexcept
+	{
+		static_assert( arithmetic_kind_index<T>::value < num_of_arithmetic_kinds, "T should be one of arithmetic_kind_types" );
+		kind_ = arithmetic_kind_index<T>::value;
+		std::memcpy( buff_, &v, sizeof( T ) );
+	}
+
+	template <typename T>
+	T get( void ) const noexcept
+	{
+		T ans;
+		std::memcpy( &ans, buff_, sizeof( T ) );
+		return ans;
+	}
+};
+
+template <typename T>
+struct arithmetic_type_tag {
+	using type = T;
+};
+
+/**
+ * @brief call f( arithmetic_type_tag<T>{} ) with T of the kind
+ */
+template <size_t I = 0, typename F>
+decltype( auto ) arithmetic_visit( size_t kind, F&& f )
+{
+	if constexpr ( I + 1 < num_of_arithmetic_kinds ) {
+		if ( kind == I ) {
+			return f( arithmetic_type_tag<arithmetic_kind_t<I>> {} );
+		}
+		return arithmetic_visit<I + 1>( kind, std::forward<F>( f ) );
+	} else {
+		return f( arithmetic_type_tag<arithmetic_kind_t<I>> {} );
+	}
+}
+
+enum class arithmetic_operator {
+	add,
+	sub,
+	mul,
+};
+
+/**
+ * @brief apply the operator to the values of the arithmetic kind R
+ *
+ * The signed integer is calculated as the unsigned integer. Therefore, the overflow wraps around instead of undefined behavior.
+ */
+template <arithmetic_operator Op, typename R>
+R arithmetic_apply( R a, R b ) noexcept
+{
+	if constexpr ( std::is_integral<R>::value ) {
+		using u_t = typename std::make_unsigned<R>::type;
+		if constexpr ( Op == arithmetic_operator::add ) {
+			return static_cast<R>( static_cast<u_t>( a ) + static_cast<u_t>( b ) );
+		} else if constexpr ( Op == arithmetic_operator::sub ) {
+			return static_cast<R>( static_cast<u_t>( a ) - static_cast<u_t>( b ) );
+		} else {
+			return static_cast<R>( static_cast<u_t>( a ) * static_cast<u_t>( b ) );
+		}
+	} else {
+		if constexpr ( Op == arithmetic_operator::add ) {
+			return a + b;
+		} else if constexpr ( Op == arithmetic_operator::sub ) {
+			return a - b;
+		} else {
+			return a * b;
+		}
+	}
+}
+
+template <typename R>
+R arithmetic_apply( arithmetic_operator op, R a, R b ) noexcept
+{
+	switch ( op ) {
+		case arithmetic_operator::add: return arithmetic_apply<arithmetic_operator::add, R>( a, b );
+		case arithmetic_operator::sub: return arithmetic_apply<arithmetic_operator::sub, R>( a, b );
+		default: return arithmetic_apply<arithmetic_operator::mul, R>( a, b );
+	}
+}
+
+/**
+ * @brief compare the values of arithmetic types
+ *
+ * The signed integer and the unsigned integer are compared by their values like std::cmp_less(), i.e. -1 is less than 0U.
+ * The other combinations are compared after the conversion same to the built-in operator.
+ */
+template <typename A, typename B>
+arithmetic_ordering arithmetic_compare( A a, B b ) noexcept
+{
+	if constexpr ( std::is_integral<A>::value && std::is_integral<B>::value && ( std::is_signed<A>::value != std::is_signed<B>::value ) ) {
+		if constexpr ( std::is_signed<A>::value ) {
+			if ( a < 0 ) {
+				return arithmetic_ordering::less;
+			}
+			return arithmetic_compare( static_cast<typename std::make_unsigned<A>::type>( a ), b );
+		} else {
+			if ( b < 0 ) {
+				return arithmetic_ordering::greater;
+			}
+			return arithmetic_compare( a, static_cast<typename std::make_unsigned<B>::type>( b ) );
+		}
+	} else {
+		using r_t = typename std::common_type<A, B>::type;
+		r_t ra    = static_cast<r_t>( a );
+		r_t rb    = static_cast<r_t>( b );
+		if ( ra < rb ) {
+			return arithmetic_ordering::less;
+		}
+		if ( rb < ra ) {
+			return arithmetic_ordering::greater;
+		}
+		if ( ra == rb ) {
+			return arithmetic_ordering::equivalent;
+		}
+		return arithmetic_ordering::unordered;
+	}
+}
+
+class special_operation_arithmetic_if {
+public:
+	virtual ~special_operation_arithmetic_if() = default;
+
+	virtual size_t specialized_operation_arithmetic_kind_proxy( void ) const noexcept = 0;
+
+	virtual void specialized_operation_arithmetic_load_proxy( const value_carrier_if_common& a, size_t kind, arithmetic_value& out ) const = 0;
+
+	virtual void specialized_operation_arithmetic_proxy( arithmetic_operator op, const value_carrier_if_common& a,
+	                                                     const special_operation_arithmetic_if& b_if, const value_carrier_if_common& b,
+	                                                     arithmetic_value& out ) const = 0;
+
+	virtual arithmetic_ordering specialized_operation_compare_proxy( const value_carrier_if_common& a,
+	                                                                 const special_operation_arithmetic_if& b_if, const value_carrier_if_common& b ) const = 0;
+};
+
+/**
+ * @brief interface of the arithmetic of same value type that constructs the result of Alias directly
+ *
+ * The dispatcher of the value carrier of Alias implements this interface. Therefore, if special_operation_arithmetic_if is found from
+ * the value carrier of Alias, it is static_cast to this interface.
+ */
+template <typename Alias>
+class special_operation_arithmetic_same_type_if : public special_operation_arithmetic_if {
+public:
+	virtual Alias specialized_operation_arithmetic_same_type_proxy( arithmetic_operator op, const value_carrier_if_common& a, const value_carrier_if_common& b ) const = 0;
+
+	virtual void specialized_operation_arithmetic_same_type_to_proxy( arithmetic_operator op, const value_carrier_if_common& a, const value_carrier_if_common& b,
+	                                                                  Alias& dst ) const = 0;
+};
+
+/**
+ * @brief implementation of special_operation_arithmetic_same_type_if for the value carrier of Alias
+ */
+template <typename Carrier, typename Alias>
+class special_operation_arithmetic_same_type_dispatcher : public special_operation_arithmetic_same_type_if<Alias> {
+private:
+	using value_t    = typename impl::remove_cvref<typename Carrier::value_type>::type;
+	using promoted_t = arithmetic_promoted_t<value_t>;
+
+	static promoted_t apply( arithmetic_operator op, const value_carrier_if_common& a, const value_carrier_if_common& b )
+	{
+		// caller has already checked that a and b hold same type. Therefore, both of a and b are Carrier.
+		return arithmetic_apply<promoted_t>( op,
+		                                     static_cast<promoted_t>( static_cast<const Carrier&>( a ).ref() ),
+		                                     static_cast<promoted_t>( static_cast<const Carrier&>( b ).ref() ) );
+	}
+
+	Alias specialized_operation_arithmetic_same_type_proxy( arithmetic_operator op, const value_carrier_if_common& a, const value_carrier_if_common& b ) const override
+	{
+		return Alias( std::in_place_type<promoted_t>, apply( op, a, b ) );
+	}
+
+	void specialized_operation_arithmetic_same_type_to_proxy( arithmetic_operator op, const value_carrier_if_common& a, const value_carrier_if_common& b,
+	                                                          Alias& dst ) const override
+	{
+		dst = apply( op, a, b );
+	}
+};
+
+template <typename Carrier, typename = void>
+struct special_operation_arithmetic_dispatcher_if {
+	using type = special_operation_arithmetic_if;
+};
+
+template <typename Carrier>
+struct special_operation_arithmetic_dispatcher_if<Carrier, std::void_t<typename alias_of_value_carrier<Carrier>::type>> {
+	using type = special_operation_arithmetic_same_type_dispatcher<Carrier, typename alias_of_value_carrier<Carrier>::type>;
+};
+
+template <typename Carrier>
+class special_operation_arithmetic_dispatcher : public special_operation_arithmetic_dispatcher_if<Carrier>::type {
+private:
+	size_t specialized_operation_arithmetic_kind_proxy( void ) const noexcept override
+	{
+		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
+			return arithmetic_kind_of<typename impl::remove_cvref<typename Carrier::value_type>::type>::value;
+		} else {
+			return num_of_arithmetic_kinds;
+		}
+	}
+
+	void specialized_operation_arithmetic_load_proxy( const value_carrier_if_common& a, size_t kind, arithmetic_value& out ) const override
+	{
+		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
+			const auto& va = static_cast<const Carrier&>( a ).ref();
+			arithmetic_visit( kind, [&va, &out]( auto tag ) {
+				using r_t = typename decltype( tag )::type;
+				out.set( static_cast<r_t>( va ) );
+			} );
+		} else {
+			throw std::logic_error( "specialized_operation_arithmetic_load_proxy() is not implemented for constrained_any itself" );
+		}
+	}
+
+	void specialized_operation_arithmetic_proxy( arithmetic_operator op, const value_carrier_if_common& a,
+	                                             const special_operation_arithmetic_if& b_if, const value_carrier_if_common& b,
+	                                             arithmetic_value& out ) const override
+	{
+		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
+			using value_t = typename impl::remove_cvref<typename Carrier::value_type>::type;
+
+			const value_t& va = static_cast<const Carrier&>( a ).ref();
+			// same value type is calculated by specialized_operation_arithmetic_same_type_proxy(). even if it comes here, the promoted path returns same result.
+			size_t kind = arithmetic_promotion_table[arithmetic_kind_of<value_t>::value][b_if.specialized_operation_arithmetic_kind_proxy()];
+			arithmetic_value vb;
+			b_if.specialized_operation_arithmetic_load_proxy( b, kind, vb );
+			arithmetic_visit( kind, [op, &va, &vb, &out]( auto tag ) {
+				using r_t = typename decltype( tag )::type;
+				out.set( arithmetic_apply<r_t>( op, static_cast<r_t>( va ), vb.get<r_t>() ) );
+			} );
+		} else {
+			throw std::logic_error( "specialized_operation_arithmetic_proxy() is not implemented for constrained_any itself" );
+		}
+	}
+
+	arithmetic_ordering specialized_operation_compare_proxy( const value_carrier_if_common& a,
+	                                                         const special_operation_arithmetic_if& b_if, const value_carrier_if_common& b ) const override
+	{
+		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
+			using value_t    = typename impl::remove_cvref<typename Carrier::value_type>::type;
+			using promoted_t = arithmetic_promoted_t<value_t>;
+
+			const value_t& va = static_cast<const Carrier&>( a ).ref();
+			if ( &b_if == this ) {
+				return arithmetic_compare( static_cast<promoted_t>( va ), static_cast<promoted_t>( static_cast<const Carrier&>( b ).ref() ) );
+			}
+
+			size_t           kind_b = b_if.specialized_operation_arithmetic_kind_proxy();
+			arithmetic_value vb;
+			b_if.specialized_operation_arithmetic_load_proxy( b, kind_b, vb );
+			return arithmetic_visit( kind_b, [&va, &vb]( auto tag ) {
+				using b_t = typename decltype( tag )::type;
+				return arithmetic_compare( static_cast<promoted_t>( va ), vb.get<b_t>() );
+			} );
+		} else {
+			throw std::logic_error( "specialized_operation_compare_proxy() is not implemented for constrained_any itself" );
+		}
+	}
+};
+
+/**
+ * @brief construct Alias that holds the value of the arithmetic kind
+ */
+template <typename Alias>
+Alias make_any_from_arithmetic_value( const arithmetic_value& v )
+{
+	return arithmetic_visit( v.kind_, [&v]( auto tag ) {
+		using r_t = typename decltype( tag )::type;
+		return Alias( std::in_place_type<r_t>, v.get<r_t>() );
+	} );
+}
+
+/**
+ * @brief assign the value of the arithmetic kind to dst
+ *
+ * If dst holds same type already, the value is assigned without reconstruction of the value carrier.
+ */
+template <typename Alias>
+void assign_arithmetic_value( Alias& dst, const arithmetic_value& v )
+{
+	arithmetic_visit( v.kind_, [&dst, &v]( auto tag ) {
+		using r_t = typename decltype( tag )::type;
+		dst       = v.get<r_t>();
+	} );
+}
+
+template <typename Alias>
+void get_arithmetic_operands( const Alias& a, const Alias& b, const special_operation_arithmetic_if*& p_a_soi, const special_operation_arithmetic_if*& p_b_soi )
+{
+	p_a_soi = a.template get_special_operation_if<special_operation_arithmetic_if>();
+	p_b_soi = b.template get_special_operation_if<special_operation_arithmetic_if>();
+	if ( ( p_a_soi == nullptr ) || ( p_b_soi == nullptr ) ) {
+		// In case that constrained_any is default constructed, it has no value to calculate.
+		throw std::bad_any_cast();
+	}
+}
+
+template <typename Alias>
+Alias arithmetic_operate( arithmetic_operator op, const Alias& a, const Alias& b )
+{
+	const special_operation_arithmetic_if* p_a_soi;
+	const special_operation_arithmetic_if* p_b_soi;
+	get_arithmetic_operands( a, b, p_a_soi, p_b_soi );
+
+	// the dispatcher is the part of the singleton holder of each value carrier type. therefore, same dispatcher means same value type,
+	// and the dispatcher of the value carrier of Alias implements special_operation_arithmetic_same_type_if<Alias>.
+	if ( p_a_soi == p_b_soi ) {
+		return static_cast<const special_operation_arithmetic_same_type_if<Alias>*>( p_a_soi )->specialized_operation_arithmetic_same_type_proxy( op, a.get_value_carrier(), b.get_value_carrier() );
+	}
+
+	arithmetic_value ans;
+	p_a_soi->specialized_operation_arithmetic_proxy( op, a.get_value_carrier(), *p_b_soi, b.get_value_carrier(), ans );
+	return make_any_from_arithmetic_value<Alias>( ans );
+}
+
+template <typename Alias>
+void arithmetic_operate_to( arithmetic_operator op, const Alias& a, const Alias& b, Alias& dst )
+{
+	const special_operation_arithmetic_if* p_a_soi;
+	const special_operation_arithmetic_if* p_b_soi;
+	get_arithmetic_operands( a, b, p_a_soi, p_b_soi );
+
+	if ( p_a_soi == p_b_soi ) {
+		static_cast<const special_operation_arithmetic_same_type_if<Alias>*>( p_a_soi )->specialized_operation_arithmetic_same_type_to_proxy( op, a.get_value_carrier(), b.get_value_carrier(), dst );
+		return;
+	}
+
+	arithmetic_value ans;
+	p_a_soi->specialized_operation_arithmetic_proxy( op, a.get_value_carrier(), *p_b_soi, b.get_value_carrier(), ans );
+	assign_arithmetic_value( dst, ans );
+}
+
+template <typename Alias>
+arithmetic_ordering arithmetic_operate_compare( const Alias& a, const Alias& b )
+{
+	const special_operation_arithmetic_if* p_a_soi;
+	const special_operation_arithmetic_if* p_b_soi;
+	get_arithmetic_operands( a, b, p_a_soi, p_b_soi );
+
+	return p_a_soi->specialized_operation_compare_proxy( a.get_value_carrier(), *p_b_soi, b.get_value_carrier() );
+}
+
+/**
+ * @brief special operation of the arithmetic
+ *
+ * The value type should be arithmetic type except bool.
+ * The type of the result is same to the built-in operator, e.g. short + short is int.
+ * The overflow of the signed integer wraps around.
+ */
+template <typename Carrier>
+class special_operation_arithmetic : public special_operation_dispatcher_base_t<Carrier, special_operation_arithmetic_dispatcher<Carrier>> {
+public:
+	static constexpr bool share_special_operation = true;
+	static constexpr bool constraint_check_result = !is_related_type_of_constrained_any<Carrier>::value &&
+	                                                is_arithmetic_operable<Carrier>::value;
+
+	/**
+	 * @brief this + b
+	 *
+	 * @exception std::bad_any_cast if this or b has no value
+	 */
+	template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	Carrier add( const Carrier& b ) const
+	{
+		return arithmetic_operate( arithmetic_operator::add, *static_cast<const Carrier*>( this ), b );
+	}
+
+	/**
+	 * @brief this - b
+	 *
+	 * @exception std::bad_any_cast if this or b has no value
+	 */
+	template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	Carrier sub( const Carrier& b ) const
+	{
+		return arithmetic_operate( arithmetic_operator::sub, *static_cast<const Carrier*>( this ), b );
+	}
+
+	/**
+	 * @brief this * b
+	 *
+	 * @exception std::bad_any_cast if this or b has no value
+	 */
+	template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	Carrier mul( const Carrier& b ) const
+	{
+		return arithmetic_operate( arithmetic_operator::mul, *static_cast<const Carrier*>( this ), b );
+	}
+
+	/**
+	 * @brief compare the value of this with the value of b
+	 *
+	 * @exception std::bad_any_cast if this or b has no value
+	 */
+	template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	arithmetic_ordering compare( const Carrier& b ) const
+	{
+		return arithmetic_operate_compare( *static_cast<const Carrier*>( this ), b );
+	}
+};
+
+template <typename Alias>
+struct is_arithmetic_any {
+	static constexpr bool value = std::conjunction<is_specialized_of_constrained_any<Alias>, std::is_base_of<special_operation_arithmetic<Alias>, Alias>>::value;
+};
+
+/**
+ * @brief number of the elements that are loaded to the typed array at once by the batch operations
+ */
+constexpr size_t arithmetic_batch_chunk_size = 256;
+
+/**
+ * @brief call f( arithmetic_type_tag<T>{} ) if ti is one of the arithmetic kinds
+ *
+ * @return result of f, or false if ti is not one of the arithmetic kinds
+ */
+template <size_t I = 0, typename F>
+bool arithmetic_visit_type( const std::type_info& ti, F&& f )
+{
+	if constexpr ( I < num_of_arithmetic_kinds ) {
+		if ( ti == typeid( arithmetic_kind_t<I> ) ) {
+			return f( arithmetic_type_tag<arithmetic_kind_t<I>> {} );
+		}
+		return arithmetic_visit_type<I + 1>( ti, std::forward<F>( f ) );
+	} else {
+		return false;
+	}
+}
+
+/**
+ * @brief apply f to each chunk of p_a and p_b
+ *
+ * If all elements of the chunk hold same arithmetic kind T, f_typed( arithmetic_type_tag<T>{}, p_va, p_vb, base, m ) is called
+ * with the arrays of the values of T. Otherwise, f_each( i ) is called for each element of the chunk.
+ * The chunk is small enough to stay in the cache between the load of the values and the fallback.
+ */
+template <typename Alias, typename FTyped, typename FEach>
+void arithmetic_batch_for_each_chunk( const Alias* p_a, const Alias* p_b, size_t n, FTyped&& f_typed, FEach&& f_each )
+{
+	for ( size_t base = 0; base < n; base += arithmetic_batch_chunk_size ) {
+		size_t m    = std::min( n - base, arithmetic_batch_chunk_size );
+		bool   done = arithmetic_visit_type( p_a[base].type(), [&]( auto tag ) {
+            using t_t = typename decltype( tag )::type;
+            t_t va[arithmetic_batch_chunk_size];
+            t_t vb[arithmetic_batch_chunk_size];
+            for ( size_t i = 0; i < m; i++ ) {
+                const t_t* p_va = constrained_any_cast<t_t>( p_a + base + i );
+                const t_t* p_vb = constrained_any_cast<t_t>( p_b + base + i );
+                if ( ( p_va == nullptr ) || ( p_vb == nullptr ) ) {
+                    return false;
+                }
+                va[i] = *p_va;
+                vb[i] = *p_vb;
+            }
+            f_typed( tag, va, vb, base, m );
+            return true;
+        } );
+		if ( !done ) {
+			for ( size_t i = base; i < base + m; i++ ) {
+				f_each( i );
+			}
+		}
+	}
+}
+
+template <arithmetic_operator Op, typename Alias>
+void arithmetic_batch( const Alias* p_a, const Alias* p_b, Alias* p_out, size_t n )
+{
+	arithmetic_batch_for_each_chunk(
+		p_a, p_b, n,
+		[p_out]( auto tag, auto* p_va, const auto* p_vb, size_t base, size_t m ) {
+			using t_t = typename decltype( tag )::type;
+			for ( size_t i = 0; i < m; i++ ) {
+				p_va[i] = arithmetic_apply<Op, t_t>( p_va[i], p_vb[i] );
+			}
+			for ( size_t i = 0; i < m; i++ ) {
+				p_out[base + i] = p_va[i];
+			}
+		},
+		[p_a, p_b, p_out]( size_t i ) {
+			arithmetic_operate_to( Op, p_a[i], p_b[i], p_out[i] );
+		} );
+}
+
+template <typename Alias>
+void arithmetic_batch_compare( const Alias* p_a, const Alias* p_b, arithmetic_ordering* p_out, size_t n )
+{
+	arithmetic_batch_for_each_chunk(
+		p_a, p_b, n,
+		[p_out]( auto, const auto* p_va, const auto* p_vb, size_t base, size_t m ) {
+			for ( size_t i = 0; i < m; i++ ) {
+				p_out[base + i] = arithmetic_compare( p_va[i], p_vb[i] );
+			}
+		},
+		[p_a, p_b, p_out]( size_t i ) {
+			p_out[i] = arithmetic_operate_compare( p_a[i], p_b[i] );
+		} );
+}
+
+}   // namespace impl
+
+/**
+ * @brief p_out[i] = p_a[i].add( p_b[i] ) for i in [0, n)
+ *
+ * The elements are processed by the chunk of impl::arithmetic_batch_chunk_size elements.
+ * If all elements of the chunk hold same arithmetic type that is not promoted, e.g. int, int64_t or double, the typed loop is used for the chunk.
+ * p_out may be same to p_a or p_b.
+ *
+ * @exception std::bad_any_cast if an element has no value
+ */
+template <typename Alias, typename std::enable_if<impl::is_arithmetic_any<Alias>::value>::type* = nullptr>
+void add_batch( const Alias* p_a, const Alias* p_b, Alias* p_out, size_t n )
+{
+	impl::arithmetic_batch<impl::arithmetic_operator::add>( p_a, p_b, p_out, n );
+}
+
+/**
+ * @brief p_out[i] = p_a[i].sub( p_b[i] ) for i in [0, n)
+ *
+ * @see add_batch()
+ */
+template <typename Alias, typename std::enable_if<impl::is_arithmetic_any<Alias>::value>::type* = nullptr>
+void sub_batch( const Alias* p_a, const Alias* p_b, Alias* p_out, size_t n )
+{
+	impl::arithmetic_batch<impl::arithmetic_operator::sub>( p_a, p_b, p_out, n );
+}
+
+/**
+ * @brief p_out[i] = p_a[i].mul( p_b[i] ) for i in [0, n)
+ *
+ * @see add_batch()
+ */
+template <typename Alias, typename std::enable_if<impl::is_arithmetic_any<Alias>::value>::type* = nullptr>
+void mul_batch( const Alias* p_a, const Alias* p_b, Alias* p_out, size_t n )
+{
+	impl::arithmetic_batch<impl::arithmetic_operator::mul>( p_a, p_b, p_out, n );
+}
+
+/**
+ * @brief p_out[i] = p_a[i].compare( p_b[i] ) for i in [0, n)
+ *
+ * @see add_batch()
+ */
+template <typename Alias, typename std::enable_if<impl::is_arithmetic_any<Alias>::value>::type* = nullptr>
+void compare_batch( const Alias* p_a, const Alias* p_b, arithmetic_ordering* p_out, size_t n )
+{
+	impl::arithmetic_batch_compare( p_a, p_b, p_out, n );
+}
+
+/**
+ * @brief a + b by impl::special_operation_arithmetic
+ */
+template <template <class> class... ConstrainAndOperationArgs,
+          typename std::enable_if<impl::is_arithmetic_any<constrained_any<ConstrainAndOperationArgs...>>::value>::type* = nullptr>
+constrained_any<ConstrainAndOperationArgs...> operator+( const constrained_any<ConstrainAndOperationArgs...>& a, const constrained_any<ConstrainAndOperationArgs...>& b )
+{
+	return a.add( b );
+}
+
+/**
+ * @brief a - b by impl::special_operation_arithmetic
+ */
+template <template <class> class... ConstrainAndOperationArgs,
+          typename std::enable_if<impl::is_arithmetic_any<constrained_any<ConstrainAndOperationArgs...>>::value>::type* = nullptr>
+constrained_any<ConstrainAndOperationArgs...> operator-( const constrained_any<ConstrainAndOperationArgs...>& a, const constrained_any<ConstrainAndOperationArgs...>& b )
+{
+	return a.sub( b );
+}
+
+/**
+ * @brief a * b by impl::special_operation_arithmetic
+ */
+template <template <class> class... ConstrainAndOperationArgs,
+          typename std::enable_if<impl::is_arithmetic_any<constrained_any<ConstrainAndOperationArgs...>>::value>::type* = nullptr>
+constrained_any<ConstrainAndOperationArgs...> operator*( const constrained_any<ConstrainAndOperationArgs...>& a, const constrained_any<ConstrainAndOperationArgs...>& b )
+{
+	return a.mul( b );
+}
+
+/**
+ * @brief copyable constrained_any that holds an arithmetic value and supports the arithmetic
+ */
+using arithmetic_any = constrained_any<impl::special_operation_copyable, impl::special_operation_arithmetic>;
+
+}   // namespace yan
+
+#endif
@@ -0,0 +1,273 @@
+/**
+ * @file constrained_any_format.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief special operation to format the value into the caller supplied buffer
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * special_operation_format adds format_to(), format_append() and to_string() to constrained_any.
+ * The text of the value is written by format_traits<T>. The arithmetic types are written by std::to_chars. Therefore, it does not depend on the locale,
+ * and format_to() and operator<< do not allocate memory for the value that fits to the inline buffer.
+ */
+
+#ifndef INC_CONSTRAINED_ANY_FORMAT_HPP_
+#define INC_CONSTRAINED_ANY_FORMAT_HPP_
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "constrained_any.hpp"
+
+namespace yan {
+
+namespace impl {
+
+/**
+ * @brief copy the text to the buffer as much as possible
+ *
+ * @return length of the text
+ */
+inline size_t format_copy_to( const char* p_src, size_t len, char* p_buff, size_t buff_size ) noexcept
+{
+	if ( p_buff != nullptr ) {
+		std::memcpy( p_buff, p_src, ( len < buff_size ) ? len : buff_size );
+	}
+	return len;
+}
+
+/**
+ * @brief enough size of the buffer for the text of any arithmetic type by std::to_chars
+ */
+constexpr size_t format_arithmetic_buff_size = 128;
+
+}   // namespace impl
+
+/**
+ * @brief customization point of the text of T
+ *
+ * Specialization of this class should have the following static member function.
+ * @li size_t format( const T& v, char* p_buff, size_t buff_size ) : write the text up to buff_size bytes to p_buff, and return the length of the whole text.
+ *
+ * Like std::snprintf(), the text is truncated if buff_size is smaller than the length of the text. No null terminator is written.
+ *
+ * This library provides the specializations for the arithmetic types, std::string, std::string_view and const char*.
+ */
+template <typename T, typename = void>
+struct format_traits {
+};
+
+template <typename T>
+struct format_traits<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value>::type> {
+	static size_t format( const T& v, char* p_buff, size_t buff_size ) noexcept
+	{
+		if ( buff_size >= impl::format_arithmetic_buff_size ) {
+			return static_cast<size_t>( std::to_chars( p_buff, p_buff + buff_size, v ).ptr - p_buff );
+		}
+		char   tmp[impl::format_arithmetic_buff_size];
+		size_t len = static_cast<size_t>( std::to_chars( tmp, tmp + sizeof( tmp ), v ).ptr - tmp );
+		return impl::format_copy_to( tmp, len, p_buff, buff_size );
+	}
+};
+
+template <typename T>
+struct format_traits<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+	static size_t format( const T& v, char* p_buff, size_t buff_size ) noexcept
+	{
+		char tmp[impl::format_arithmetic_buff_size];
+#if defined( __cpp_lib_to_chars )
+		size_t len = static_cast<size_t>( std::to_chars( tmp, tmp + sizeof( tmp ), v ).ptr - tmp );
+#else
+		// std::to_chars for floating point is not available. the shortest round trip form is not guaranteed.
+		int    ret = std::snprintf( tmp, sizeof( tmp ), "%.17Lg", static_cast<long double>( v ) );
+		size_t len = ( ret < 0 ) ? 0 : static_cast<size_t>( ret );
+#endif
+		return impl::format_copy_to( tmp, len, p_buff, buff_size );
+	}
+};
+
+template <>
+struct format_traits<bool> {
+	static size_t format( const bool& v, char* p_buff, size_t buff_size ) noexcept
+	{
+		return v ? impl::format_copy_to( "true", 4, p_buff, buff_size ) : impl::format_copy_to( "false", 5, p_buff, buff_size );
+	}
+};
+
+template <>
+struct format_traits<char> {
+	static size_t format( const char& v, char* p_buff, size_t buff_size ) noexcept
+	{
+		return impl::format_copy_to( &v, 1, p_buff, buff_size );
+	}
+};
+
+template <>
+struct format_traits<std::string_view> {
+	static size_t format( const std::string_view& v, char* p_buff, size_t buff_size ) noexcept
+	{
+		return impl::format_copy_to( v.data(), v.size(), p_buff, buff_size );
+	}
+};
+
+template <>
+struct format_traits<std::string> {
+	static size_t format( const std::string& v, char* p_buff, size_t buff_size ) noexcept
+	{
+		return impl::format_copy_to( v.data(), v.size(), p_buff, buff_size );
+	}
+};
+
+template <>
+struct format_traits<const char*> {
+	static size_t format( const char* const& v, char* p_buff, size_t buff_size ) noexcept
+	{
+		if ( v == nullptr ) {
+			return 0;
+		}
+		return impl::format_copy_to( v, std::strlen( v ), p_buff, buff_size );
+	}
+};
+
+template <>
+struct format_traits<char*> {
+	static size_t format( char* const& v, char* p_buff, size_t buff_size ) noexcept
+	{
+		return format_traits<const char*>::format( v, p_buff, buff_size );
+	}
+};
+
+namespace impl {
+
+template <typename T>
+struct is_formattable {
+	template <typename U>
+	static auto check( U* ) -> decltype( format_traits<U>::format( std::declval<const U&>(), std::declval<char*>(), std::declval<size_t>() ), std::true_type() );
+	template <typename U>
+	static auto check( ... ) -> std::false_type;
+
+	static constexpr bool value = decltype( check<T>( nullptr ) )::value;
+};
+
+class special_operation_format_if {
+public:
+	virtual ~special_operation_format_if() = default;
+
+	virtual size_t specialized_operation_format_proxy( const value_carrier_if_common& a, char* p_buff, size_t buff_size ) const = 0;
+};
+
+template <typename Carrier>
+class special_operation_format_dispatcher : public special_operation_format_if {
+private:
+	size_t specialized_operation_format_proxy( const value_carrier_if_common& a, char* p_buff, size_t buff_size ) const override
+	{
+		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
+			using value_t = typename impl::remove_cvref<typename Carrier::value_type>::type;
+			return format_traits<value_t>::format( static_cast<const Carrier&>( a ).ref(), p_buff, buff_size );
+		} else {
+			throw std::logic_error( "specialized_operation_format_proxy() is not implemented for constrained_any itself" );
+		}
+	}
+};
+
+/**
+ * @brief special operation to format the value
+ *
+ * The value type should have the specialization of format_traits.
+ * The empty constrained_any is formatted as the empty text.
+ */
+template <typename Carrier>
+class special_operation_format : public special_operation_dispatcher_base_t<Carrier, special_operation_format_dispatcher<Carrier>> {
+public:
+	static constexpr bool share_special_operation = true;
+	static constexpr bool constraint_check_result = !is_related_type_of_constrained_any<Carrier>::value &&
+	                                                is_formattable<Carrier>::value;
+
+	/**
+	 * @brief write the text of the value up to buff_size bytes to p_buff
+	 *
+	 * @return length of the whole text. If it is larger than buff_size, the text is truncated. No null terminator is written.
+	 */
+	template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	size_t format_to( char* p_buff, size_t buff_size ) const
+	{
+		const Carrier* p_a = static_cast<const Carrier*>( this );
+
+		const special_operation_format_if* p_a_soi = p_a->template get_special_operation_if<special_operation_format_if>();
+		if ( p_a_soi == nullptr ) {
+			return 0;
+		}
+		return p_a_soi->specialized_operation_format_proxy( p_a->get_value_carrier(), p_buff, buff_size );
+	}
+
+	/**
+	 * @brief append the text of the value to out
+	 *
+	 * If the capacity of out is enough, no memory allocation happens.
+	 */
+	template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	void format_append( std::string& out ) const
+	{
+		char   tmp[format_arithmetic_buff_size];
+		size_t len = format_to( tmp, sizeof( tmp ) );
+		if ( len <= sizeof( tmp ) ) {
+			out.append( tmp, len );
+			return;
+		}
+
+		size_t pos = out.size();
+		out.resize( pos + len );
+		format_to( &out[pos], len );
+	}
+
+	/**
+	 * @brief text of the value
+	 */
+	template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	std::string to_string( void ) const
+	{
+		std::string ans;
+		format_append( ans );
+		return ans;
+	}
+};
+
+}   // namespace impl
+
+/**
+ * @brief write the text of the value by impl::special_operation_format
+ */
+template <template <class> class... ConstrainAndOperationArgs,
+          typename std::enable_if<std::is_base_of<impl::special_operation_format<constrained_any<ConstrainAndOperationArgs...>>,
+                                                  constrained_any<ConstrainAndOperationArgs...>>::value>::type* = nullptr>
+std::ostream& operator<<( std::ostream& os, const constrained_any<ConstrainAndOperationArgs...>& a )
+{
+	char   tmp[impl::format_arithmetic_buff_size];
+	size_t len = a.format_to( tmp, sizeof( tmp ) );
+	if ( len <= sizeof( tmp ) ) {
+		return os.write( tmp, static_cast<std::streamsize>( len ) );
+	}
+
+	std::string str;
+	a.format_append( str );
+	return os.write( str.data(), static_cast<std::streamsize>( str.size() ) );
+}
+
+/**
+ * @brief copyable constrained_any that is able to be formatted
+ */
+using formattable_any = constrained_any<impl::special_operation_copyable, impl::special_operation_format>;
+
+}   // namespace yan
+
+#endif
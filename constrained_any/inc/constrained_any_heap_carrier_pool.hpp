@@ -0,0 +1,512 @@
+/**
+ * @file constrained_any_heap_carrier_pool.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief size class slab pool of value carriers in the heap
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * A value carrier that is not stored in the inline buffer is allocated in the heap.
+ * If the heap carrier pool is enabled, the value carrier is allocated from the blocks of size classes(16, 32, 64, ..., 4096 bytes) instead of global operator new.
+ *
+ * @li Each thread has a thread local free list for each size class. Allocation and deallocation without contention are served by it.
+ * @li If the thread local free list becomes long, a half of it is returned to the central free list. Then other threads reuse it.
+ *     Therefore, a block that is allocated by a thread and is deallocated by other thread(e.g. producer/consumer) is returned to the central free list in the end.
+ * @li If both of the thread local free list and the central free list are empty, new slab is allocated from the global operator new.
+ * @li Value carrier that is larger than 4096 bytes or is over-aligned is allocated by global operator new.
+ * @li Slabs are never released to the global operator delete.
+ *
+ * The heap carrier pool is enabled by below.
+ * @li per alias: add impl::special_operation_pooled_heap into the template parameter pack of constrained_any
+ * @li globally: define YAN_CONSTRAINED_ANY_ENABLE_HEAP_CARRIER_POOL before including constrained_any.hpp
+ *
+ * @warning
+ * YAN_CONSTRAINED_ANY_ENABLE_HEAP_CARRIER_POOL should be same in all translation units. Otherwise, it violates ODR.
+ */
+
+#ifndef INC_CONSTRAINED_ANY_HEAP_CARRIER_POOL_HPP_
+#define INC_CONSTRAINED_ANY_HEAP_CARRIER_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace yan {
+
+/**
+ * @brief snapshot of statistics of heap carrier pool
+ */
+struct heap_carrier_pool_stats {
+	size_t allocations_      = 0;   //!< number of allocations by the heap carrier pool. this includes fallbacks_.
+	size_t freelist_hits_    = 0;   //!< number of allocations that are served by the thread local free list
+	size_t central_refills_  = 0;   //!< number of refills of the thread local free list from the central free list
+	size_t slab_allocations_ = 0;   //!< number of slabs that are allocated by global operator new
+	size_t central_returns_  = 0;   //!< number of returns of the thread local free list to the central free list
+	size_t deallocations_    = 0;   //!< number of deallocations by the heap carrier pool. this includes fallbacks_.
+	size_t fallbacks_        = 0;   //!< number of allocations that are served by global operator new because of size or alignment
+
+	/**
+	 * @brief hit rate of the thread local free list
+	 *
+	 * @return freelist_hits_ / allocations_. If allocations_ is 0, return 0.
+	 */
+	double hit_rate( void ) const noexcept
+	{
+		if ( allocations_ == 0 ) {
+			return 0.0;
+		}
+		return static_cast<double>( freelist_hits_ ) / static_cast<double>( allocations_ );
+	}
+};
+
+namespace impl {
+
+constexpr size_t heap_carrier_pool_min_block_size  = 16;
+constexpr size_t heap_carrier_pool_num_of_classes  = 9;   // 16, 32, 64, 128, 256, 512, 1024, 2048, 4096
+constexpr size_t heap_carrier_pool_max_block_size  = heap_carrier_pool_min_block_size << ( heap_carrier_pool_num_of_classes - 1 );
+constexpr size_t heap_carrier_pool_blocks_per_slab = 32;
+constexpr size_t heap_carrier_pool_local_limit     = 64;   // if the thread local free list exceeds this, return heap_carrier_pool_return_batch blocks to the central free list
+constexpr size_t heap_carrier_pool_return_batch    = heap_carrier_pool_local_limit / 2;
+
+/**
+ * @brief size class index of the block that is not smaller than sz
+ *
+ * @pre sz <= heap_carrier_pool_max_block_size
+ */
+constexpr size_t heap_carrier_pool_size_class_of( size_t sz ) noexcept
+{
+	size_t idx        = 0;
+	size_t block_size = heap_carrier_pool_min_block_size;
+	while ( block_size < sz ) {
+		block_size <<= 1;
+		idx++;
+	}
+	return idx;
+}
+
+constexpr size_t heap_carrier_pool_block_size_of( size_t idx ) noexcept
+{
+	return heap_carrier_pool_min_block_size << idx;
+}
+
+enum class heap_carrier_pool_stat_id : size_t {
+	allocation,
+	freelist_hit,
+	central_refill,
+	slab_allocation,
+	central_return,
+	deallocation,
+	fallback,
+	num_of_ids
+};
+
+static constexpr size_t num_of_heap_carrier_pool_stats = static_cast<size_t>( heap_carrier_pool_stat_id::num_of_ids );
+
+struct heap_carrier_pool_free_block {
+	heap_carrier_pool_free_block* p_next_;
+};
+
+class heap_carrier_pool_thread_cache;
+
+/**
+ * @brief central free lists and slabs that are shared by all threads
+ *
+ * The singleton is never destructed, because a value carrier in a static variable may be deallocated after the other static variables are destructed.
+ */
+class heap_carrier_pool_central {
+public:
+	static heap_carrier_pool_central& get_instance( void )
+	{
+		static heap_carrier_pool_central* p_singleton = new heap_carrier_pool_central;
+		return *p_singleton;
+	}
+
+	/**
+	 * @brief push the chain of blocks to the central free list
+	 */
+	void push_chain( size_t idx, heap_carrier_pool_free_block* p_head, heap_carrier_pool_free_block* p_tail, size_t n ) noexcept
+	{
+		size_class_list&            cur = lists_[idx];
+		std::lock_guard<std::mutex> lk( cur.mtx_ );
+		p_tail->p_next_ = cur.p_head_;
+		cur.p_head_     = p_head;
+		cur.count_ += n;
+	}
+
+	/**
+	 * @brief pop the chain of blocks from the central free list
+	 *
+	 * @param idx size class index
+	 * @param max_n maximum number of blocks to pop
+	 * @param pp_head [out] head of the popped chain. the tail of it is nullptr terminated.
+	 * @return number of popped blocks. 0 means that the central free list is empty.
+	 */
+	size_t pop_chain( size_t idx, size_t max_n, heap_carrier_pool_free_block** pp_head ) noexcept
+	{
+		size_class_list&            cur = lists_[idx];
+		std::lock_guard<std::mutex> lk( cur.mtx_ );
+		heap_carrier_pool_free_block* p_head = cur.p_head_;
+		heap_carrier_pool_free_block* p_tail = nullptr;
+		size_t                        n      = 0;
+		for ( heap_carrier_pool_free_block* p = p_head; ( p != nullptr ) && ( n < max_n ); p = p->p_next_ ) {
+			p_tail = p;
+			n++;
+		}
+		if ( p_tail != nullptr ) {
+			cur.p_head_     = p_tail->p_next_;
+			p_tail->p_next_ = nullptr;
+			cur.count_ -= n;
+		}
+		*pp_head = p_head;
+		return n;
+	}
+
+	/**
+	 * @brief allocate new slab and carve it to the chain of blocks
+	 *
+	 * @return head of the chain of heap_carrier_pool_blocks_per_slab blocks. the tail of it is nullptr terminated.
+	 *
+	 * @exception std::bad_alloc if global operator new fails
+	 */
+	heap_carrier_pool_free_block* allocate_slab( size_t idx )
+	{
+		const size_t   block_size = heap_carrier_pool_block_size_of( idx );
+		unsigned char* p_slab     = static_cast<unsigned char*>( ::operator new( block_size * heap_carrier_pool_blocks_per_slab ) );
+		{
+			std::lock_guard<std::mutex> lk( slabs_mtx_ );
+			try {
+				slabs_.push_back( p_slab );
+			} catch ( ... ) {
+				::operator delete( p_slab );
+				throw;
+			}
+		}
+
+		heap_carrier_pool_free_block* p_head = nullptr;
+		for ( size_t i = heap_carrier_pool_blocks_per_slab; i > 0; i-- ) {
+			heap_carrier_pool_free_block* p_cur = reinterpret_cast<heap_carrier_pool_free_block*>( p_slab + block_size * ( i - 1 ) );
+			p_cur->p_next_                      = p_head;
+			p_head                              = p_cur;
+		}
+		return p_head;
+	}
+
+	void register_cache( heap_carrier_pool_thread_cache* p ) noexcept;
+	void unregister_cache( heap_carrier_pool_thread_cache* p ) noexcept;
+	void aggregate( size_t* p_counts ) noexcept;
+	void reset( void ) noexcept;
+
+	/**
+	 * @brief count the event of the thread that has no thread local cache(e.g. during thread exit)
+	 */
+	void count_direct( heap_carrier_pool_stat_id id ) noexcept
+	{
+		direct_counts_[static_cast<size_t>( id )].fetch_add( 1, std::memory_order_relaxed );
+	}
+
+private:
+	struct size_class_list {
+		std::mutex                    mtx_;
+		heap_carrier_pool_free_block* p_head_ = nullptr;
+		size_t                        count_  = 0;
+	};
+
+	heap_carrier_pool_central() = default;
+
+	size_class_list lists_[heap_carrier_pool_num_of_classes];
+
+	std::mutex                  slabs_mtx_;
+	std::vector<unsigned char*> slabs_;   // keep slabs reachable. they are never released.
+
+	std::mutex                                   stats_mtx_;
+	std::vector<heap_carrier_pool_thread_cache*> live_caches_;
+	size_t                                       retired_counts_[num_of_heap_carrier_pool_stats] {};
+	std::atomic<size_t>                          direct_counts_[num_of_heap_carrier_pool_stats] {};
+};
+
+/**
+ * @brief thread local free lists
+ *
+ * Only the owner thread updates free lists and statistics counters. Therefore, update of counters is load and store without read-modify-write.
+ * atomic is required only for the aggregation by other threads.
+ */
+class heap_carrier_pool_thread_cache {
+public:
+	heap_carrier_pool_thread_cache() noexcept
+	{
+		heap_carrier_pool_central::get_instance().register_cache( this );
+	}
+
+	~heap_carrier_pool_thread_cache()
+	{
+		heap_carrier_pool_central& central = heap_carrier_pool_central::get_instance();
+		for ( size_t idx = 0; idx < heap_carrier_pool_num_of_classes; idx++ ) {
+			if ( p_heads_[idx] == nullptr ) {
+				continue;
+			}
+			heap_carrier_pool_free_block* p_tail = p_heads_[idx];
+			while ( p_tail->p_next_ != nullptr ) {
+				p_tail = p_tail->p_next_;
+			}
+			central.push_chain( idx, p_heads_[idx], p_tail, counts_[idx] );
+			count( heap_carrier_pool_stat_id::central_return );
+		}
+		central.unregister_cache( this );
+		is_destructed() = true;
+	}
+
+	void* allocate( size_t idx )
+	{
+		count( heap_carrier_pool_stat_id::allocation );
+		if ( p_heads_[idx] != nullptr ) {
+			count( heap_carrier_pool_stat_id::freelist_hit );
+			return pop( idx );
+		}
+
+		heap_carrier_pool_central&    central = heap_carrier_pool_central::get_instance();
+		heap_carrier_pool_free_block* p_chain = nullptr;
+		size_t                        n       = central.pop_chain( idx, heap_carrier_pool_return_batch, &p_chain );
+		if ( n > 0 ) {
+			count( heap_carrier_pool_stat_id::central_refill );
+		} else {
+			p_chain = central.allocate_slab( idx );
+			n       = heap_carrier_pool_blocks_per_slab;
+			count( heap_carrier_pool_stat_id::slab_allocation );
+		}
+		p_heads_[idx] = p_chain;
+		counts_[idx]  = n;
+		return pop( idx );
+	}
+
+	void deallocate( void* p, size_t idx ) noexcept
+	{
+		count( heap_carrier_pool_stat_id::deallocation );
+		heap_carrier_pool_free_block* p_block = static_cast<heap_carrier_pool_free_block*>( p );
+		p_block->p_next_                      = p_heads_[idx];
+		p_heads_[idx]                         = p_block;
+		counts_[idx]++;
+		if ( counts_[idx] <= heap_carrier_pool_local_limit ) {
+			return;
+		}
+
+		// return the first heap_carrier_pool_return_batch blocks, because the remaining blocks are older and colder.
+		heap_carrier_pool_free_block* p_head = p_heads_[idx];
+		heap_carrier_pool_free_block* p_tail = p_head;
+		for ( size_t i = 1; i < heap_carrier_pool_return_batch; i++ ) {
+			p_tail = p_tail->p_next_;
+		}
+		p_heads_[idx] = p_tail->p_next_;
+		counts_[idx] -= heap_carrier_pool_return_batch;
+		heap_carrier_pool_central::get_instance().push_chain( idx, p_head, p_tail, heap_carrier_pool_return_batch );
+		count( heap_carrier_pool_stat_id::central_return );
+	}
+
+	void count( heap_carrier_pool_stat_id id ) noexcept
+	{
+		std::atomic<size_t>& cnt = stats_[static_cast<size_t>( id )];
+		cnt.store( cnt.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+	}
+
+	static bool& is_destructed( void ) noexcept
+	{
+		thread_local bool flag = false;
+		return flag;
+	}
+
+	std::atomic<size_t> stats_[num_of_heap_carrier_pool_stats] {};
+
+private:
+	void* pop( size_t idx ) noexcept
+	{
+		heap_carrier_pool_free_block* p_ans = p_heads_[idx];
+		p_heads_[idx]                       = p_ans->p_next_;
+		counts_[idx]--;
+		return p_ans;
+	}
+
+	heap_carrier_pool_free_block* p_heads_[heap_carrier_pool_num_of_classes] {};
+	size_t                        counts_[heap_carrier_pool_num_of_classes] {};
+};
+
+inline void heap_carrier_pool_central::register_cache( heap_carrier_pool_thread_cache* p ) noexcept
+{
+	std::lock_guard<std::mutex> lk( stats_mtx_ );
+	try {
+		live_caches_.push_back( p );
+	} catch ( ... ) {
+		// statistics of this thread are aggregated only after the thread exit.
+	}
+}
+
+inline void heap_carrier_pool_central::unregister_cache( heap_carrier_pool_thread_cache* p ) noexcept
+{
+	std::lock_guard<std::mutex> lk( stats_mtx_ );
+	for ( size_t i = 0; i < num_of_heap_carrier_pool_stats; i++ ) {
+		retired_counts_[i] += p->stats_[i].load( std::memory_order_relaxed );
+	}
+	live_caches_.erase( std::remove( live_caches_.begin(), live_caches_.end(), p ), live_caches_.end() );
+}
+
+inline void heap_carrier_pool_central::aggregate( size_t* p_counts ) noexcept
+{
+	std::lock_guard<std::mutex> lk( stats_mtx_ );
+	for ( size_t i = 0; i < num_of_heap_carrier_pool_stats; i++ ) {
+		p_counts[i] = retired_counts_[i] + direct_counts_[i].load( std::memory_order_relaxed );
+		for ( auto p : live_caches_ ) {
+			p_counts[i] += p->stats_[i].load( std::memory_order_relaxed );
+		}
+	}
+}
+
+inline void heap_carrier_pool_central::reset( void ) noexcept
+{
+	std::lock_guard<std::mutex> lk( stats_mtx_ );
+	for ( size_t i = 0; i < num_of_heap_carrier_pool_stats; i++ ) {
+		retired_counts_[i] = 0;
+		direct_counts_[i].store( 0, std::memory_order_relaxed );
+		for ( auto p : live_caches_ ) {
+			p->stats_[i].store( 0, std::memory_order_relaxed );
+		}
+	}
+}
+
+/**
+ * @brief get the thread local cache of the current thread
+ *
+ * @return pointer to the thread local cache. If the thread local cache has already been destructed in thread exit, return nullptr.
+ */
+inline heap_carrier_pool_thread_cache* get_heap_carrier_pool_thread_cache( void ) noexcept
+{
+	if ( heap_carrier_pool_thread_cache::is_destructed() ) {
+		return nullptr;
+	}
+	thread_local heap_carrier_pool_thread_cache tl_cache;
+	return &tl_cache;
+}
+
+inline void* heap_carrier_pool_allocate( size_t sz )
+{
+	if ( sz > heap_carrier_pool_max_block_size ) {
+		heap_carrier_pool_thread_cache* p_cache = get_heap_carrier_pool_thread_cache();
+		if ( p_cache != nullptr ) {
+			p_cache->count( heap_carrier_pool_stat_id::allocation );
+			p_cache->count( heap_carrier_pool_stat_id::fallback );
+		}
+		return ::operator new( sz );
+	}
+
+	const size_t                    idx     = heap_carrier_pool_size_class_of( sz );
+	heap_carrier_pool_thread_cache* p_cache = get_heap_carrier_pool_thread_cache();
+	if ( p_cache != nullptr ) {
+		return p_cache->allocate( idx );
+	}
+
+	// thread local cache is not available. use the central free list directly.
+	heap_carrier_pool_central& central = heap_carrier_pool_central::get_instance();
+	central.count_direct( heap_carrier_pool_stat_id::allocation );
+	heap_carrier_pool_free_block* p_ans = nullptr;
+	if ( central.pop_chain( idx, 1, &p_ans ) == 0 ) {
+		p_ans = central.allocate_slab( idx );
+		central.count_direct( heap_carrier_pool_stat_id::slab_allocation );
+
+		// keep the first block, and push the remaining blocks to the central free list
+		heap_carrier_pool_free_block* p_tail = p_ans->p_next_;
+		while ( p_tail->p_next_ != nullptr ) {
+			p_tail = p_tail->p_next_;
+		}
+		central.push_chain( idx, p_ans->p_next_, p_tail, heap_carrier_pool_blocks_per_slab - 1 );
+	}
+	return p_ans;
+}
+
+/**
+ * @brief allocate over-aligned value carrier by global operator new
+ */
+inline void* heap_carrier_pool_allocate_over_aligned( size_t sz, std::align_val_t al )
+{
+	heap_carrier_pool_thread_cache* p_cache = get_heap_carrier_pool_thread_cache();
+	if ( p_cache != nullptr ) {
+		p_cache->count( heap_carrier_pool_stat_id::allocation );
+		p_cache->count( heap_carrier_pool_stat_id::fallback );
+	}
+	return ::operator new( sz, al );
+}
+
+inline void heap_carrier_pool_deallocate_over_aligned( void* p, std::align_val_t al ) noexcept
+{
+	heap_carrier_pool_thread_cache* p_cache = get_heap_carrier_pool_thread_cache();
+	if ( p_cache != nullptr ) {
+		p_cache->count( heap_carrier_pool_stat_id::deallocation );
+	}
+	::operator delete( p, al );
+}
+
+inline void heap_carrier_pool_deallocate( void* p, size_t sz ) noexcept
+{
+	if ( sz > heap_carrier_pool_max_block_size ) {
+		heap_carrier_pool_thread_cache* p_cache = get_heap_carrier_pool_thread_cache();
+		if ( p_cache != nullptr ) {
+			p_cache->count( heap_carrier_pool_stat_id::deallocation );
+		}
+		::operator delete( p );
+		return;
+	}
+
+	const size_t                    idx     = heap_carrier_pool_size_class_of( sz );
+	heap_carrier_pool_thread_cache* p_cache = get_heap_carrier_pool_thread_cache();
+	if ( p_cache != nullptr ) {
+		p_cache->deallocate( p, idx );
+		return;
+	}
+
+	heap_carrier_pool_central& central = heap_carrier_pool_central::get_instance();
+	central.count_direct( heap_carrier_pool_stat_id::deallocation );
+	heap_carrier_pool_free_block* p_block = static_cast<heap_carrier_pool_free_block*>( p );
+	central.push_chain( idx, p_block, p_block, 1 );
+}
+
+}   // namespace impl
+
+/**
+ * @brief aggregate statistics of heap carrier pool of all threads
+ *
+ * @return sum of statistics of all live threads and exited threads.
+ *
+ * @note
+ * Statistics of other threads may be stale under concurrent operations.
+ */
+inline heap_carrier_pool_stats get_heap_carrier_pool_stats( void ) noexcept
+{
+	size_t counts[impl::num_of_heap_carrier_pool_stats];
+	impl::heap_carrier_pool_central::get_instance().aggregate( counts );
+
+	heap_carrier_pool_stats ans;
+	ans.allocations_      = counts[static_cast<size_t>( impl::heap_carrier_pool_stat_id::allocation )];
+	ans.freelist_hits_    = counts[static_cast<size_t>( impl::heap_carrier_pool_stat_id::freelist_hit )];
+	ans.central_refills_  = counts[static_cast<size_t>( impl::heap_carrier_pool_stat_id::central_refill )];
+	ans.slab_allocations_ = counts[static_cast<size_t>( impl::heap_carrier_pool_stat_id::slab_allocation )];
+	ans.central_returns_  = counts[static_cast<size_t>( impl::heap_carrier_pool_stat_id::central_return )];
+	ans.deallocations_    = counts[static_cast<size_t>( impl::heap_carrier_pool_stat_id::deallocation )];
+	ans.fallbacks_        = counts[static_cast<size_t>( impl::heap_carrier_pool_stat_id::fallback )];
+	return ans;
+}
+
+/**
+ * @brief reset statistics of heap carrier pool of all threads to zero
+ *
+ * @note
+ * If other threads update their statistics at the same time, that update may be lost.
+ */
+inline void reset_heap_carrier_pool_stats( void ) noexcept
+{
+	impl::heap_carrier_pool_central::get_instance().reset();
+}
+
+}   // namespace yan
+
+#endif
@@ -0,0 +1,261 @@
+/**
+ * @file constrained_any_instrumentation.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief opt-in instrumentation counters of constrained_any
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * If YAN_CONSTRAINED_ANY_ENABLE_INSTRUMENTATION is defined before including constrained_any.hpp, constrained_any counts below events:
+ * @li construction of value carrier in the inline buffer or in the heap
+ * @li heap bytes of the value carriers
+ * @li clone by copy construction
+ * @li same type assignment and type changing reconstruction
+ * @li destruction of value carrier
+ *
+ * Each thread counts in its own thread local counters, and get_instrumentation_counters() aggregates them on demand.
+ * If the macro is not defined, all counting hooks are empty and get_instrumentation_counters() returns zeros.
+ *
+ * @warning
+ * YAN_CONSTRAINED_ANY_ENABLE_INSTRUMENTATION should be same in all translation units. Otherwise, it violates ODR.
+ */
+
+#ifndef INC_CONSTRAINED_ANY_INSTRUMENTATION_HPP_
+#define INC_CONSTRAINED_ANY_INSTRUMENTATION_HPP_
+
+#include <cstddef>
+
+#ifdef YAN_CONSTRAINED_ANY_ENABLE_INSTRUMENTATION
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace yan {
+
+/**
+ * @brief snapshot of instrumentation counters
+ */
+struct instrumentation_counters {
+	size_t inline_constructions_       = 0;   //!< number of value carriers that are constructed out of the heap. this includes temporary carrier on stack.
+	size_t heap_constructions_         = 0;   //!< number of value carriers that are allocated in the heap
+	size_t heap_bytes_                 = 0;   //!< total bytes of value carriers that are allocated in the heap
+	size_t clones_                     = 0;   //!< number of value carriers that are constructed by copy construction
+	size_t same_type_assigns_          = 0;   //!< number of assignments that keep the stored type
+	size_t type_changing_reconstructs_ = 0;   //!< number of assignments, emplace() and reset() that change the stored type
+	size_t destructions_               = 0;   //!< number of value carriers that are destructed
+};
+
+#ifdef YAN_CONSTRAINED_ANY_ENABLE_INSTRUMENTATION
+static constexpr bool is_instrumentation_enabled = true;
+#else
+static constexpr bool is_instrumentation_enabled = false;
+#endif
+
+namespace impl {
+
+enum class instrumentation_counter_id : size_t {
+	inline_construction,
+	heap_construction,
+	heap_bytes,
+	clone,
+	same_type_assign,
+	type_changing_reconstruct,
+	destruction,
+	num_of_ids
+};
+
+static constexpr size_t num_of_instrumentation_counters = static_cast<size_t>( instrumentation_counter_id::num_of_ids );
+
+#ifdef YAN_CONSTRAINED_ANY_ENABLE_INSTRUMENTATION
+
+class instrumentation_registry;
+
+/**
+ * @brief counters of each thread
+ *
+ * Only the owner thread updates counters. Therefore, update is load and store without read-modify-write.
+ * atomic is required only for the aggregation by other threads.
+ */
+struct instrumentation_thread_local_counters {
+	instrumentation_thread_local_counters();
+	~instrumentation_thread_local_counters();
+
+	void add( instrumentation_counter_id id, size_t v ) noexcept
+	{
+		std::atomic<size_t>& cnt = counts_[static_cast<size_t>( id )];
+		cnt.store( cnt.load( std::memory_order_relaxed ) + v, std::memory_order_relaxed );
+	}
+
+	std::atomic<size_t> counts_[num_of_instrumentation_counters] {};
+};
+
+class instrumentation_registry {
+public:
+	static instrumentation_registry& get_instance( void )
+	{
+		static instrumentation_registry singleton;
+		return singleton;
+	}
+
+	void register_counters( instrumentation_thread_local_counters* p )
+	{
+		std::lock_guard<std::mutex> lk( mtx_ );
+		live_counters_.push_back( p );
+	}
+
+	void unregister_counters( instrumentation_thread_local_counters* p ) noexcept
+	{
+		std::lock_guard<std::mutex> lk( mtx_ );
+		for ( size_t i = 0; i < num_of_instrumentation_counters; i++ ) {
+			retired_counts_[i] += p->counts_[i].load( std::memory_order_relaxed );
+		}
+		live_counters_.erase( std::remove( live_counters_.begin(), live_counters_.end(), p ), live_counters_.end() );
+	}
+
+	void aggregate( size_t* p_counts ) noexcept
+	{
+		std::lock_guard<std::mutex> lk( mtx_ );
+		for ( size_t i = 0; i < num_of_instrumentation_counters; i++ ) {
+			p_counts[i] = retired_counts_[i];
+			for ( auto p : live_counters_ ) {
+				p_counts[i] += p->counts_[i].load( std::memory_order_relaxed );
+			}
+		}
+	}
+
+	void reset( void ) noexcept
+	{
+		std::lock_guard<std::mutex> lk( mtx_ );
+		for ( size_t i = 0; i < num_of_instrumentation_counters; i++ ) {
+			retired_counts_[i] = 0;
+			for ( auto p : live_counters_ ) {
+				p->counts_[i].store( 0, std::memory_order_relaxed );
+			}
+		}
+	}
+
+private:
+	instrumentation_registry() = default;
+
+	std::mutex                                          mtx_;
+	std::vector<instrumentation_thread_local_counters*> live_counters_;
+	size_t                                              retired_counts_[num_of_instrumentation_counters] {};
+};
+
+inline instrumentation_thread_local_counters::instrumentation_thread_local_counters()
+{
+	instrumentation_registry::get_instance().register_counters( this );
+}
+
+inline instrumentation_thread_local_counters::~instrumentation_thread_local_counters()
+{
+	instrumentation_registry::get_instance().unregister_counters( this );
+}
+
+inline instrumentation_thread_local_counters& get_thread_local_instrumentation_counters( void )
+{
+	thread_local instrumentation_thread_local_counters tl_counters;
+	return tl_counters;
+}
+
+#endif   // YAN_CONSTRAINED_ANY_ENABLE_INSTRUMENTATION
+
+inline void instrumentation_count( instrumentation_counter_id id, size_t v = 1 ) noexcept
+{
+#ifdef YAN_CONSTRAINED_ANY_ENABLE_INSTRUMENTATION
+	get_thread_local_instrumentation_counters().add( id, v );
+#endif
+}
+
+/**
+ * @brief base class of value carrier to count construction, clone and destruction of it
+ *
+ * @tparam Carrier value carrier class
+ * @tparam HasInlineBuffer true if constrained_any has the inline buffer. In this case, Carrier::is_possible_sso decides the storage class.
+ */
+template <typename Carrier, bool HasInlineBuffer>
+struct carrier_instrumentation_probe {
+#ifdef YAN_CONSTRAINED_ANY_ENABLE_INSTRUMENTATION
+	~carrier_instrumentation_probe()
+	{
+		instrumentation_count( instrumentation_counter_id::destruction );
+	}
+	carrier_instrumentation_probe() noexcept
+	{
+		count_construction();
+	}
+	carrier_instrumentation_probe( const carrier_instrumentation_probe& ) noexcept
+	{
+		count_construction();
+		instrumentation_count( instrumentation_counter_id::clone );
+	}
+	carrier_instrumentation_probe( carrier_instrumentation_probe&& ) noexcept
+	{
+		count_construction();
+	}
+	carrier_instrumentation_probe& operator=( const carrier_instrumentation_probe& ) = default;
+	carrier_instrumentation_probe& operator=( carrier_instrumentation_probe&& )      = default;
+
+private:
+	static void count_construction( void ) noexcept
+	{
+		if constexpr ( HasInlineBuffer ) {
+			if constexpr ( Carrier::is_possible_sso ) {
+				instrumentation_count( instrumentation_counter_id::inline_construction );
+				return;
+			}
+		}
+		instrumentation_count( instrumentation_counter_id::heap_construction );
+		instrumentation_count( instrumentation_counter_id::heap_bytes, sizeof( Carrier ) );
+	}
+#endif
+};
+
+}   // namespace impl
+
+/**
+ * @brief aggregate instrumentation counters of all threads
+ *
+ * @return sum of counters of all live threads and exited threads. If YAN_CONSTRAINED_ANY_ENABLE_INSTRUMENTATION is not defined, all counters are zero.
+ *
+ * @note
+ * Counters of other threads may be stale under concurrent operations.
+ */
+inline instrumentation_counters get_instrumentation_counters( void ) noexcept
+{
+	instrumentation_counters ans;
+#ifdef YAN_CONSTRAINED_ANY_ENABLE_INSTRUMENTATION
+	size_t counts[impl::num_of_instrumentation_counters];
+	impl::instrumentation_registry::get_instance().aggregate( counts );
+
+	ans.inline_constructions_       = counts[static_cast<size_t>( impl::instrumentation_counter_id::inline_construction )];
+	ans.heap_constructions_         = counts[static_cast<size_t>( impl::instrumentation_counter_id::heap_construction )];
+	ans.heap_bytes_                 = counts[static_cast<size_t>( impl::instrumentation_counter_id::heap_bytes )];
+	ans.clones_                     = counts[static_cast<size_t>( impl::instrumentation_counter_id::clone )];
+	ans.same_type_assigns_          = counts[static_cast<size_t>( impl::instrumentation_counter_id::same_type_assign )];
+	ans.type_changing_reconstructs_ = counts[static_cast<size_t>( impl::instrumentation_counter_id::type_changing_reconstruct )];
+	ans.destructions_               = counts[static_cast<size_t>( impl::instrumentation_counter_id::destruction )];
+#endif
+	return ans;
+}
+
+/**
+ * @brief reset instrumentation counters of all threads to zero
+ *
+ * @note
+ * If other threads update their counters at the same time, that update may be lost.
+ */
+inline void reset_instrumentation_counters( void ) noexcept
+{
+#ifdef YAN_CONSTRAINED_ANY_ENABLE_INSTRUMENTATION
+	impl::instrumentation_registry::get_instance().reset();
+#endif
+}
+
+}   // namespace yan
+
+#endif
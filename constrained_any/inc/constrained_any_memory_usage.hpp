@@ -0,0 +1,403 @@
+/**
+ * @file constrained_any_memory_usage.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief special operation to report the memory usage of constrained_any and its value
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * special_operation_memory_usage adds memory_usage() to constrained_any. It reports three parts of the memory.
+ * @li inline bytes: sizeof constrained_any itself. The value in the inline buffer is included in it.
+ * @li heap carrier bytes: size of the value carrier if it is stored in the heap.
+ * @li payload heap bytes: memory that the value allocates by itself, e.g. the buffer of std::string. This is reported by memory_usage_traits<T>.
+ *
+ * memory_usage_accumulator keeps the sum of memory usage of the values in the container, and is updated on each insertion and removal.
+ */
+
+#ifndef INC_CONSTRAINED_ANY_MEMORY_USAGE_HPP_
+#define INC_CONSTRAINED_ANY_MEMORY_USAGE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "constrained_any.hpp"
+
+namespace yan {
+
+/**
+ * @brief customization point of the memory that the value of T allocates by itself
+ *
+ * Specialization of this class should have the following static member function.
+ * @li size_t heap_bytes( const T& v ) : bytes of the memory that v allocates. sizeof( T ) is not included.
+ *
+ * Primary template reports 0. This library provides the specializations for std::basic_string, std::vector, std::deque, std::list, std::forward_list,
+ * std::map, std::multimap, std::set, std::multiset, std::unordered_map, std::unordered_multimap, std::unordered_set, std::unordered_multiset,
+ * std::array and std::pair. The elements are counted recursively.
+ *
+ * @note
+ * The node size of the node based containers is the estimation from the usual implementation, i.e. the value with the pointers to link the nodes.
+ * The overhead of the memory allocator is not included.
+ */
+template <typename T, typename = void>
+struct memory_usage_traits {
+	static constexpr size_t heap_bytes( const T& ) noexcept
+	{
+		return 0;
+	}
+};
+
+namespace impl {
+
+template <typename T>
+size_t memory_usage_heap_bytes_of( const T& v ) noexcept
+{
+	return memory_usage_traits<T>::heap_bytes( v );
+}
+
+template <typename T>
+struct has_trivial_memory_usage {
+	static constexpr bool value = std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value;
+};
+
+template <typename Container>
+size_t memory_usage_elements_heap_bytes( const Container& c ) noexcept
+{
+	using value_t = typename Container::value_type;
+	if constexpr ( has_trivial_memory_usage<value_t>::value ) {
+		return 0;
+	} else {
+		size_t ans = 0;
+		for ( const auto& e : c ) {
+			ans += memory_usage_heap_bytes_of<value_t>( e );
+		}
+		return ans;
+	}
+}
+
+/**
+ * @brief estimated bytes of the nodes of the node based container
+ *
+ * @param num_of_links number of pointers in each node
+ * @param extra_bytes additional bytes in each node, e.g. the cached hash value
+ */
+template <typename Container>
+size_t memory_usage_nodes_heap_bytes( const Container& c, size_t num_of_links, size_t extra_bytes ) noexcept
+{
+	using value_t = typename Container::value_type;
+	return c.size() * ( sizeof( value_t ) + num_of_links * sizeof( void* ) + extra_bytes ) + memory_usage_elements_heap_bytes( c );
+}
+
+}   // namespace impl
+
+template <typename CharT, typename Traits, typename Allocator>
+struct memory_usage_traits<std::basic_string<CharT, Traits, Allocator>> {
+	static size_t heap_bytes( const std::basic_string<CharT, Traits, Allocator>& v ) noexcept
+	{
+		// short string is stored in the object itself
+		const char* p_data = reinterpret_cast<const char*>( v.data() );
+		const char* p_obj  = reinterpret_cast<const char*>( &v );
+		if ( ( p_obj <= p_data ) && ( p_data < p_obj + sizeof( v ) ) ) {
+			return 0;
+		}
+		return ( v.capacity() + 1 ) * sizeof( CharT );
+	}
+};
+
+template <typename T, typename Allocator>
+struct memory_usage_traits<std::vector<T, Allocator>> {
+	static size_t heap_bytes( const std::vector<T, Allocator>& v ) noexcept
+	{
+		if constexpr ( std::is_same<T, bool>::value ) {
+			return ( v.capacity() + 7 ) / 8;
+		} else {
+			return v.capacity() * sizeof( T ) + impl::memory_usage_elements_heap_bytes( v );
+		}
+	}
+};
+
+template <typename T, typename Allocator>
+struct memory_usage_traits<std::deque<T, Allocator>> {
+	static size_t heap_bytes( const std::deque<T, Allocator>& v ) noexcept
+	{
+		// blocks of 512 bytes or one element, and the map of the pointers to the blocks
+		constexpr size_t elements_per_block = ( sizeof( T ) < 512 ) ? ( 512 / sizeof( T ) ) : 1;
+		size_t           num_of_blocks      = v.size() / elements_per_block + 1;
+		return num_of_blocks * ( elements_per_block * sizeof( T ) + sizeof( void* ) ) + impl::memory_usage_elements_heap_bytes( v );
+	}
+};
+
+template <typename T, typename Allocator>
+struct memory_usage_traits<std::list<T, Allocator>> {
+	static size_t heap_bytes( const std::list<T, Allocator>& v ) noexcept
+	{
+		return impl::memory_usage_nodes_heap_bytes( v, 2, 0 );
+	}
+};
+
+template <typename T, typename Allocator>
+struct memory_usage_traits<std::forward_list<T, Allocator>> {
+	static size_t heap_bytes( const std::forward_list<T, Allocator>& v ) noexcept
+	{
+		size_t ans = 0;
+		for ( const auto& e : v ) {
+			ans += sizeof( T ) + sizeof( void* ) + impl::memory_usage_heap_bytes_of<T>( e );
+		}
+		return ans;
+	}
+};
+
+// node of red-black tree has the color and 3 pointers(parent, left and right)
+template <typename Key, typename T, typename Compare, typename Allocator>
+struct memory_usage_traits<std::map<Key, T, Compare, Allocator>> {
+	static size_t heap_bytes( const std::map<Key, T, Compare, Allocator>& v ) noexcept
+	{
+		return impl::memory_usage_nodes_heap_bytes( v, 4, 0 );
+	}
+};
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+struct memory_usage_traits<std::multimap<Key, T, Compare, Allocator>> {
+	static size_t heap_bytes( const std::multimap<Key, T, Compare, Allocator>& v ) noexcept
+	{
+		return impl::memory_usage_nodes_heap_bytes( v, 4, 0 );
+	}
+};
+
+template <typename Key, typename Compare, typename Allocator>
+struct memory_usage_traits<std::set<Key, Compare, Allocator>> {
+	static size_t heap_bytes( const std::set<Key, Compare, Allocator>& v ) noexcept
+	{
+		return impl::memory_usage_nodes_heap_bytes( v, 4, 0 );
+	}
+};
+
+template <typename Key, typename Compare, typename Allocator>
+struct memory_usage_traits<std::multiset<Key, Compare, Allocator>> {
+	static size_t heap_bytes( const std::multiset<Key, Compare, Allocator>& v ) noexcept
+	{
+		return impl::memory_usage_nodes_heap_bytes( v, 4, 0 );
+	}
+};
+
+// node of hash table has the pointer to the next node and the cached hash value, and the bucket array has a pointer per bucket
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+struct memory_usage_traits<std::unordered_map<Key, T, Hash, KeyEqual, Allocator>> {
+	static size_t heap_bytes( const std::unordered_map<Key, T, Hash, KeyEqual, Allocator>& v ) noexcept
+	{
+		return v.bucket_count() * sizeof( void* ) + impl::memory_usage_nodes_heap_bytes( v, 1, sizeof( size_t ) );
+	}
+};
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+struct memory_usage_traits<std::unordered_multimap<Key, T, Hash, KeyEqual, Allocator>> {
+	static size_t heap_bytes( const std::unordered_multimap<Key, T, Hash, KeyEqual, Allocator>& v ) noexcept
+	{
+		return v.bucket_count() * sizeof( void* ) + impl::memory_usage_nodes_heap_bytes( v, 1, sizeof( size_t ) );
+	}
+};
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+struct memory_usage_traits<std::unordered_set<Key, Hash, KeyEqual, Allocator>> {
+	static size_t heap_bytes( const std::unordered_set<Key, Hash, KeyEqual, Allocator>& v ) noexcept
+	{
+		return v.bucket_count() * sizeof( void* ) + impl::memory_usage_nodes_heap_bytes( v, 1, sizeof( size_t ) );
+	}
+};
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+struct memory_usage_traits<std::unordered_multiset<Key, Hash, KeyEqual, Allocator>> {
+	static size_t heap_bytes( const std::unordered_multiset<Key, Hash, KeyEqual, Allocator>& v ) noexcept
+	{
+		return v.bucket_count() * sizeof( void* ) + impl::memory_usage_nodes_heap_bytes( v, 1, sizeof( size_t ) );
+	}
+};
+
+template <typename T, size_t N>
+struct memory_usage_traits<std::array<T, N>> {
+	static size_t heap_bytes( const std::array<T, N>& v ) noexcept
+	{
+		return impl::memory_usage_elements_heap_bytes( v );
+	}
+};
+
+template <typename T1, typename T2>
+struct memory_usage_traits<std::pair<T1, T2>> {
+	static size_t heap_bytes( const std::pair<T1, T2>& v ) noexcept
+	{
+		return impl::memory_usage_heap_bytes_of<typename std::remove_const<T1>::type>( v.first ) +
+		       impl::memory_usage_heap_bytes_of<typename std::remove_const<T2>::type>( v.second );
+	}
+};
+
+/**
+ * @brief memory usage of constrained_any
+ */
+struct memory_usage {
+	size_t inline_bytes_       = 0;   //!< sizeof constrained_any. the value in the inline buffer is included
+	size_t heap_carrier_bytes_ = 0;   //!< size of the value carrier in the heap. 0 if the value is in the inline buffer
+	size_t payload_heap_bytes_ = 0;   //!< memory that the value allocates by itself
+
+	size_t total_bytes( void ) const noexcept
+	{
+		return inline_bytes_ + heap_carrier_bytes_ + payload_heap_bytes_;
+	}
+
+	memory_usage& operator+=( const memory_usage& rhs ) noexcept
+	{
+		inline_bytes_ += rhs.inline_bytes_;
+		heap_carrier_bytes_ += rhs.heap_carrier_bytes_;
+		payload_heap_bytes_ += rhs.payload_heap_bytes_;
+		return *this;
+	}
+	memory_usage& operator-=( const memory_usage& rhs ) noexcept
+	{
+		inline_bytes_ -= rhs.inline_bytes_;
+		heap_carrier_bytes_ -= rhs.heap_carrier_bytes_;
+		payload_heap_bytes_ -= rhs.payload_heap_bytes_;
+		return *this;
+	}
+};
+
+namespace impl {
+
+class special_operation_memory_usage_if {
+public:
+	virtual ~special_operation_memory_usage_if() = default;
+
+	virtual size_t specialized_operation_heap_carrier_bytes_proxy( const value_carrier_if_common& a ) const noexcept = 0;
+	virtual size_t specialized_operation_payload_heap_bytes_proxy( const value_carrier_if_common& a ) const noexcept = 0;
+};
+
+template <typename Carrier>
+class special_operation_memory_usage_dispatcher : public special_operation_memory_usage_if {
+private:
+	size_t specialized_operation_heap_carrier_bytes_proxy( const value_carrier_if_common& ) const noexcept override
+	{
+		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
+#if __cpp_concepts >= 201907L
+			return Carrier::is_possible_sso ? 0 : sizeof( Carrier );
+#else
+			// C++17 implementation has no inline buffer.
+			return sizeof( Carrier );
+#endif
+		} else {
+			return 0;
+		}
+	}
+	size_t specialized_operation_payload_heap_bytes_proxy( const value_carrier_if_common& a ) const noexcept override
+	{
+		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
+			using value_t = typename impl::remove_cvref<typename Carrier::value_type>::type;
+			return memory_usage_traits<value_t>::heap_bytes( static_cast<const Carrier&>( a ).ref() );
+		} else {
+			return 0;
+		}
+	}
+};
+
+/**
+ * @brief special operation to report the memory usage of constrained_any
+ *
+ * All value types are acceptable. memory_usage_traits<T> of the type that has no specialization reports no payload heap bytes.
+ */
+template <typename Carrier>
+class special_operation_memory_usage : public special_operation_dispatcher_base_t<Carrier, special_operation_memory_usage_dispatcher<Carrier>> {
+public:
+	static constexpr bool share_special_operation = true;
+	static constexpr bool constraint_check_result = !is_related_type_of_constrained_any<Carrier>::value;
+
+	/**
+	 * @brief memory usage of constrained_any and its value
+	 */
+	template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	yan::memory_usage memory_usage( void ) const noexcept
+	{
+		const Carrier* p_a = static_cast<const Carrier*>( this );
+
+		yan::memory_usage ans;
+		ans.inline_bytes_ = sizeof( Carrier );
+
+		const special_operation_memory_usage_if* p_a_soi = p_a->template get_special_operation_if<special_operation_memory_usage_if>();
+		if ( p_a_soi == nullptr ) {
+			return ans;
+		}
+		ans.heap_carrier_bytes_ = p_a_soi->specialized_operation_heap_carrier_bytes_proxy( p_a->get_value_carrier() );
+		ans.payload_heap_bytes_ = p_a_soi->specialized_operation_payload_heap_bytes_proxy( p_a->get_value_carrier() );
+		return ans;
+	}
+};
+
+}   // namespace impl
+
+/**
+ * @brief running sum of the memory usage of the values in a container
+ *
+ * Call add() on insertion and remove() on removal with the value in the container. Each update costs one memory_usage() of the value.
+ *
+ * @tparam Alias specialized type of constrained_any that has impl::special_operation_memory_usage
+ */
+template <typename Alias>
+class memory_usage_accumulator {
+	static_assert( is_specialized_of_constrained_any<Alias>::value, "Alias should be specialized type of constrained_any" );
+
+public:
+	void add( const Alias& v ) noexcept
+	{
+		sum_ += v.memory_usage();
+		num_of_values_++;
+	}
+
+	void remove( const Alias& v ) noexcept
+	{
+		sum_ -= v.memory_usage();
+		num_of_values_--;
+	}
+
+	void clear( void ) noexcept
+	{
+		sum_           = yan::memory_usage {};
+		num_of_values_ = 0;
+	}
+
+	const yan::memory_usage& get( void ) const noexcept
+	{
+		return sum_;
+	}
+
+	size_t total_bytes( void ) const noexcept
+	{
+		return sum_.total_bytes();
+	}
+
+	size_t num_of_values( void ) const noexcept
+	{
+		return num_of_values_;
+	}
+
+private:
+	yan::memory_usage sum_;
+	size_t            num_of_values_ = 0;
+};
+
+/**
+ * @brief copyable constrained_any that reports its memory usage
+ */
+using memory_accounted_any = constrained_any<impl::special_operation_copyable, impl::special_operation_memory_usage>;
+
+}   // namespace yan
+
+#endif
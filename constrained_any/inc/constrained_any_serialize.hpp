@@ -0,0 +1,570 @@
+/**
+ * @file constrained_any_serialize.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief binary serialization special operation of constrained_any
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * special_operation_serialize adds serialized_size() and serialize() to constrained_any.
+ * The encoded form of a value is [type id(LEB128)][payload size(LEB128)][payload]. The payload is written by serialize_traits<T>.
+ * The empty constrained_any is encoded by type id 0 and no payload.
+ *
+ * serialize_registry<Alias> maps the type id to the decoder, and deserialize() constructs the value into the target constrained_any by emplace().
+ * deserialize_view() decodes the value of string like type as its view type(e.g. std::string_view) that refers the input buffer without copy.
+ *
+ * @warning
+ * register_type() is not thread safe. The types should be registered before serialize() and deserialize(), e.g. at the beginning of main().
+ */
+
+#ifndef INC_CONSTRAINED_ANY_SERIALIZE_HPP_
+#define INC_CONSTRAINED_ANY_SERIALIZE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+#include "constrained_any.hpp"
+#include "constrained_any_type_registry.hpp"
+
+namespace yan {
+
+/**
+ * @brief customization point of the payload encoding of T
+ *
+ * Specialization of this class should have the following static member functions.
+ * @li size_t encoded_size( const T& v ) : size of the payload
+ * @li void encode( const T& v, unsigned char* p ) : write encoded_size( v ) bytes to p
+ * @li T decode( const unsigned char* p, size_t n ) : decode the payload of n bytes. If the payload is malformed, throw std::invalid_argument.
+ *
+ * Optionally, it has view_type and "view_type decode_view( const unsigned char* p, size_t n )" that refers the payload without copy.
+ *
+ * This library provides the specializations for the arithmetic types, std::string and std::string_view.
+ * The arithmetic types are encoded in little endian. bool is encoded to one byte of 0 or 1.
+ */
+template <typename T, typename = void>
+struct serialize_traits {
+};
+
+// the arithmetic type of other size(e.g. long double of 16 bytes) has no specialization. Therefore, it is not serializable.
+template <typename T>
+struct serialize_traits<T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+                                                   ( ( sizeof( T ) == 1 ) || ( sizeof( T ) == 2 ) || ( sizeof( T ) == 4 ) || ( sizeof( T ) == 8 ) )>::type> {
+	using uint_t = typename std::conditional<sizeof( T ) == 1, uint8_t,
+	                                         typename std::conditional<sizeof( T ) == 2, uint16_t,
+	                                                                   typename std::conditional<sizeof( T ) == 4, uint32_t, uint64_t>::type>::type>::type;
+
+	static size_t encoded_size( const T& ) noexcept
+	{
+		return sizeof( T );
+	}
+	static void encode( const T& v, unsigned char* p ) noexcept
+	{
+		uint_t u;
+		std::memcpy( &u, &v, sizeof( T ) );
+		for ( size_t i = 0; i < sizeof( T ); i++ ) {
+			p[i] = static_cast<unsigned char>( u >> ( 8 * i ) );
+		}
+	}
+	static T decode( const unsigned char* p, size_t n )
+	{
+		if ( n != sizeof( T ) ) {
+			throw std::invalid_argument( "payload size of arithmetic type is wrong" );
+		}
+		uint_t u = 0;
+		for ( size_t i = 0; i < sizeof( T ); i++ ) {
+			u = static_cast<uint_t>( u | ( static_cast<uint_t>( p[i] ) << ( 8 * i ) ) );
+		}
+		T ans;
+		std::memcpy( &ans, &u, sizeof( T ) );
+		return ans;
+	}
+};
+
+// bool has the values of 0 and 1 only. Therefore, other byte is rejected as the malformed payload.
+template <>
+struct serialize_traits<bool> {
+	static size_t encoded_size( const bool& ) noexcept
+	{
+		return 1;
+	}
+	static void encode( const bool& v, unsigned char* p ) noexcept
+	{
+		p[0] = v ? 1 : 0;
+	}
+	static bool decode( const unsigned char* p, size_t n )
+	{
+		if ( n != 1 ) {
+			throw std::invalid_argument( "payload size of bool is wrong" );
+		}
+		if ( p[0] > 1 ) {
+			throw std::invalid_argument( "payload of bool is neither 0 nor 1" );
+		}
+		return p[0] == 1;
+	}
+};
+
+template <>
+struct serialize_traits<std::string_view> {
+	static size_t encoded_size( const std::string_view& v ) noexcept
+	{
+		return v.size();
+	}
+	static void encode( const std::string_view& v, unsigned char* p ) noexcept
+	{
+		std::memcpy( p, v.data(), v.size() );
+	}
+	static std::string_view decode( const unsigned char* p, size_t n ) noexcept
+	{
+		return std::string_view( reinterpret_cast<const char*>( p ), n );
+	}
+};
+
+template <>
+struct serialize_traits<std::string> {
+	using view_type = std::string_view;
+
+	static size_t encoded_size( const std::string& v ) noexcept
+	{
+		return v.size();
+	}
+	static void encode( const std::string& v, unsigned char* p ) noexcept
+	{
+		std::memcpy( p, v.data(), v.size() );
+	}
+	static std::string decode( const unsigned char* p, size_t n )
+	{
+		return std::string( reinterpret_cast<const char*>( p ), n );
+	}
+	static view_type decode_view( const unsigned char* p, size_t n ) noexcept
+	{
+		return std::string_view( reinterpret_cast<const char*>( p ), n );
+	}
+};
+
+namespace impl {
+
+struct is_serializable_impl {
+	template <typename T, typename RVCVR_T = typename impl::remove_cvref<T>::type>
+	static auto check( T* ) -> decltype( serialize_traits<RVCVR_T>::encoded_size( std::declval<const RVCVR_T&>() ), std::true_type() );
+	template <typename T>
+	static auto check( ... ) -> std::false_type;
+};
+template <typename T>
+struct is_serializable : public decltype( is_serializable_impl::check<T>( nullptr ) ) { };
+
+struct has_serialize_view_type_impl {
+	template <typename T>
+	static auto check( T* ) -> decltype( std::declval<typename serialize_traits<T>::view_type>(), std::true_type() );
+	template <typename T>
+	static auto check( ... ) -> std::false_type;
+};
+template <typename T>
+struct has_serialize_view_type : public decltype( has_serialize_view_type_impl::check<T>( nullptr ) ) { };
+
+inline size_t varint_size( uint64_t v ) noexcept
+{
+	size_t ans = 1;
+	while ( v >= 0x80 ) {
+		v >>= 7;
+		ans++;
+	}
+	return ans;
+}
+
+inline size_t encode_varint( uint64_t v, unsigned char* p ) noexcept
+{
+	size_t i = 0;
+	while ( v >= 0x80 ) {
+		p[i++] = static_cast<unsigned char>( v | 0x80 );
+		v >>= 7;
+	}
+	p[i++] = static_cast<unsigned char>( v );
+	return i;
+}
+
+/**
+ * @return consumed bytes. If the input is truncated, too long or over 64 bits, return 0.
+ */
+inline size_t decode_varint( const unsigned char* p, size_t n, uint64_t& out ) noexcept
+{
+	uint64_t ans = 0;
+	for ( size_t i = 0; ( i < n ) && ( i < 10 ); i++ ) {
+		// 10th byte has only bit 63. The bits above it are not representable.
+		if ( ( i == 9 ) && ( p[i] > 1 ) ) {
+			return 0;
+		}
+		ans |= static_cast<uint64_t>( p[i] & 0x7F ) << ( 7 * i );
+		if ( ( p[i] & 0x80 ) == 0 ) {
+			out = ans;
+			return i + 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * @brief type id of T for serialization by Alias
+ *
+ * 0 means that T is not registered to serialize_registry<Alias>.
+ */
+template <typename Alias, typename T>
+struct serialize_type_id_slot {
+	static inline uint64_t id_ = 0;
+};
+
+template <typename T>
+inline size_t serialized_size_of( uint64_t id, const T& v )
+{
+	if ( id == 0 ) {
+		throw std::logic_error( "type of the value is not registered to serialize_registry" );
+	}
+	size_t payload_size = serialize_traits<T>::encoded_size( v );
+	return varint_size( id ) + varint_size( payload_size ) + payload_size;
+}
+
+template <typename Alias, typename T>
+size_t serialize_value_to( const T& v, unsigned char* p_buff, size_t buff_size )
+{
+	uint64_t id = serialize_type_id_slot<Alias, T>::id_;
+	if ( id == 0 ) {
+		throw std::logic_error( "type of the value is not registered to serialize_registry" );
+	}
+	size_t payload_size = serialize_traits<T>::encoded_size( v );
+	size_t total_size   = varint_size( id ) + varint_size( payload_size ) + payload_size;
+	if ( total_size > buff_size ) {
+		throw std::length_error( "buffer is too small to serialize the value" );
+	}
+	size_t pos = encode_varint( id, p_buff );
+	pos += encode_varint( payload_size, p_buff + pos );
+	serialize_traits<T>::encode( v, p_buff + pos );
+	return total_size;
+}
+
+class special_operation_serialize_if {
+public:
+	virtual ~special_operation_serialize_if() = default;
+
+	virtual size_t specialized_operation_serialized_size_proxy( const value_carrier_if_common& a ) const                                     = 0;
+	virtual size_t specialized_operation_serialize_proxy( const value_carrier_if_common& a, unsigned char* p_buff, size_t buff_size ) const = 0;
+};
+
+template <typename Carrier>
+class special_operation_serialize_dispatcher : public special_operation_serialize_if {
+private:
+	size_t specialized_operation_serialized_size_proxy( const value_carrier_if_common& a ) const override
+	{
+		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
+			using value_t = typename impl::remove_cvref<typename Carrier::value_type>::type;
+			using alias_t = typename alias_of_value_carrier<Carrier>::type;
+			return serialized_size_of<value_t>( serialize_type_id_slot<alias_t, value_t>::id_, static_cast<const Carrier&>( a ).ref() );
+		} else {
+			throw std::logic_error( "specialized_operation_serialized_size_proxy() is not implemented for constrained_any itself" );
+		}
+	}
+	size_t specialized_operation_serialize_proxy( const value_carrier_if_common& a, unsigned char* p_buff, size_t buff_size ) const override
+	{
+		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
+			using value_t = typename impl::remove_cvref<typename Carrier::value_type>::type;
+			using alias_t = typename alias_of_value_carrier<Carrier>::type;
+			return serialize_value_to<alias_t, value_t>( static_cast<const Carrier&>( a ).ref(), p_buff, buff_size );
+		} else {
+			throw std::logic_error( "specialized_operation_serialize_proxy() is not implemented for constrained_any itself" );
+		}
+	}
+};
+
+/**
+ * @brief special operation to serialize the value
+ *
+ * The value type should have the specialization of serialize_traits, and should be registered to serialize_registry before serialize().
+ */
+template <typename Carrier>
+class special_operation_serialize : public special_operation_dispatcher_base_t<Carrier, special_operation_serialize_dispatcher<Carrier>> {
+public:
+	static constexpr bool share_special_operation = true;
+	static constexpr bool constraint_check_result = !is_related_type_of_constrained_any<Carrier>::value &&
+	                                                is_serializable<Carrier>::value;
+
+	/**
+	 * @brief size of the encoded form
+	 *
+	 * @exception std::logic_error if the type of the value is not registered
+	 */
+	template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	size_t serialized_size( void ) const
+	{
+		const Carrier* p_a = static_cast<const Carrier*>( this );
+
+		const special_operation_serialize_if* p_a_soi = p_a->template get_special_operation_if<special_operation_serialize_if>();
+		if ( p_a_soi == nullptr ) {
+			// In case that this is default constructed constrained_any, it is encoded by type id 0 and payload size 0.
+			return 2;
+		}
+		return p_a_soi->specialized_operation_serialized_size_proxy( p_a->get_value_carrier() );
+	}
+
+	/**
+	 * @brief write the encoded form to the buffer
+	 *
+	 * @return written bytes
+	 *
+	 * @exception std::length_error if buff_size is smaller than serialized_size()
+	 * @exception std::logic_error if the type of the value is not registered
+	 */
+	template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	size_t serialize( unsigned char* p_buff, size_t buff_size ) const
+	{
+		const Carrier* p_a = static_cast<const Carrier*>( this );
+
+		const special_operation_serialize_if* p_a_soi = p_a->template get_special_operation_if<special_operation_serialize_if>();
+		if ( p_a_soi == nullptr ) {
+			if ( buff_size < 2 ) {
+				throw std::length_error( "buffer is too small to serialize the value" );
+			}
+			p_buff[0] = 0;
+			p_buff[1] = 0;
+			return 2;
+		}
+		return p_a_soi->specialized_operation_serialize_proxy( p_a->get_value_carrier(), p_buff, buff_size );
+	}
+};
+
+}   // namespace impl
+
+/**
+ * @brief registry of the decoders of Alias
+ *
+ * @tparam Alias specialized type of constrained_any that has impl::special_operation_serialize
+ */
+template <typename Alias>
+class serialize_registry {
+	static_assert( is_specialized_of_constrained_any<Alias>::value, "Alias should be specialized type of constrained_any" );
+
+public:
+	static serialize_registry& get_instance( void )
+	{
+		static serialize_registry singleton;
+		return singleton;
+	}
+
+	/**
+	 * @brief register the type id of T and the decoder of T
+	 *
+	 * @param id type id. 0 is reserved for the empty constrained_any.
+	 *
+	 * @exception std::logic_error if id is 0, id is used by other type or T has other id
+	 */
+	template <typename T>
+	void register_type( uint64_t id )
+	{
+		static_assert( impl::is_serializable<T>::value, "T should have the specialization of serialize_traits" );
+		static_assert( std::is_constructible<Alias, std::in_place_type_t<T>, T&&>::value, "T should be acceptable for Alias" );
+
+		if ( id == 0 ) {
+			throw std::logic_error( "type id 0 is reserved for the empty constrained_any" );
+		}
+		uint64_t& ref_id = impl::serialize_type_id_slot<Alias, T>::id_;
+		if ( ( ref_id != 0 ) && ( ref_id != id ) ) {
+			throw std::logic_error( "type is already registered with other type id" );
+		}
+		auto it = decoders_.find( id );
+		if ( it != decoders_.end() ) {
+			if ( it->second.p_decode_ != &decode_as<T> ) {
+				throw std::logic_error( "type id is already used by other type" );
+			}
+			return;
+		}
+
+		decoder_entry entry { &typeid( T ), &decode_as<T>, &decode_as<T> };
+		if constexpr ( impl::has_serialize_view_type<T>::value ) {
+			if constexpr ( std::is_constructible<Alias, std::in_place_type_t<typename serialize_traits<T>::view_type>, typename serialize_traits<T>::view_type&&>::value ) {
+				entry.p_decode_view_ = &decode_view_as<T>;
+			}
+		}
+		decoders_.emplace( id, entry );
+		ref_id = id;
+	}
+
+	/**
+	 * @brief register T with the stable type id of type_registry
+	 *
+	 * The type id is same to type_registry::id_of<T>(). Therefore, the id is shared with stable_type_id() and any_key_archive.
+	 * T should be registered to type_registry before this call.
+	 *
+	 * @exception std::logic_error if T is not registered to type_registry, or same to register_type(id)
+	 */
+	template <typename T>
+	void register_type( void )
+	{
+		uint64_t id = type_registry::id_of<T>();
+		if ( id == 0 ) {
+			throw std::logic_error( "type is not registered to type_registry" );
+		}
+		register_type<T>( id );
+	}
+
+	/**
+	 * @brief decode the value from the buffer and store it into out
+	 *
+	 * @return consumed bytes
+	 *
+	 * @exception std::invalid_argument if the input is truncated, malformed or has unregistered type id
+	 */
+	size_t deserialize( const unsigned char* p_buff, size_t buff_size, Alias& out ) const
+	{
+		return deserialize_impl( p_buff, buff_size, out, false );
+	}
+
+	/**
+	 * @brief same to deserialize(), but string like type is decoded as its view type that refers p_buff
+	 *
+	 * @warning
+	 * out refers p_buff. p_buff should be alive while out is used.
+	 */
+	size_t deserialize_view( const unsigned char* p_buff, size_t buff_size, Alias& out ) const
+	{
+		return deserialize_impl( p_buff, buff_size, out, true );
+	}
+
+	/**
+	 * @brief type of the type id
+	 *
+	 * @return pointer to the type_info of the registered type. If id is not registered, return nullptr.
+	 */
+	const std::type_info* find_type( uint64_t id ) const noexcept
+	{
+		auto it = decoders_.find( id );
+		if ( it == decoders_.end() ) {
+			return nullptr;
+		}
+		return it->second.p_type_;
+	}
+
+	/**
+	 * @brief decode the payload of the type id and store it into out
+	 *
+	 * @param is_view if true, string like type is decoded as its view type that refers p_payload
+	 *
+	 * @exception std::invalid_argument if id is not registered or the payload is malformed
+	 */
+	void decode_payload( uint64_t id, const unsigned char* p_payload, size_t payload_size, Alias& out, bool is_view ) const
+	{
+		if ( id == 0 ) {
+			out.reset();
+			return;
+		}
+		auto it = decoders_.find( id );
+		if ( it == decoders_.end() ) {
+			throw std::invalid_argument( "input of deserialize has unregistered type id" );
+		}
+		( is_view ? it->second.p_decode_view_ : it->second.p_decode_ )( p_payload, payload_size, out );
+	}
+
+private:
+	using decode_func_t = void ( * )( const unsigned char* p, size_t n, Alias& out );
+
+	struct decoder_entry {
+		const std::type_info* p_type_;
+		decode_func_t         p_decode_;
+		decode_func_t         p_decode_view_;   // same to p_decode_ if T has no view type
+	};
+
+	serialize_registry()  = default;
+	~serialize_registry() = default;
+
+	template <typename T>
+	static void decode_as( const unsigned char* p, size_t n, Alias& out )
+	{
+		out.template emplace<T>( serialize_traits<T>::decode( p, n ) );
+	}
+
+	template <typename T>
+	static void decode_view_as( const unsigned char* p, size_t n, Alias& out )
+	{
+		out.template emplace<typename serialize_traits<T>::view_type>( serialize_traits<T>::decode_view( p, n ) );
+	}
+
+	size_t deserialize_impl( const unsigned char* p_buff, size_t buff_size, Alias& out, bool is_view ) const
+	{
+		uint64_t id           = 0;
+		uint64_t payload_size = 0;
+		size_t   pos          = impl::decode_varint( p_buff, buff_size, id );
+		size_t   pos_size     = ( pos == 0 ) ? 0 : impl::decode_varint( p_buff + pos, buff_size - pos, payload_size );
+		if ( ( pos_size == 0 ) || ( payload_size > buff_size - pos - pos_size ) ) {
+			throw std::invalid_argument( "input of deserialize is truncated or malformed" );
+		}
+		pos += pos_size;
+
+		decode_payload( id, p_buff + pos, static_cast<size_t>( payload_size ), out, is_view );
+		return pos + static_cast<size_t>( payload_size );
+	}
+
+	std::unordered_map<uint64_t, decoder_entry> decoders_;
+};
+
+/**
+ * @brief helper function of serialize_registry<Alias>::get_instance().deserialize()
+ */
+template <typename Alias>
+size_t deserialize( const unsigned char* p_buff, size_t buff_size, Alias& out )
+{
+	return serialize_registry<Alias>::get_instance().deserialize( p_buff, buff_size, out );
+}
+
+/**
+ * @brief helper function of serialize_registry<Alias>::get_instance().deserialize_view()
+ */
+template <typename Alias>
+size_t deserialize_view( const unsigned char* p_buff, size_t buff_size, Alias& out )
+{
+	return serialize_registry<Alias>::get_instance().deserialize_view( p_buff, buff_size, out );
+}
+
+/**
+ * @brief keyable_any with binary serialization
+ */
+using serializable_keyable_any = constrained_any<impl::special_operation_copyable, impl::special_operation_less, impl::special_operation_hash_value, impl::special_operation_equal_to, impl::special_operation_serialize>;
+
+/**
+ * @brief less operator(operator <) of serializable_keyable_any
+ */
+template <typename T, typename std::enable_if<std::is_same<T, serializable_keyable_any>::value>::type* = nullptr>
+inline bool operator<( const T& lhs, const T& rhs )
+{
+	return lhs.less( rhs );
+}
+
+/**
+ * @brief equal to operator(operator ==) of serializable_keyable_any
+ */
+template <typename T, typename std::enable_if<std::is_same<T, serializable_keyable_any>::value>::type* = nullptr>
+inline bool operator==( const T& lhs, const T& rhs )
+{
+	return lhs.equal_to( rhs );
+}
+
+}   // namespace yan
+
+namespace std {
+
+template <>
+struct hash<yan::serializable_keyable_any> {
+	size_t operator()( const yan::serializable_keyable_any& a ) const
+	{
+		return a.hash_value();
+	}
+};
+
+}   // namespace std
+
+#endif
@@ -0,0 +1,377 @@
+/**
+ * @file constrained_any_sort_key.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief special operation to write the order preserving byte encoding of the value
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * special_operation_sort_key adds sort_key_size(), write_sort_key() and sort_key() to constrained_any.
+ * The sort key is [type ordinal(4 bytes, big endian)][encoded value]. The byte wise comparison of two sort keys(e.g. memcmp) agrees with less().
+ *
+ * less() of constrained_any orders the values of different types by std::type_index. The type ordinal is the rank of std::type_index
+ * in the types that are registered to sort_key_type_registry. Therefore, the types should be registered before write_sort_key(),
+ * and the sort keys that are written before the registration of other type are not comparable with the sort keys written after it.
+ * The type ordinal depends on std::type_index, so the sort key is not intended to be persisted.
+ *
+ * The encoded value is written by sort_key_traits<T>.
+ * @li unsigned integer: big endian
+ * @li signed integer: big endian with the sign bit flipped
+ * @li floating point: big endian of the bits. the sign bit is flipped for positive value, all bits are flipped for negative value. -0.0 is written as 0.0
+ * @li std::string and std::string_view: 0x00 is escaped to 0x00 0xFF, and terminated by 0x00 0x00
+ *
+ * @warning
+ * register_type() is not thread safe. The types should be registered before write_sort_key(), e.g. at the beginning of main().
+ */
+
+#ifndef INC_CONSTRAINED_ANY_SORT_KEY_HPP_
+#define INC_CONSTRAINED_ANY_SORT_KEY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "constrained_any.hpp"
+
+namespace yan {
+
+namespace impl {
+
+template <typename UInt>
+inline void sort_key_write_big_endian( UInt u, unsigned char* p ) noexcept
+{
+	for ( size_t i = 0; i < sizeof( UInt ); i++ ) {
+		p[i] = static_cast<unsigned char>( u >> ( ( sizeof( UInt ) - 1 - i ) * 8 ) );
+	}
+}
+
+template <typename T>
+using sort_key_uint_t = typename std::conditional<sizeof( T ) == 1, uint8_t,
+                                                  typename std::conditional<sizeof( T ) == 2, uint16_t,
+                                                                            typename std::conditional<sizeof( T ) == 4, uint32_t, uint64_t>::type>::type>::type;
+
+inline size_t sort_key_string_size( std::string_view v ) noexcept
+{
+	return v.size() + static_cast<size_t>( std::count( v.begin(), v.end(), '\0' ) ) + 2;
+}
+
+inline void sort_key_string_encode( std::string_view v, unsigned char* p ) noexcept
+{
+	for ( char c : v ) {
+		*p++ = static_cast<unsigned char>( c );
+		if ( c == '\0' ) {
+			*p++ = 0xFF;
+		}
+	}
+	p[0] = 0;
+	p[1] = 0;
+}
+
+}   // namespace impl
+
+/**
+ * @brief customization point of the order preserving encoding of T
+ *
+ * Specialization of this class should have the following static member functions.
+ * @li size_t encoded_size( const T& v ) : size of the encoded value
+ * @li void encode( const T& v, unsigned char* p ) : write encoded_size( v ) bytes to p
+ *
+ * For any a and b of T, a < b should be same to the byte wise comparison of the encoded values.
+ * The encoded value should not be a prefix of other encoded value of T, e.g. by the fixed size or the terminator.
+ *
+ * This library provides the specializations for the integral types, the floating point types(IEEE 754), std::string and std::string_view.
+ */
+template <typename T, typename = void>
+struct sort_key_traits {
+};
+
+template <typename T>
+struct sort_key_traits<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+	using uint_t = impl::sort_key_uint_t<T>;
+
+	static constexpr size_t encoded_size( const T& ) noexcept
+	{
+		return sizeof( T );
+	}
+	static void encode( const T& v, unsigned char* p ) noexcept
+	{
+		uint_t u = static_cast<uint_t>( v );
+		if constexpr ( std::is_signed<T>::value ) {
+			u ^= static_cast<uint_t>( uint_t { 1 } << ( sizeof( T ) * 8 - 1 ) );
+		}
+		impl::sort_key_write_big_endian<uint_t>( u, p );
+	}
+};
+
+template <typename T>
+struct sort_key_traits<T, typename std::enable_if<std::is_floating_point<T>::value && std::numeric_limits<T>::is_iec559 && ( sizeof( T ) <= 8 )>::type> {
+	using uint_t = impl::sort_key_uint_t<T>;
+
+	static constexpr size_t encoded_size( const T& ) noexcept
+	{
+		return sizeof( T );
+	}
+	static void encode( const T& v, unsigned char* p ) noexcept
+	{
+		// -0.0 == 0.0. therefore, -0.0 is written as 0.0 to agree with operator<.
+		T      nv = ( v == T( 0 ) ) ? T( 0 ) : v;
+		uint_t u;
+		std::memcpy( &u, &nv, sizeof( T ) );
+		constexpr uint_t sign_bit = static_cast<uint_t>( uint_t { 1 } << ( sizeof( T ) * 8 - 1 ) );
+		u                         = ( ( u & sign_bit ) != 0 ) ? static_cast<uint_t>( ~u ) : static_cast<uint_t>( u | sign_bit );
+		impl::sort_key_write_big_endian<uint_t>( u, p );
+	}
+};
+
+template <>
+struct sort_key_traits<std::string_view> {
+	static size_t encoded_size( const std::string_view& v ) noexcept
+	{
+		return impl::sort_key_string_size( v );
+	}
+	static void encode( const std::string_view& v, unsigned char* p ) noexcept
+	{
+		impl::sort_key_string_encode( v, p );
+	}
+};
+
+template <>
+struct sort_key_traits<std::string> {
+	static size_t encoded_size( const std::string& v ) noexcept
+	{
+		return impl::sort_key_string_size( v );
+	}
+	static void encode( const std::string& v, unsigned char* p ) noexcept
+	{
+		impl::sort_key_string_encode( v, p );
+	}
+};
+
+namespace impl {
+
+template <typename T>
+struct has_sort_key_traits {
+	template <typename U>
+	static auto check( U* ) -> decltype( sort_key_traits<U>::encoded_size( std::declval<const U&>() ),
+	                                     sort_key_traits<U>::encode( std::declval<const U&>(), std::declval<unsigned char*>() ),
+	                                     std::true_type() );
+	template <typename U>
+	static auto check( ... ) -> std::false_type;
+
+	static constexpr bool value = decltype( check<T>( nullptr ) )::value;
+};
+
+/**
+ * @brief type ordinal of T for the sort key
+ *
+ * 0 means that T is not registered.
+ */
+template <typename T>
+struct sort_key_ordinal_slot {
+	static inline uint32_t ordinal_ = 0;
+};
+
+constexpr size_t sort_key_ordinal_size = sizeof( uint32_t );
+
+}   // namespace impl
+
+/**
+ * @brief registry of the type ordinal of the sort key
+ *
+ * The type ordinal is the rank of std::type_index of the registered types. void, i.e. the empty constrained_any, is registered at the first.
+ */
+class sort_key_type_registry {
+public:
+	static sort_key_type_registry& get_instance( void )
+	{
+		static sort_key_type_registry singleton;
+		return singleton;
+	}
+
+	/**
+	 * @brief register T, and renumber the type ordinals of all registered types
+	 *
+	 * The sort keys that are written before this call are not comparable with the sort keys written after this call.
+	 */
+	template <typename T>
+	void register_type( void )
+	{
+		static_assert( std::is_void<T>::value || impl::has_sort_key_traits<T>::value, "T should have the specialization of sort_key_traits" );
+
+		std::type_index ti( typeid( T ) );
+		auto            it = std::lower_bound( entries_.begin(), entries_.end(), ti, []( const entry& e, const std::type_index& k ) { return e.type_ < k; } );
+		if ( ( it != entries_.end() ) && ( it->type_ == ti ) ) {
+			return;
+		}
+		entries_.insert( it, entry { ti, &impl::sort_key_ordinal_slot<T>::ordinal_ } );
+		for ( size_t i = 0; i < entries_.size(); i++ ) {
+			*( entries_[i].p_ordinal_ ) = static_cast<uint32_t>( i + 1 );
+		}
+	}
+
+	size_t num_of_types( void ) const noexcept
+	{
+		return entries_.size();
+	}
+
+private:
+	struct entry {
+		std::type_index type_;
+		uint32_t*       p_ordinal_;
+	};
+
+	sort_key_type_registry()
+	{
+		register_type<void>();
+	}
+
+	std::vector<entry> entries_;
+};
+
+namespace impl {
+
+template <typename T>
+size_t write_sort_key_of( const T& v, unsigned char* p_buff, size_t buff_size )
+{
+	uint32_t ordinal = sort_key_ordinal_slot<T>::ordinal_;
+	if ( ordinal == 0 ) {
+		throw std::logic_error( "type of the value is not registered to sort_key_type_registry" );
+	}
+	size_t total_size = sort_key_ordinal_size + sort_key_traits<T>::encoded_size( v );
+	if ( total_size > buff_size ) {
+		throw std::length_error( "buffer is too small to write the sort key" );
+	}
+	sort_key_write_big_endian<uint32_t>( ordinal, p_buff );
+	sort_key_traits<T>::encode( v, p_buff + sort_key_ordinal_size );
+	return total_size;
+}
+
+class special_operation_sort_key_if {
+public:
+	virtual ~special_operation_sort_key_if() = default;
+
+	virtual size_t specialized_operation_sort_key_size_proxy( const value_carrier_if_common& a ) const                                       = 0;
+	virtual size_t specialized_operation_write_sort_key_proxy( const value_carrier_if_common& a, unsigned char* p_buff, size_t buff_size ) const = 0;
+};
+
+template <typename Carrier>
+class special_operation_sort_key_dispatcher : public special_operation_sort_key_if {
+private:
+	size_t specialized_operation_sort_key_size_proxy( const value_carrier_if_common& a ) const override
+	{
+		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
+			using value_t = typename impl::remove_cvref<typename Carrier::value_type>::type;
+			return sort_key_ordinal_size + sort_key_traits<value_t>::encoded_size( static_cast<const Carrier&>( a ).ref() );
+		} else {
+			throw std::logic_error( "specialized_operation_sort_key_size_proxy() is not implemented for constrained_any itself" );
+		}
+	}
+	size_t specialized_operation_write_sort_key_proxy( const value_carrier_if_common& a, unsigned char* p_buff, size_t buff_size ) const override
+	{
+		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
+			using value_t = typename impl::remove_cvref<typename Carrier::value_type>::type;
+			return write_sort_key_of<value_t>( static_cast<const Carrier&>( a ).ref(), p_buff, buff_size );
+		} else {
+			throw std::logic_error( "specialized_operation_write_sort_key_proxy() is not implemented for constrained_any itself" );
+		}
+	}
+};
+
+/**
+ * @brief special operation to write the order preserving byte encoding of the value
+ *
+ * The value type should have the specialization of sort_key_traits, and should be registered to sort_key_type_registry before write_sort_key().
+ */
+template <typename Carrier>
+class special_operation_sort_key : public special_operation_dispatcher_base_t<Carrier, special_operation_sort_key_dispatcher<Carrier>> {
+public:
+	static constexpr bool share_special_operation = true;
+	static constexpr bool constraint_check_result = !is_related_type_of_constrained_any<Carrier>::value &&
+	                                                has_sort_key_traits<Carrier>::value;
+
+	/**
+	 * @brief size of the sort key
+	 */
+	template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	size_t sort_key_size( void ) const
+	{
+		const Carrier* p_a = static_cast<const Carrier*>( this );
+
+		const special_operation_sort_key_if* p_a_soi = p_a->template get_special_operation_if<special_operation_sort_key_if>();
+		if ( p_a_soi == nullptr ) {
+			// In case that this is default constructed constrained_any, the sort key is the type ordinal of void only.
+			return sort_key_ordinal_size;
+		}
+		return p_a_soi->specialized_operation_sort_key_size_proxy( p_a->get_value_carrier() );
+	}
+
+	/**
+	 * @brief write the sort key to the buffer
+	 *
+	 * @return written bytes
+	 *
+	 * @exception std::length_error if buff_size is smaller than sort_key_size()
+	 * @exception std::logic_error if the type of the value is not registered
+	 */
+	template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	size_t write_sort_key( unsigned char* p_buff, size_t buff_size ) const
+	{
+		const Carrier* p_a = static_cast<const Carrier*>( this );
+
+		const special_operation_sort_key_if* p_a_soi = p_a->template get_special_operation_if<special_operation_sort_key_if>();
+		if ( p_a_soi == nullptr ) {
+			if ( buff_size < sort_key_ordinal_size ) {
+				throw std::length_error( "buffer is too small to write the sort key" );
+			}
+			sort_key_type_registry::get_instance();   // void is registered by the constructor of the registry
+			sort_key_write_big_endian<uint32_t>( sort_key_ordinal_slot<void>::ordinal_, p_buff );
+			return sort_key_ordinal_size;
+		}
+		return p_a_soi->specialized_operation_write_sort_key_proxy( p_a->get_value_carrier(), p_buff, buff_size );
+	}
+
+	/**
+	 * @brief sort key as std::string
+	 *
+	 * std::string compares the characters as unsigned char. Therefore, operator< of the returned string agrees with less().
+	 */
+	template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	std::string sort_key( void ) const
+	{
+		std::string ans( sort_key_size(), '\0' );
+		write_sort_key( reinterpret_cast<unsigned char*>( &ans[0] ), ans.size() );
+		return ans;
+	}
+};
+
+}   // namespace impl
+
+/**
+ * @brief weak_ordering_any that has the sort key
+ */
+using sortable_any = constrained_any<impl::special_operation_copyable, impl::special_operation_less, impl::special_operation_sort_key>;
+
+/**
+ * @brief less operator(operator <) of sortable_any
+ */
+template <typename T, typename std::enable_if<std::is_same<T, sortable_any>::value>::type* = nullptr>
+inline bool operator<( const T& lhs, const T& rhs )
+{
+	return lhs.less( rhs );
+}
+
+}   // namespace yan
+
+#endif
@@ -0,0 +1,211 @@
+/**
+ * @file constrained_any_type_registry.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief registry of stable type id that is same among processes
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * std::type_info and its name/address are not stable among binaries. type_registry gives the type a 64 bit id that is decided by the user,
+ * or by FNV-1a hash of the type name. constrained_any::stable_type_id() returns the id of the value type.
+ *
+ * The id of T is kept in the static variable of stable_type_id_slot<T>. Therefore, lookup from the type to the id is O(1) without any hash table.
+ * Lookup from the id to the type is O(1) by the hash table of type_registry.
+ */
+
+#ifndef INC_CONSTRAINED_ANY_TYPE_REGISTRY_HPP_
+#define INC_CONSTRAINED_ANY_TYPE_REGISTRY_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string_view>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace yan {
+
+/**
+ * @brief 32 bit FNV-1a hash
+ */
+constexpr uint32_t fnv1a_32( std::string_view str ) noexcept
+{
+	uint32_t ans = 2166136261U;
+	for ( char c : str ) {
+		ans ^= static_cast<unsigned char>( c );
+		ans *= 16777619U;
+	}
+	return ans;
+}
+
+/**
+ * @brief 64 bit FNV-1a hash
+ */
+constexpr uint64_t fnv1a_64( std::string_view str ) noexcept
+{
+	uint64_t ans = 14695981039346656037ULL;
+	for ( char c : str ) {
+		ans ^= static_cast<unsigned char>( c );
+		ans *= 1099511628211ULL;
+	}
+	return ans;
+}
+
+/**
+ * @brief name of T that is decided at compile time
+ *
+ * This is extracted from __PRETTY_FUNCTION__ or __FUNCSIG__. It is stable among the binaries that are built by same compiler,
+ * but it is different among compilers(e.g. std::string). Use the explicit name or id to share the id among different compilers.
+ */
+template <typename T>
+constexpr std::string_view stable_type_name( void ) noexcept
+{
+#if defined( __clang__ ) || defined( __GNUC__ )
+	constexpr std::string_view func   = __PRETTY_FUNCTION__;
+	constexpr std::string_view prefix = "T = ";
+	constexpr size_t           b      = func.find( prefix ) + prefix.size();
+	// The type name may have ']', e.g. std::array<int[2], 3>. Therefore, the end is found from the back.
+	// GCC appends "; std::string_view = ..." after the type name. Clang does not.
+	constexpr size_t           e_gcc  = func.find( "; std::string_view", b );
+	constexpr size_t           e      = ( e_gcc != std::string_view::npos ) ? e_gcc : func.rfind( ']' );
+#elif defined( _MSC_VER )
+	constexpr std::string_view func   = __FUNCSIG__;
+	constexpr std::string_view prefix = "stable_type_name<";
+	constexpr size_t           b      = func.find( prefix ) + prefix.size();
+	constexpr size_t           e      = func.rfind( ">(void)" );
+#else
+#error "stable_type_name() is not supported by this compiler"
+#endif
+	return func.substr( b, e - b );
+}
+
+/**
+ * @brief 64 bit FNV-1a hash of stable_type_name<T>()
+ */
+template <typename T>
+constexpr uint64_t stable_type_hash( void ) noexcept
+{
+	return fnv1a_64( stable_type_name<T>() );
+}
+
+namespace impl {
+
+/**
+ * @brief stable type id of T
+ *
+ * 0 means that T is not registered to type_registry.
+ */
+template <typename T>
+struct stable_type_id_slot {
+	static inline std::atomic<uint64_t> id_ { 0 };
+};
+
+}   // namespace impl
+
+/**
+ * @brief registry of the stable type id
+ *
+ * Registration and lookup are thread safe. 0 is reserved for no value(void).
+ */
+class type_registry {
+public:
+	static type_registry& get_instance( void )
+	{
+		// never destructed to allow the lookup from the destructor of static objects
+		static type_registry* p_singleton = new type_registry;
+		return *p_singleton;
+	}
+
+	/**
+	 * @brief register T with the explicit id
+	 *
+	 * @return id
+	 *
+	 * @exception std::logic_error if id is 0, id is used by other type or T is registered with other id
+	 */
+	template <typename T>
+	uint64_t register_type( uint64_t id )
+	{
+		if ( id == 0 ) {
+			throw std::logic_error( "stable type id 0 is reserved for no value" );
+		}
+
+		std::unique_lock<std::shared_mutex> lk( mtx_ );
+
+		uint64_t cur_id = impl::stable_type_id_slot<T>::id_.load( std::memory_order_relaxed );
+		if ( ( cur_id != 0 ) && ( cur_id != id ) ) {
+			throw std::logic_error( "type is already registered with other stable type id" );
+		}
+		auto it = types_.find( id );
+		if ( it != types_.end() ) {
+			if ( *( it->second ) != typeid( T ) ) {
+				throw std::logic_error( "stable type id is already used by other type" );
+			}
+			return id;
+		}
+		types_.emplace( id, &typeid( T ) );
+		impl::stable_type_id_slot<T>::id_.store( id, std::memory_order_release );
+		return id;
+	}
+
+	/**
+	 * @brief register T with the id of FNV-1a hash of name
+	 */
+	template <typename T>
+	uint64_t register_type( std::string_view name )
+	{
+		return register_type<T>( fnv1a_64( name ) );
+	}
+
+	/**
+	 * @brief register T with the id of stable_type_hash<T>()
+	 */
+	template <typename T>
+	uint64_t register_type( void )
+	{
+		return register_type<T>( stable_type_hash<T>() );
+	}
+
+	/**
+	 * @brief stable type id of T
+	 *
+	 * @return id. If T is not registered, return 0.
+	 */
+	template <typename T>
+	static uint64_t id_of( void ) noexcept
+	{
+		return impl::stable_type_id_slot<T>::id_.load( std::memory_order_acquire );
+	}
+
+	/**
+	 * @brief type of the stable type id
+	 *
+	 * @return pointer to type_info of the type. If id is not registered, return nullptr.
+	 */
+	const std::type_info* find_type( uint64_t id ) const
+	{
+		std::shared_lock<std::shared_mutex> lk( mtx_ );
+
+		auto it = types_.find( id );
+		if ( it == types_.end() ) {
+			return nullptr;
+		}
+		return it->second;
+	}
+
+private:
+	type_registry()  = default;
+	~type_registry() = default;
+
+	mutable std::shared_mutex                            mtx_;
+	std::unordered_map<uint64_t, const std::type_info*> types_;
+};
+
+}   // namespace yan
+
+#endif
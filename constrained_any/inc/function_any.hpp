@@ -0,0 +1,113 @@
+/**
+ * @file function_any.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief type erased invocable object on constrained_any
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * special_operation_invoke<R(Args...)>::type adds operator() to constrained_any. function_any<R(Args...)> is move only constrained_any with it.
+ * The invocable object is stored in the inline buffer of constrained_any if it fits, therefore the capture of lambda up to the inline buffer size
+ * needs no memory allocation, while std::function allocates memory for the capture over 16 bytes.
+ * operator() calls the value by one virtual function call of the shared special operation without constrained_any_cast.
+ */
+
+#ifndef INC_FUNCTION_ANY_HPP_
+#define INC_FUNCTION_ANY_HPP_
+
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "constrained_any.hpp"
+
+namespace yan {
+
+namespace impl {
+
+template <typename Signature>
+class special_operation_invoke_if;
+
+template <typename R, typename... Args>
+class special_operation_invoke_if<R( Args... )> {
+public:
+	virtual ~special_operation_invoke_if() = default;
+
+	virtual R specialized_operation_invoke_proxy( const value_carrier_if_common& a, Args&&... args ) const = 0;
+};
+
+template <typename Signature, typename Carrier>
+class special_operation_invoke_dispatcher;
+
+template <typename R, typename... Args, typename Carrier>
+class special_operation_invoke_dispatcher<R( Args... ), Carrier> : public special_operation_invoke_if<R( Args... )> {
+private:
+	R specialized_operation_invoke_proxy( const value_carrier_if_common& a, Args&&... args ) const override
+	{
+		if constexpr ( is_value_carrier_of_constrained_any<Carrier>::value ) {
+			// operator() of constrained_any is non-const member function. Therefore, the value carrier is not const object.
+			Carrier& carrier = const_cast<Carrier&>( static_cast<const Carrier&>( a ) );
+			if constexpr ( std::is_void<R>::value ) {
+				std::invoke( carrier.ref(), std::forward<Args>( args )... );
+			} else {
+				return std::invoke( carrier.ref(), std::forward<Args>( args )... );
+			}
+		} else {
+			throw std::logic_error( "specialized_operation_invoke_proxy() is not implemented for constrained_any itself" );
+		}
+	}
+};
+
+template <typename Signature>
+struct special_operation_invoke;
+
+/**
+ * @brief special operation to invoke the value as R(Args...)
+ *
+ * Template parameter of constrained_any is special_operation_invoke<R(Args...)>::template type.
+ * The value type should be invocable with Args... as non-const lvalue, and its result should be convertible to R.
+ */
+template <typename R, typename... Args>
+struct special_operation_invoke<R( Args... )> {
+	template <typename Carrier>
+	class type : public special_operation_dispatcher_base_t<Carrier, special_operation_invoke_dispatcher<R( Args... ), Carrier>> {
+	public:
+		static constexpr bool share_special_operation = true;
+		static constexpr bool constraint_check_result = !is_related_type_of_constrained_any<Carrier>::value &&
+		                                                std::is_invocable_r<R, typename impl::remove_cvref<Carrier>::type&, Args...>::value;
+
+		/**
+		 * @brief invoke the value
+		 *
+		 * @exception std::bad_function_call if no value
+		 */
+		template <typename U = Carrier, typename std::enable_if<is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+		R operator()( Args... args )
+		{
+			Carrier* p_a = static_cast<Carrier*>( this );
+
+			const special_operation_invoke_if<R( Args... )>* p_a_soi = p_a->template get_special_operation_if<special_operation_invoke_if<R( Args... )>>();
+			if ( p_a_soi == nullptr ) {
+				throw std::bad_function_call();
+			}
+			return p_a_soi->specialized_operation_invoke_proxy( p_a->get_value_carrier(), std::forward<Args>( args )... );
+		}
+	};
+};
+
+}   // namespace impl
+
+/**
+ * @brief move only type erased invocable object
+ *
+ * @tparam Signature function type R(Args...)
+ */
+template <typename Signature>
+using function_any = constrained_any<impl::special_operation_movable, impl::special_operation_invoke<Signature>::template type>;
+
+}   // namespace yan
+
+#endif
@@ -0,0 +1,631 @@
+/**
+ * @file packed_any_vector.hpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief vector of variable size heterogeneous values packed in one buffer
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#ifndef INC_PACKED_ANY_VECTOR_HPP_
+#define INC_PACKED_ANY_VECTOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "constrained_any.hpp"
+
+namespace yan {
+
+namespace impl {
+
+/**
+ * @brief operation table of a value type in packed_any_vector
+ *
+ * One table is shared by all elements of same value type. The header of each element is the pointer to this table.
+ */
+template <typename Alias>
+struct packed_any_ops {
+	const std::type_info& ( *p_type_ )( void ) noexcept;
+	void ( *p_destroy_ )( void* p ) noexcept;
+	void ( *p_move_construct_ )( void* p_dst, void* p_src );         // construct to p_dst by std::move_if_noexcept
+	void ( *p_copy_construct_ )( void* p_dst, const void* p_src );   // nullptr if the value type is not copy constructible
+	Alias ( *p_make_any_ )( const void* p );                         // nullptr if the value type is not copy constructible
+	bool ( *p_less_ )( const void* p_a, const void* p_b );           // nullptr if Alias does not have special_operation_less
+	bool ( *p_equal_to_ )( const void* p_a, const void* p_b );       // nullptr if Alias does not have special_operation_equal_to
+	size_t ( *p_hash_value_ )( const void* p );                      // nullptr if Alias does not have special_operation_hash_value
+	size_t value_size_;
+	bool   is_trivially_relocatable_;
+};
+
+template <typename Alias, typename T>
+struct packed_any_ops_of {
+	static const std::type_info& type( void ) noexcept
+	{
+		return typeid( T );
+	}
+	static void destroy( void* p ) noexcept
+	{
+		static_cast<T*>( p )->~T();
+	}
+	static void move_construct( void* p_dst, void* p_src )
+	{
+		new ( p_dst ) T( std::move_if_noexcept( *static_cast<T*>( p_src ) ) );
+	}
+	static void copy_construct( void* p_dst, const void* p_src )
+	{
+		new ( p_dst ) T( *static_cast<const T*>( p_src ) );
+	}
+	static Alias make_any( const void* p )
+	{
+		return Alias( std::in_place_type<T>, *static_cast<const T*>( p ) );
+	}
+	static bool less( const void* p_a, const void* p_b )
+	{
+		return *static_cast<const T*>( p_a ) < *static_cast<const T*>( p_b );
+	}
+	static bool equal_to( const void* p_a, const void* p_b )
+	{
+		return *static_cast<const T*>( p_a ) == *static_cast<const T*>( p_b );
+	}
+	static size_t hash_value( const void* p )
+	{
+		return std::hash<T>()( *static_cast<const T*>( p ) );
+	}
+
+	// if constexpr avoids the instantiation of the operation that T does not support.
+	static constexpr auto copy_construct_of( void ) -> decltype( packed_any_ops<Alias>::p_copy_construct_ )
+	{
+		if constexpr ( std::is_copy_constructible<T>::value ) {
+			return &copy_construct;
+		} else {
+			return nullptr;
+		}
+	}
+	static constexpr auto make_any_of( void ) -> decltype( packed_any_ops<Alias>::p_make_any_ )
+	{
+		if constexpr ( std::is_constructible<Alias, std::in_place_type_t<T>, const T&>::value ) {
+			return &make_any;
+		} else {
+			return nullptr;
+		}
+	}
+	static constexpr auto less_of( void ) -> decltype( packed_any_ops<Alias>::p_less_ )
+	{
+		if constexpr ( is_alias_with_less<Alias>::value ) {
+			return &less;
+		} else {
+			return nullptr;
+		}
+	}
+	static constexpr auto equal_to_of( void ) -> decltype( packed_any_ops<Alias>::p_equal_to_ )
+	{
+		if constexpr ( is_alias_with_equal_to<Alias>::value ) {
+			return &equal_to;
+		} else {
+			return nullptr;
+		}
+	}
+	static constexpr auto hash_value_of( void ) -> decltype( packed_any_ops<Alias>::p_hash_value_ )
+	{
+		if constexpr ( is_alias_with_hash_value<Alias>::value ) {
+			return &hash_value;
+		} else {
+			return nullptr;
+		}
+	}
+
+	static constexpr packed_any_ops<Alias> value = {
+		&type,
+		&destroy,
+		&move_construct,
+		copy_construct_of(),
+		make_any_of(),
+		less_of(),
+		equal_to_of(),
+		hash_value_of(),
+		sizeof( T ),
+		std::is_trivially_copyable<T>::value,
+	};
+};
+
+}   // namespace impl
+
+/**
+ * @brief vector of the values of the specialized type of constrained_any that are packed end to end in one buffer
+ *
+ * Each element occupies only the header(pointer to the operation table of its type) and sizeof(T) with the padding for the alignment.
+ * The side index of the offsets gives O(1) random access.
+ * Comparison and hash of the elements follow the special operations of Alias, i.e. the elements of different types are ordered by std::type_index.
+ *
+ * @tparam Alias specialized type of constrained_any like yan::keyable_any. A value type T is acceptable if Alias is constructible from T.
+ *
+ * @note
+ * The value type whose alignment is larger than alignof(std::max_align_t) is not acceptable.
+ * The growth of the buffer moves the values by std::move_if_noexcept like std::vector.
+ */
+template <typename Alias>
+class packed_any_vector {
+	static_assert( is_specialized_of_constrained_any<Alias>::value, "Alias should be specialized type of constrained_any" );
+
+	using ops_t = impl::packed_any_ops<Alias>;
+
+	struct element_header {
+		const ops_t* p_ops_;
+	};
+
+public:
+	using value_type = Alias;
+
+	/**
+	 * @brief read only view of an element that is compatible with constrained_any
+	 */
+	class const_reference {
+	public:
+		const std::type_info& type() const noexcept
+		{
+			return p_vec_->type( idx_ );
+		}
+
+		bool has_value() const noexcept
+		{
+			return true;
+		}
+
+		/**
+		 * @brief pointer to the value if the value type is T
+		 *
+		 * @return pointer to the value. If the value type is not T, return nullptr.
+		 */
+		template <typename T>
+		const T* get_if() const noexcept
+		{
+			return p_vec_->template get_if<T>( idx_ );
+		}
+
+		/**
+		 * @brief make Alias that has the copy of the value
+		 */
+		Alias to_any( void ) const
+		{
+			return p_vec_->get( idx_ );
+		}
+
+		operator Alias() const
+		{
+			return to_any();
+		}
+
+	private:
+		friend class packed_any_vector;
+
+		const_reference( const packed_any_vector* p_vec, size_t idx ) noexcept
+		  : p_vec_( p_vec )
+		  , idx_( idx )
+		{
+		}
+
+		const packed_any_vector* p_vec_;
+		size_t                   idx_;
+	};
+
+	packed_any_vector() = default;
+	~packed_any_vector()
+	{
+		clear();
+		release_buffer();
+	}
+
+	/**
+	 * @brief copy constructor
+	 *
+	 * @exception std::logic_error if an element is not copy constructible
+	 */
+	packed_any_vector( const packed_any_vector& src )
+	{
+		if ( src.used_bytes_ > 0 ) {
+			reserve_bytes( src.used_bytes_ );
+		}
+		offsets_.reserve( src.offsets_.size() );
+		try {
+			for ( size_t off : src.offsets_ ) {
+				const ops_t* p_ops = src.header_at( off ).p_ops_;
+				if ( p_ops->p_copy_construct_ == nullptr ) {
+					throw std::logic_error( "packed_any_vector has the value that is not copy constructible" );
+				}
+				p_ops->p_copy_construct_( p_buff_ + off, src.p_buff_ + off );
+				new ( p_buff_ + off - sizeof( element_header ) ) element_header { p_ops };
+				offsets_.push_back( off );
+			}
+		} catch ( ... ) {
+			clear();
+			release_buffer();
+			throw;
+		}
+		used_bytes_ = src.used_bytes_;
+	}
+	packed_any_vector( packed_any_vector&& src ) noexcept
+	  : p_buff_( src.p_buff_ )
+	  , capacity_bytes_( src.capacity_bytes_ )
+	  , used_bytes_( src.used_bytes_ )
+	  , offsets_( std::move( src.offsets_ ) )
+	{
+		src.p_buff_         = nullptr;
+		src.capacity_bytes_ = 0;
+		src.used_bytes_     = 0;
+		src.offsets_.clear();
+	}
+	packed_any_vector& operator=( const packed_any_vector& rhs )
+	{
+		if ( this == &rhs ) return *this;
+		packed_any_vector( rhs ).swap( *this );
+		return *this;
+	}
+	packed_any_vector& operator=( packed_any_vector&& rhs ) noexcept
+	{
+		if ( this == &rhs ) return *this;
+		packed_any_vector( std::move( rhs ) ).swap( *this );
+		return *this;
+	}
+
+	void swap( packed_any_vector& src ) noexcept
+	{
+		std::swap( p_buff_, src.p_buff_ );
+		std::swap( capacity_bytes_, src.capacity_bytes_ );
+		std::swap( used_bytes_, src.used_bytes_ );
+		offsets_.swap( src.offsets_ );
+	}
+
+	/**
+	 * @brief append the value
+	 */
+	template <typename T, typename VT = std::decay_t<T>,
+	          typename std::enable_if<!std::is_same<VT, Alias>::value && std::is_constructible<Alias, std::in_place_type_t<VT>, T&&>::value>::type* = nullptr>
+	void push_back( T&& v )
+	{
+		emplace_back<VT>( std::forward<T>( v ) );
+	}
+
+	/**
+	 * @brief construct the value of T at the end
+	 *
+	 * @return reference to the constructed value. It is invalidated by the growth of the buffer.
+	 */
+	template <typename T, typename... Args>
+	T& emplace_back( Args&&... args )
+	{
+		static_assert( std::is_constructible<Alias, std::in_place_type_t<T>, T&&>::value, "T should be acceptable for Alias" );
+		static_assert( alignof( T ) <= alignof( std::max_align_t ), "over aligned type is not acceptable" );
+
+		const ops_t& ref_ops = impl::packed_any_ops_of<Alias, T>::value;
+
+		// the header is put just before the value. Therefore, the value is aligned to the alignment of the header at least.
+		size_t off     = align_up( used_bytes_ + sizeof( element_header ), ( alignof( T ) > alignof( element_header ) ) ? alignof( T ) : alignof( element_header ) );
+		size_t new_end = off + sizeof( T );
+		offsets_.push_back( off );
+		if ( new_end > capacity_bytes_ ) {
+			// args may refer to an element of this vector. Therefore, the new value is constructed into the new buffer before the old buffer is released.
+			size_t         new_capacity = ( capacity_bytes_ * 2 > new_end ) ? capacity_bytes_ * 2 : new_end;
+			unsigned char* p_new        = nullptr;
+			try {
+				p_new = static_cast<unsigned char*>( ::operator new( new_capacity ) );
+				new ( p_new + off ) T( std::forward<Args>( args )... );
+			} catch ( ... ) {
+				::operator delete( p_new );
+				offsets_.pop_back();
+				throw;
+			}
+			try {
+				relocate_to( p_new, offsets_.size() - 1 );
+			} catch ( ... ) {
+				reinterpret_cast<T*>( p_new + off )->~T();
+				::operator delete( p_new );
+				offsets_.pop_back();
+				throw;
+			}
+			release_old_and_adopt( p_new, new_capacity, offsets_.size() - 1 );
+		} else {
+			try {
+				new ( p_buff_ + off ) T( std::forward<Args>( args )... );
+			} catch ( ... ) {
+				offsets_.pop_back();
+				throw;
+			}
+		}
+		new ( p_buff_ + off - sizeof( element_header ) ) element_header { &ref_ops };
+		used_bytes_ = new_end;
+		return *reinterpret_cast<T*>( p_buff_ + off );
+	}
+
+	void pop_back( void ) noexcept
+	{
+		size_t off = offsets_.back();
+		destroy_at( off );
+		offsets_.pop_back();
+		used_bytes_ = off - sizeof( element_header );
+	}
+
+	size_t size( void ) const noexcept
+	{
+		return offsets_.size();
+	}
+
+	bool empty( void ) const noexcept
+	{
+		return offsets_.empty();
+	}
+
+	void clear( void ) noexcept
+	{
+		for ( size_t off : offsets_ ) {
+			destroy_at( off );
+		}
+		offsets_.clear();
+		used_bytes_ = 0;
+	}
+
+	/**
+	 * @brief reserve the buffer and the index
+	 *
+	 * @param n number of elements
+	 * @param bytes_per_element expected bytes of each element including the header
+	 */
+	void reserve( size_t n, size_t bytes_per_element = 2 * sizeof( element_header ) )
+	{
+		offsets_.reserve( n );
+		if ( n * bytes_per_element > capacity_bytes_ ) {
+			reserve_bytes( n * bytes_per_element );
+		}
+	}
+
+	/**
+	 * @brief heap bytes of this vector including the index
+	 */
+	size_t memory_bytes( void ) const noexcept
+	{
+		return capacity_bytes_ + offsets_.capacity() * sizeof( size_t );
+	}
+
+	/**
+	 * @brief type of the element
+	 *
+	 * @pre idx < size()
+	 */
+	const std::type_info& type( size_t idx ) const noexcept
+	{
+		return header_at( offsets_[idx] ).p_ops_->p_type_();
+	}
+
+	/**
+	 * @brief pointer to the element if the value type is T
+	 *
+	 * @pre idx < size()
+	 */
+	template <typename T>
+	const T* get_if( size_t idx ) const noexcept
+	{
+		return const_cast<packed_any_vector*>( this )->template get_if<T>( idx );
+	}
+
+	template <typename T>
+	T* get_if( size_t idx ) noexcept
+	{
+		size_t       off   = offsets_[idx];
+		const ops_t* p_ops = header_at( off ).p_ops_;
+		if ( ( p_ops != &impl::packed_any_ops_of<Alias, T>::value ) && ( p_ops->p_type_() != typeid( T ) ) ) {
+			return nullptr;
+		}
+		return reinterpret_cast<T*>( p_buff_ + off );
+	}
+
+	/**
+	 * @brief make Alias that has the copy of the element
+	 *
+	 * @exception std::out_of_range if idx >= size()
+	 * @exception std::logic_error if the element is not copy constructible
+	 */
+	Alias get( size_t idx ) const
+	{
+		if ( idx >= offsets_.size() ) {
+			throw std::out_of_range( "packed_any_vector::get() index is out of range" );
+		}
+		const ops_t* p_ops = header_at( offsets_[idx] ).p_ops_;
+		if ( p_ops->p_make_any_ == nullptr ) {
+			throw std::logic_error( "packed_any_vector::get() is called for the value that is not copy constructible" );
+		}
+		return p_ops->p_make_any_( value_at( idx ) );
+	}
+
+	/**
+	 * @brief view of the element
+	 *
+	 * @pre idx < size()
+	 */
+	const_reference operator[]( size_t idx ) const noexcept
+	{
+		return const_reference( this, idx );
+	}
+
+	/**
+	 * @brief call f for each element of the type in Ts
+	 *
+	 * @tparam Ts value types to visit. The element of other type is skipped.
+	 * @param f callable object that accepts const T& for each T in Ts
+	 */
+	template <typename... Ts, typename F>
+	void visit( F&& f ) const
+	{
+		for ( size_t off : offsets_ ) {
+			const ops_t* p_ops = header_at( off ).p_ops_;
+			const void*  p_v   = p_buff_ + off;
+			( void )( ( ( p_ops == &impl::packed_any_ops_of<Alias, Ts>::value ) ? ( f( *static_cast<const Ts*>( p_v ) ), true ) : false ) || ... );
+		}
+	}
+
+	/**
+	 * @brief call f for each element by the view
+	 *
+	 * @param f callable object of f( const_reference )
+	 */
+	template <typename F>
+	void for_each( F&& f ) const
+	{
+		for ( size_t i = 0; i < offsets_.size(); i++ ) {
+			f( const_reference( this, i ) );
+		}
+	}
+
+	/**
+	 * @brief less operation of the elements by same rule as Alias::less()
+	 *
+	 * @pre idx_a < size() and idx_b < size()
+	 */
+	template <typename U = Alias, typename std::enable_if<impl::is_alias_with_less<U>::value>::type* = nullptr>
+	bool less( size_t idx_a, size_t idx_b ) const
+	{
+		const ops_t* p_ops_a = header_at( offsets_[idx_a] ).p_ops_;
+		const ops_t* p_ops_b = header_at( offsets_[idx_b] ).p_ops_;
+		if ( !is_same_type( p_ops_a, p_ops_b ) ) {
+			return std::type_index( p_ops_a->p_type_() ) < std::type_index( p_ops_b->p_type_() );
+		}
+		return p_ops_a->p_less_( value_at( idx_a ), value_at( idx_b ) );
+	}
+
+	/**
+	 * @brief equal_to operation of the elements by same rule as Alias::equal_to()
+	 *
+	 * @pre idx_a < size() and idx_b < size()
+	 */
+	template <typename U = Alias, typename std::enable_if<impl::is_alias_with_equal_to<U>::value>::type* = nullptr>
+	bool equal_to( size_t idx_a, size_t idx_b ) const
+	{
+		const ops_t* p_ops_a = header_at( offsets_[idx_a] ).p_ops_;
+		const ops_t* p_ops_b = header_at( offsets_[idx_b] ).p_ops_;
+		if ( !is_same_type( p_ops_a, p_ops_b ) ) {
+			return false;
+		}
+		return p_ops_a->p_equal_to_( value_at( idx_a ), value_at( idx_b ) );
+	}
+
+	/**
+	 * @brief hash value of the element by same rule as Alias::hash_value()
+	 *
+	 * @pre idx < size()
+	 */
+	template <typename U = Alias, typename std::enable_if<impl::is_alias_with_hash_value<U>::value>::type* = nullptr>
+	size_t hash_value( size_t idx ) const
+	{
+		return header_at( offsets_[idx] ).p_ops_->p_hash_value_( value_at( idx ) );
+	}
+
+private:
+	static constexpr size_t align_up( size_t v, size_t al ) noexcept
+	{
+		return ( v + ( al - 1 ) ) & ~( al - 1 );
+	}
+
+	static bool is_same_type( const ops_t* p_a, const ops_t* p_b ) noexcept
+	{
+		// the table may be duplicated among shared libraries. Therefore, type_info is compared if the pointers are different.
+		return ( p_a == p_b ) || ( p_a->p_type_() == p_b->p_type_() );
+	}
+
+	const element_header& header_at( size_t off ) const noexcept
+	{
+		return *reinterpret_cast<const element_header*>( p_buff_ + off - sizeof( element_header ) );
+	}
+
+	const void* value_at( size_t idx ) const noexcept
+	{
+		return p_buff_ + offsets_[idx];
+	}
+
+	void destroy_at( size_t off ) noexcept
+	{
+		header_at( off ).p_ops_->p_destroy_( p_buff_ + off );
+	}
+
+	void reserve_bytes( size_t new_capacity )
+	{
+		unsigned char* p_new = static_cast<unsigned char*>( ::operator new( new_capacity ) );
+		try {
+			relocate_to( p_new, offsets_.size() );
+		} catch ( ... ) {
+			::operator delete( p_new );
+			throw;
+		}
+		release_old_and_adopt( p_new, new_capacity, offsets_.size() );
+	}
+
+	/**
+	 * @brief construct the first n elements into p_new at the same offsets
+	 *
+	 * If an exception is thrown, the elements constructed into p_new are destroyed and the old buffer still has all elements.
+	 */
+	void relocate_to( unsigned char* p_new, size_t n )
+	{
+		// The offsets are kept in the new buffer. Because both buffers are aligned to alignof(std::max_align_t), the alignment of each value is also kept.
+		size_t num_of_constructed = 0;
+		try {
+			for ( ; num_of_constructed < n; num_of_constructed++ ) {
+				size_t       off   = offsets_[num_of_constructed];
+				const ops_t* p_ops = header_at( off ).p_ops_;
+				if ( p_ops->is_trivially_relocatable_ ) {
+					std::memcpy( p_new + off, p_buff_ + off, p_ops->value_size_ );
+				} else {
+					p_ops->p_move_construct_( p_new + off, p_buff_ + off );
+				}
+				new ( p_new + off - sizeof( element_header ) ) element_header { p_ops };
+			}
+		} catch ( ... ) {
+			// old buffer still has all elements. If the value is copied by move_if_noexcept, the values are not changed.
+			for ( size_t i = 0; i < num_of_constructed; i++ ) {
+				size_t off = offsets_[i];
+				header_at( off ).p_ops_->p_destroy_( p_new + off );
+			}
+			throw;
+		}
+	}
+
+	/**
+	 * @brief destroy the first n elements in the old buffer and adopt p_new that has the relocated elements
+	 */
+	void release_old_and_adopt( unsigned char* p_new, size_t new_capacity, size_t n ) noexcept
+	{
+		for ( size_t i = 0; i < n; i++ ) {
+			destroy_at( offsets_[i] );
+		}
+		release_buffer();
+		p_buff_         = p_new;
+		capacity_bytes_ = new_capacity;
+	}
+
+	void release_buffer( void ) noexcept
+	{
+		if ( p_buff_ != nullptr ) {
+			::operator delete( p_buff_ );
+		}
+		p_buff_         = nullptr;
+		capacity_bytes_ = 0;
+	}
+
+	unsigned char*      p_buff_         = nullptr;   // aligned to alignof(std::max_align_t) by global operator new
+	size_t              capacity_bytes_ = 0;
+	size_t              used_bytes_     = 0;
+	std::vector<size_t> offsets_;   // offset of the value of each element. The header is just before the value.
+};
+
+}   // namespace yan
+
+#endif
@@ -0,0 +1,1224 @@
+/**
+ * @file benchmark_constrained_any.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief per-operation microbenchmark of constrained_any by Google Benchmark
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * Name of each benchmark is "<operation>/<alias>/<payload size>".
+ * Payload sizes are swept across impl::sso_buff_size. Therefore, the same operation is measured in both of inline buffer and heap.
+ * swap is measured for all 4 combinations of the storage classes by "swap_<this>_<src>".
+ * copy and assignment of 256 bytes - 4KB payloads are also measured with and without the heap carrier pool by "<operation>/<alias>/<payload size>" of pooled_copyable_any.
+ * request scoped build and drop of many values is measured with and without any_arena by "request_scope/<alias or mode>/<payload size>".
+ * fill of 10M elements from std::vector<int> is measured for element by element loop and range API by "fill_10M/<alias>/<method>".
+ * scan of int64_t values in a column of same type runs is measured for std::vector<Alias> and any_column by "column_scan_1M/<container>". Counter "bytes_per_element" reports the memory usage.
+ * serialization of 1M mixed keys of serializable_keyable_any is measured by "serialize_1M/<method>".
+ * startup of the lookup table of 1M mixed keys is measured by building sorted std::vector and by opening any_key_archive by "key_archive_1M/<method>".
+ * text formatting of 1M mixed values of formattable_any is measured for to_string() and format_append() into the reused buffer by "format_1M/<method>".
+ * invocation of the lambda of 8 bytes and 64 bytes capture is measured for function_any, std::function and std::move_only_function(if available)
+ *   by "invoke/<callable>/<capture size>" for the call only, and by "construct_invoke/<callable>/<capture size>" for the construction and the call.
+ * accumulation of memory_usage() of 1M mixed values of memory_accounted_any is measured by "memory_usage_1M/accumulator_add".
+ * sort of 1M mixed values of sortable_any is measured for std::sort by less() and by the precomputed sort keys by "sort_key_1M/<method>".
+ * sort of 1M and 10M mixed values of weak_ordering_any is measured for std::sort by less() and yan::any_sort() by "any_sort/<method>/<number of elements>".
+ *   100M elements are also measured if environment variable YAN_BENCHMARK_LARGE_SORT is set, because it needs more than 40GB memory.
+ * addition of 4K(in the cache) and 1M pairs of arithmetic values is measured for constrained_any_cast to each candidate type, add() and add_batch()
+ *   by "arithmetic/<method>/<same or mixed>/<number of pairs>". "same" is int64_t only, and "mixed" is int, int64_t and double.
+ * hash of 1M small mixed values is measured for std::vector<Alias> and packed_any_vector by "packed_hash_1M/<container>" with same counter.
+ * hash and equality of 4K(in the cache) and 1M keys of keyable_any are measured for the loop of each operation and hash_batch()/equal_batch()
+ *   by "key_batch/<method>/<same, mixed or runs64>/<number of keys>". "same" is int64_t only, "mixed" is int64_t, double and short std::string in turn,
+ *   and "runs64" is the runs of 64 keys of them.
+ *
+ * Usual Google Benchmark options are available. e.g. --benchmark_filter=copy/keyable_any
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "any_column.hpp"
+#include "any_key_batch.hpp"
+#include "any_sort.hpp"
+#include "constrained_any_arithmetic.hpp"
+#include "any_key_archive.hpp"
+#include "constrained_any_format.hpp"
+#include "constrained_any_memory_usage.hpp"
+#include "constrained_any_sort_key.hpp"
+#include "function_any.hpp"
+#include "constrained_any.hpp"
+#include "constrained_any_serialize.hpp"
+#include "packed_any_vector.hpp"
+
+// ================================================
+
+template <size_t N>
+struct bench_payload {
+	static_assert( N >= sizeof( uint64_t ), "N should be larger than or equal to sizeof(uint64_t)" );
+
+	uint64_t                                         key_;
+	std::array<unsigned char, N - sizeof( uint64_t )> padding_;
+
+	explicit bench_payload( uint64_t key = 0 )
+	  : key_( key )
+	  , padding_ {}
+	{
+	}
+
+	bool operator<( const bench_payload& rhs ) const noexcept
+	{
+		return key_ < rhs.key_;
+	}
+	bool operator==( const bench_payload& rhs ) const noexcept
+	{
+		return key_ == rhs.key_;
+	}
+};
+
+namespace std {
+template <size_t N>
+struct hash<bench_payload<N>> {
+	size_t operator()( const bench_payload<N>& v ) const noexcept
+	{
+		return std::hash<uint64_t>()( v.key_ );
+	}
+};
+}   // namespace std
+
+using sso_payload  = bench_payload<8>;
+using heap_payload = bench_payload<2 * yan::impl::sso_buff_size>;
+
+// ================================================
+
+struct is_callable_less_impl {
+	template <typename T>
+	static auto check( T* ) -> decltype( std::declval<const T&>().less( std::declval<const T&>() ), std::true_type() );
+	template <typename T>
+	static auto check( ... ) -> std::false_type;
+};
+template <typename T>
+struct is_callable_less : public decltype( is_callable_less_impl::check<T>( nullptr ) ) { };
+
+struct is_callable_equal_to_impl {
+	template <typename T>
+	static auto check( T* ) -> decltype( std::declval<const T&>().equal_to( std::declval<const T&>() ), std::true_type() );
+	template <typename T>
+	static auto check( ... ) -> std::false_type;
+};
+template <typename T>
+struct is_callable_equal_to : public decltype( is_callable_equal_to_impl::check<T>( nullptr ) ) { };
+
+struct is_callable_hash_value_impl {
+	template <typename T>
+	static auto check( T* ) -> decltype( std::declval<const T&>().hash_value(), std::true_type() );
+	template <typename T>
+	static auto check( ... ) -> std::false_type;
+};
+template <typename T>
+struct is_callable_hash_value : public decltype( is_callable_hash_value_impl::check<T>( nullptr ) ) { };
+
+// ================================================
+// benchmark body of each operation
+
+template <typename Alias>
+void bm_default_construct( benchmark::State& state )
+{
+	for ( auto _ : state ) {
+		Alias sut;
+		benchmark::DoNotOptimize( sut );
+	}
+}
+
+template <typename Alias, typename Payload>
+void bm_construct_from_value( benchmark::State& state )
+{
+	Payload v( 1 );
+	for ( auto _ : state ) {
+		Alias sut( v );
+		benchmark::DoNotOptimize( sut );
+	}
+}
+
+template <typename Alias, typename Payload>
+void bm_copy_construct( benchmark::State& state )
+{
+	Alias src( Payload( 1 ) );
+	for ( auto _ : state ) {
+		Alias sut( src );
+		benchmark::DoNotOptimize( sut );
+	}
+}
+
+template <typename Alias, typename Payload>
+void bm_move_construct( benchmark::State& state )
+{
+	// moved-from value of Payload is still same value. Therefore, src can be reused as the source of next iteration.
+	Alias src( Payload( 1 ) );
+	for ( auto _ : state ) {
+		Alias sut( std::move( src ) );
+		benchmark::DoNotOptimize( sut );
+	}
+}
+
+template <typename Alias, typename Payload>
+void bm_same_type_assign( benchmark::State& state )
+{
+	Alias src( Payload( 1 ) );
+	Alias sut( Payload( 2 ) );
+	for ( auto _ : state ) {
+		sut = src;
+		benchmark::DoNotOptimize( sut );
+	}
+}
+
+template <typename Alias>
+void bm_same_type_assign_string( benchmark::State& state )
+{
+	// assignment between constrained_any that hold std::string. the strings are in SSO of std::string to measure the dispatch cost.
+	Alias src( std::string( "a" ) );
+	Alias sut( std::string( "b" ) );
+	for ( auto _ : state ) {
+		sut = src;
+		benchmark::DoNotOptimize( sut );
+	}
+}
+
+template <typename Alias>
+void bm_same_type_move_assign_string( benchmark::State& state )
+{
+	Alias src( std::string( "a" ) );
+	Alias sut( std::string( "b" ) );
+	for ( auto _ : state ) {
+		sut = std::move( src );
+		benchmark::DoNotOptimize( sut );
+		src = std::move( sut );
+		benchmark::DoNotOptimize( src );
+	}
+	state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * 2 );
+}
+
+template <typename Alias>
+void bm_same_type_assign_string_value( benchmark::State& state )
+{
+	const std::string src( "a" );
+	Alias             sut( std::string( "b" ) );
+	for ( auto _ : state ) {
+		sut = src;
+		benchmark::DoNotOptimize( sut );
+	}
+}
+
+template <typename Alias, typename Payload>
+void bm_cross_type_assign( benchmark::State& state )
+{
+	// 2 type changing assignments per iteration
+	Alias src_payload( Payload( 1 ) );
+	Alias src_int( 1 );
+	Alias sut;
+	for ( auto _ : state ) {
+		sut = src_payload;
+		benchmark::DoNotOptimize( sut );
+		sut = src_int;
+		benchmark::DoNotOptimize( sut );
+	}
+	state.SetItemsProcessed( static_cast<int64_t>( state.iterations() ) * 2 );
+}
+
+template <typename Alias, typename PayloadA, typename PayloadB>
+void bm_swap( benchmark::State& state )
+{
+	Alias a( PayloadA( 1 ) );
+	Alias b( PayloadB( 2 ) );
+	for ( auto _ : state ) {
+		a.swap( b );
+		benchmark::DoNotOptimize( a );
+		benchmark::DoNotOptimize( b );
+	}
+}
+
+template <typename Alias, typename Payload>
+void bm_emplace( benchmark::State& state )
+{
+	Alias sut;
+	for ( auto _ : state ) {
+		sut.template emplace<Payload>( uint64_t { 1 } );
+		benchmark::DoNotOptimize( sut );
+	}
+}
+
+template <typename Alias, typename Payload>
+void bm_cast( benchmark::State& state )
+{
+	Alias sut( Payload( 1 ) );
+	for ( auto _ : state ) {
+		const Payload* p = yan::constrained_any_cast<Payload>( &sut );
+		benchmark::DoNotOptimize( p );
+	}
+}
+
+template <typename Alias, typename Payload>
+void bm_less( benchmark::State& state )
+{
+	Alias a( Payload( 1 ) );
+	Alias b( Payload( 2 ) );
+	for ( auto _ : state ) {
+		bool ret = a.less( b );
+		benchmark::DoNotOptimize( ret );
+	}
+}
+
+template <typename Alias, typename Payload>
+void bm_equal_to( benchmark::State& state )
+{
+	Alias a( Payload( 1 ) );
+	Alias b( Payload( 1 ) );
+	for ( auto _ : state ) {
+		bool ret = a.equal_to( b );
+		benchmark::DoNotOptimize( ret );
+	}
+}
+
+template <typename Alias, typename Payload>
+void bm_hash_value( benchmark::State& state )
+{
+	Alias sut( Payload( 1 ) );
+	for ( auto _ : state ) {
+		size_t ret = sut.hash_value();
+		benchmark::DoNotOptimize( ret );
+	}
+}
+
+constexpr size_t num_of_dispatch_values = 4096;
+
+// values of the first NumOfTypes types of int, unsigned int, int64_t, uint64_t, float and double in turn
+template <typename Alias, size_t NumOfTypes>
+void bm_dispatch_hash_value( benchmark::State& state )
+{
+	std::vector<Alias> src;
+	src.reserve( num_of_dispatch_values );
+	for ( size_t i = 0; i < num_of_dispatch_values; i++ ) {
+		switch ( i % NumOfTypes ) {
+			case 0: src.emplace_back( static_cast<int>( i ) ); break;
+			case 1: src.emplace_back( static_cast<unsigned int>( i ) ); break;
+			case 2: src.emplace_back( static_cast<int64_t>( i ) ); break;
+			case 3: src.emplace_back( static_cast<uint64_t>( i ) ); break;
+			case 4: src.emplace_back( static_cast<float>( i ) ); break;
+			default: src.emplace_back( static_cast<double>( i ) ); break;
+		}
+	}
+	for ( auto _ : state ) {
+		size_t sum = 0;
+		for ( const auto& v : src ) {
+			sum += v.hash_value();
+		}
+		benchmark::DoNotOptimize( sum );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( num_of_dispatch_values ) );
+}
+
+constexpr size_t num_of_values_per_request = 1000;
+
+template <typename Payload>
+void bm_request_scope_default( benchmark::State& state )
+{
+	std::vector<yan::copyable_any> values;
+	values.reserve( num_of_values_per_request );
+	for ( auto _ : state ) {
+		for ( size_t i = 0; i < num_of_values_per_request; i++ ) {
+			values.emplace_back( std::in_place_type<Payload>, uint64_t { i } );
+		}
+		benchmark::DoNotOptimize( values.data() );
+		values.clear();
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( num_of_values_per_request ) );
+}
+
+template <typename Payload>
+void bm_request_scope_arena( benchmark::State& state )
+{
+	yan::any_arena                       arena;
+	std::vector<yan::arena_copyable_any> values;
+	values.reserve( num_of_values_per_request );
+	for ( auto _ : state ) {
+		{
+			yan::any_arena_scope scope( arena );
+			for ( size_t i = 0; i < num_of_values_per_request; i++ ) {
+				values.emplace_back( std::in_place_type<Payload>, uint64_t { i } );
+			}
+			benchmark::DoNotOptimize( values.data() );
+			values.clear();
+		}
+		arena.release();
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( num_of_values_per_request ) );
+}
+
+template <typename Payload>
+void bm_request_scope_arena_create( benchmark::State& state )
+{
+	// Payload is trivially destructible. Therefore, release() drops all values without destructors.
+	yan::any_arena arena;
+	for ( auto _ : state ) {
+		for ( size_t i = 0; i < num_of_values_per_request; i++ ) {
+			auto& v = arena.create<yan::arena_copyable_any, Payload>( uint64_t { i } );
+			benchmark::DoNotOptimize( &v );
+		}
+		arena.release();
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( num_of_values_per_request ) );
+}
+
+constexpr size_t num_of_fill_elements = 10'000'000;
+
+const std::vector<int>& get_fill_source( void )
+{
+	static const std::vector<int> src = []() {
+		std::vector<int> ans( num_of_fill_elements );
+		for ( size_t i = 0; i < ans.size(); i++ ) {
+			ans[i] = static_cast<int>( i );
+		}
+		return ans;
+	}();
+	return src;
+}
+
+template <typename Alias>
+void bm_fill_push_back( benchmark::State& state )
+{
+	const std::vector<int>& src = get_fill_source();
+	for ( auto _ : state ) {
+		std::vector<Alias> dst;
+		dst.reserve( src.size() );
+		for ( int v : src ) {
+			dst.push_back( Alias( v ) );
+		}
+		benchmark::DoNotOptimize( dst.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( num_of_fill_elements ) );
+}
+
+template <typename Alias>
+void bm_fill_make_any_range( benchmark::State& state )
+{
+	const std::vector<int>& src = get_fill_source();
+	for ( auto _ : state ) {
+		std::vector<Alias> dst;
+		yan::make_any_range<Alias>( src.begin(), src.end(), dst );
+		benchmark::DoNotOptimize( dst.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( num_of_fill_elements ) );
+}
+
+template <typename Alias>
+void bm_fill_assign_loop( benchmark::State& state )
+{
+	const std::vector<int>& src = get_fill_source();
+	std::vector<Alias>      dst;
+	yan::make_any_range<Alias>( src.begin(), src.end(), dst );
+	for ( auto _ : state ) {
+		for ( size_t i = 0; i < src.size(); i++ ) {
+			dst[i] = Alias( src[i] );
+		}
+		benchmark::DoNotOptimize( dst.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( num_of_fill_elements ) );
+}
+
+template <typename Alias>
+void bm_fill_assign_all( benchmark::State& state )
+{
+	const std::vector<int>& src = get_fill_source();
+	std::vector<Alias>      dst;
+	yan::make_any_range<Alias>( src.begin(), src.end(), dst );
+	for ( auto _ : state ) {
+		yan::assign_all( dst, src );
+		benchmark::DoNotOptimize( dst.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( num_of_fill_elements ) );
+}
+
+constexpr size_t num_of_column_elements = 1000 * 1000;
+constexpr size_t column_run_length      = 1024;
+
+// runs of int64_t and double of column_run_length elements alternately
+template <typename Container>
+Container make_column_source( void )
+{
+	Container ans;
+	for ( size_t i = 0; i < num_of_column_elements; i++ ) {
+		if ( ( ( i / column_run_length ) % 2 ) == 0 ) {
+			ans.push_back( static_cast<int64_t>( i ) );
+		} else {
+			ans.push_back( static_cast<double>( i ) );
+		}
+	}
+	return ans;
+}
+
+template <typename Alias>
+void bm_column_scan_vector( benchmark::State& state )
+{
+	const std::vector<Alias> src = make_column_source<std::vector<Alias>>();
+	for ( auto _ : state ) {
+		int64_t sum = 0;
+		for ( const auto& v : src ) {
+			const int64_t* p = yan::constrained_any_cast<int64_t>( &v );
+			if ( p != nullptr ) {
+				sum += *p;
+			}
+		}
+		benchmark::DoNotOptimize( sum );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( num_of_column_elements ) );
+	state.counters["bytes_per_element"] = static_cast<double>( src.capacity() * sizeof( Alias ) ) / static_cast<double>( num_of_column_elements );
+}
+
+template <typename Alias>
+void bm_column_scan_any_column( benchmark::State& state )
+{
+	const yan::any_column<Alias> src = make_column_source<yan::any_column<Alias>>();
+	for ( auto _ : state ) {
+		int64_t sum = 0;
+		src.template for_each_run<int64_t>( [&sum]( const int64_t* p, size_t n ) {
+			for ( size_t i = 0; i < n; i++ ) {
+				sum += p[i];
+			}
+		} );
+		benchmark::DoNotOptimize( sum );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( num_of_column_elements ) );
+	state.counters["bytes_per_element"] = static_cast<double>( src.memory_bytes() ) / static_cast<double>( num_of_column_elements );
+}
+
+// int, double and int64_t values in turn
+template <typename Container>
+Container make_packed_source( void )
+{
+	Container ans;
+	ans.reserve( num_of_column_elements );
+	for ( size_t i = 0; i < num_of_column_elements; i++ ) {
+		switch ( i % 3 ) {
+			case 0: ans.push_back( static_cast<int>( i ) ); break;
+			case 1: ans.push_back( static_cast<double>( i ) ); break;
+			default: ans.push_back( static_cast<int64_t>( i ) ); break;
+		}
+	}
+	return ans;
+}
+
+template <typename Alias>
+void bm_packed_hash_vector( benchmark::State& state )
+{
+	const std::vector<Alias> src = make_packed_source<std::vector<Alias>>();
+	for ( auto _ : state ) {
+		size_t sum = 0;
+		for ( const auto& v : src ) {
+			sum += v.hash_value();
+		}
+		benchmark::DoNotOptimize( sum );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( num_of_column_elements ) );
+	state.counters["bytes_per_element"] = static_cast<double>( src.capacity() * sizeof( Alias ) ) / static_cast<double>( num_of_column_elements );
+}
+
+template <typename Alias>
+void bm_packed_hash_packed_any_vector( benchmark::State& state )
+{
+	const yan::packed_any_vector<Alias> src = make_packed_source<yan::packed_any_vector<Alias>>();
+	for ( auto _ : state ) {
+		size_t sum = 0;
+		for ( size_t i = 0; i < src.size(); i++ ) {
+			sum += src.hash_value( i );
+		}
+		benchmark::DoNotOptimize( sum );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( num_of_column_elements ) );
+	state.counters["bytes_per_element"] = static_cast<double>( src.memory_bytes() ) / static_cast<double>( num_of_column_elements );
+}
+
+// int64_t, double and std::string keys in turn
+const std::vector<yan::serializable_keyable_any>& get_serialize_source( void )
+{
+	static const std::vector<yan::serializable_keyable_any> src = []() {
+		auto& registry = yan::serialize_registry<yan::serializable_keyable_any>::get_instance();
+		registry.register_type<int64_t>( 1 );
+		registry.register_type<double>( 2 );
+		registry.register_type<std::string>( 3 );
+		registry.register_type<std::string_view>( 4 );
+
+		std::vector<yan::serializable_keyable_any> ans;
+		ans.reserve( num_of_column_elements );
+		for ( size_t i = 0; i < num_of_column_elements; i++ ) {
+			switch ( i % 3 ) {
+				case 0: ans.emplace_back( static_cast<int64_t>( i ) ); break;
+				case 1: ans.emplace_back( static_cast<double>( i ) ); break;
+				default: ans.emplace_back( "key_" + std::to_string( i ) ); break;
+			}
+		}
+		return ans;
+	}();
+	return src;
+}
+
+std::vector<unsigned char> serialize_all( const std::vector<yan::serializable_keyable_any>& src )
+{
+	size_t total = 0;
+	for ( const auto& v : src ) {
+		total += v.serialized_size();
+	}
+	std::vector<unsigned char> ans( total );
+	size_t                     pos = 0;
+	for ( const auto& v : src ) {
+		pos += v.serialize( ans.data() + pos, ans.size() - pos );
+	}
+	return ans;
+}
+
+void bm_serialize( benchmark::State& state )
+{
+	const std::vector<yan::serializable_keyable_any>& src = get_serialize_source();
+	std::vector<unsigned char>                        buff = serialize_all( src );
+	for ( auto _ : state ) {
+		size_t pos = 0;
+		for ( const auto& v : src ) {
+			pos += v.serialize( buff.data() + pos, buff.size() - pos );
+		}
+		benchmark::DoNotOptimize( buff.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( src.size() ) );
+}
+
+template <bool IsView>
+void bm_deserialize( benchmark::State& state )
+{
+	const std::vector<unsigned char>           buff = serialize_all( get_serialize_source() );
+	std::vector<yan::serializable_keyable_any> dst( num_of_column_elements );
+	for ( auto _ : state ) {
+		size_t pos = 0;
+		for ( auto& v : dst ) {
+			if constexpr ( IsView ) {
+				pos += yan::deserialize_view( buff.data() + pos, buff.size() - pos, v );
+			} else {
+				pos += yan::deserialize( buff.data() + pos, buff.size() - pos, v );
+			}
+		}
+		benchmark::DoNotOptimize( dst.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( dst.size() ) );
+	state.counters["bytes_per_key"] = static_cast<double>( buff.size() ) / static_cast<double>( dst.size() );
+}
+
+const std::string& get_key_archive_path( void )
+{
+	static const std::string path = []() {
+		std::string ans = ( std::filesystem::temp_directory_path() / "benchmark_constrained_any_key_archive.bin" ).string();
+		yan::write_any_key_archive( ans, get_serialize_source() );
+		return ans;
+	}();
+	return path;
+}
+
+void bm_key_archive_build_sorted_vector( benchmark::State& state )
+{
+	const std::vector<yan::serializable_keyable_any>& src = get_serialize_source();
+	for ( auto _ : state ) {
+		std::vector<yan::serializable_keyable_any> table( src.begin(), src.end() );
+		std::sort( table.begin(), table.end() );
+		benchmark::DoNotOptimize( table.data() );
+	}
+}
+
+void bm_key_archive_open( benchmark::State& state )
+{
+	const std::string& path = get_key_archive_path();
+	for ( auto _ : state ) {
+		yan::any_key_archive<yan::serializable_keyable_any> table( path );
+		benchmark::DoNotOptimize( table.size() );
+	}
+}
+
+void bm_key_archive_contains_sorted_vector( benchmark::State& state )
+{
+	std::vector<yan::serializable_keyable_any> table = get_serialize_source();
+	std::sort( table.begin(), table.end() );
+	int64_t i = 0;
+	for ( auto _ : state ) {
+		bool ans = std::binary_search( table.begin(), table.end(), yan::serializable_keyable_any( "key_" + std::to_string( ( i % 333333 ) * 3 + 2 ) ) );
+		benchmark::DoNotOptimize( ans );
+		i++;
+	}
+}
+
+void bm_key_archive_contains_archive( benchmark::State& state )
+{
+	yan::any_key_archive<yan::serializable_keyable_any> table( get_key_archive_path() );
+	int64_t                                             i = 0;
+	for ( auto _ : state ) {
+		bool ans = table.contains( "key_" + std::to_string( ( i % 333333 ) * 3 + 2 ) );
+		benchmark::DoNotOptimize( ans );
+		i++;
+	}
+}
+
+// int64_t, double and std::string values in turn
+const std::vector<yan::formattable_any>& get_format_source( void )
+{
+	static const std::vector<yan::formattable_any> src = []() {
+		std::vector<yan::formattable_any> ans;
+		ans.reserve( num_of_column_elements );
+		for ( size_t i = 0; i < num_of_column_elements; i++ ) {
+			switch ( i % 3 ) {
+				case 0: ans.emplace_back( static_cast<int64_t>( i ) ); break;
+				case 1: ans.emplace_back( static_cast<double>( i ) / 7.0 ); break;
+				default: ans.emplace_back( "value_" + std::to_string( i ) ); break;
+			}
+		}
+		return ans;
+	}();
+	return src;
+}
+
+void bm_format_to_string( benchmark::State& state )
+{
+	const std::vector<yan::formattable_any>& src = get_format_source();
+	for ( auto _ : state ) {
+		size_t total = 0;
+		for ( const auto& v : src ) {
+			std::string str = v.to_string();
+			total += str.size();
+		}
+		benchmark::DoNotOptimize( total );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( src.size() ) );
+}
+
+void bm_format_append( benchmark::State& state )
+{
+	const std::vector<yan::formattable_any>& src = get_format_source();
+	std::string                              out;
+	out.reserve( 256 );
+	for ( auto _ : state ) {
+		size_t total = 0;
+		for ( const auto& v : src ) {
+			out.clear();
+			v.format_append( out );
+			total += out.size();
+		}
+		benchmark::DoNotOptimize( total );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( src.size() ) );
+}
+
+void bm_memory_usage_accumulator_add( benchmark::State& state )
+{
+	std::vector<yan::memory_accounted_any> src;
+	src.reserve( num_of_column_elements );
+	for ( size_t i = 0; i < num_of_column_elements; i++ ) {
+		switch ( i % 3 ) {
+			case 0: src.emplace_back( static_cast<int64_t>( i ) ); break;
+			case 1: src.emplace_back( std::string( 32 + i % 64, 'x' ) ); break;
+			default: src.emplace_back( std::vector<int64_t>( i % 16 ) ); break;
+		}
+	}
+	for ( auto _ : state ) {
+		yan::memory_usage_accumulator<yan::memory_accounted_any> acc;
+		for ( const auto& v : src ) {
+			acc.add( v );
+		}
+		benchmark::DoNotOptimize( acc.total_bytes() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( src.size() ) );
+}
+
+// int64_t, double and std::string values in turn with random order
+std::vector<yan::sortable_any> make_sort_key_source( void )
+{
+	auto& registry = yan::sort_key_type_registry::get_instance();
+	registry.register_type<int64_t>();
+	registry.register_type<double>();
+	registry.register_type<std::string>();
+
+	std::vector<yan::sortable_any> ans;
+	ans.reserve( num_of_column_elements );
+	uint64_t x = 88172645463325252ULL;
+	for ( size_t i = 0; i < num_of_column_elements; i++ ) {
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		switch ( i % 3 ) {
+			case 0: ans.emplace_back( static_cast<int64_t>( x ) ); break;
+			case 1: ans.emplace_back( static_cast<double>( x % 1000000 ) / 7.0 ); break;
+			default: ans.emplace_back( "key_" + std::to_string( x % 1000000 ) ); break;
+		}
+	}
+	return ans;
+}
+
+void bm_sort_key_std_sort_less( benchmark::State& state )
+{
+	const std::vector<yan::sortable_any> src = make_sort_key_source();
+	for ( auto _ : state ) {
+		state.PauseTiming();
+		std::vector<yan::sortable_any> v = src;
+		state.ResumeTiming();
+		std::sort( v.begin(), v.end() );
+		benchmark::DoNotOptimize( v.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( src.size() ) );
+}
+
+void bm_sort_key_sort_by_key( benchmark::State& state )
+{
+	const std::vector<yan::sortable_any> src = make_sort_key_source();
+	for ( auto _ : state ) {
+		state.PauseTiming();
+		std::vector<yan::sortable_any> v = src;
+		state.ResumeTiming();
+		// keys are written to one buffer. the first 8 bytes of the key are compared as integer, and the rest is compared by memcmp.
+		struct key_ref {
+			uint64_t prefix_;
+			uint32_t pos_;
+			uint32_t size_;
+			uint32_t index_;
+		};
+		std::vector<unsigned char> buff;
+		std::vector<key_ref>       keys( v.size() );
+		for ( size_t i = 0; i < v.size(); i++ ) {
+			size_t pos = buff.size();
+			size_t sz  = v[i].sort_key_size();
+			buff.resize( pos + std::max<size_t>( sz, 8 ) );
+			v[i].write_sort_key( buff.data() + pos, sz );
+			uint64_t prefix = 0;
+			for ( size_t j = 0; j < 8; j++ ) {
+				prefix = ( prefix << 8 ) | ( ( j < sz ) ? buff[pos + j] : 0 );
+			}
+			keys[i] = key_ref { prefix, static_cast<uint32_t>( pos ), static_cast<uint32_t>( sz ), static_cast<uint32_t>( i ) };
+		}
+		std::sort( keys.begin(), keys.end(), [&buff]( const key_ref& a, const key_ref& b ) {
+			if ( a.prefix_ != b.prefix_ ) {
+				return a.prefix_ < b.prefix_;
+			}
+			int ret = std::memcmp( buff.data() + a.pos_, buff.data() + b.pos_, std::min( a.size_, b.size_ ) );
+			return ( ret != 0 ) ? ( ret < 0 ) : ( a.size_ < b.size_ );
+		} );
+		std::vector<yan::sortable_any> sorted;
+		sorted.reserve( v.size() );
+		for ( const auto& k : keys ) {
+			sorted.emplace_back( std::move( v[k.index_] ) );
+		}
+		benchmark::DoNotOptimize( sorted.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( src.size() ) );
+}
+
+// int64_t, double and std::string values in turn with random order
+std::vector<yan::weak_ordering_any> make_any_sort_source( size_t n )
+{
+	std::vector<yan::weak_ordering_any> ans;
+	ans.reserve( n );
+	uint64_t x = 88172645463325252ULL;
+	for ( size_t i = 0; i < n; i++ ) {
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		switch ( i % 3 ) {
+			case 0: ans.emplace_back( static_cast<int64_t>( x ) ); break;
+			case 1: ans.emplace_back( static_cast<double>( x % 1000000 ) / 7.0 ); break;
+			default: ans.emplace_back( "key_" + std::to_string( x % 1000000 ) ); break;
+		}
+	}
+	return ans;
+}
+
+template <bool UseAnySort>
+void bm_any_sort( benchmark::State& state )
+{
+	const std::vector<yan::weak_ordering_any> src = make_any_sort_source( static_cast<size_t>( state.range( 0 ) ) );
+	for ( auto _ : state ) {
+		state.PauseTiming();
+		std::vector<yan::weak_ordering_any> v = src;
+		state.ResumeTiming();
+		if constexpr ( UseAnySort ) {
+			yan::any_sort( v );
+		} else {
+			std::sort( v.begin(), v.end() );
+		}
+		benchmark::DoNotOptimize( v.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( src.size() ) );
+}
+
+// pairs of the operands. if Mixed is true, the left operands are int, int64_t and double in turn.
+template <typename Alias, bool Mixed>
+void make_arithmetic_source( size_t n, std::vector<Alias>& a, std::vector<Alias>& b )
+{
+	a.clear();
+	b.clear();
+	for ( size_t i = 0; i < n; i++ ) {
+		int64_t v = static_cast<int64_t>( i % 1000 );
+		if ( Mixed && ( i % 3 == 0 ) ) {
+			a.emplace_back( static_cast<int>( v ) );
+		} else if ( Mixed && ( i % 3 == 1 ) ) {
+			a.emplace_back( static_cast<double>( v ) * 0.5 );
+		} else {
+			a.emplace_back( v );
+		}
+		b.emplace_back( v + 1 );
+	}
+}
+
+// addition by trying constrained_any_cast for each candidate type. This is the way without special_operation_arithmetic.
+template <bool Mixed>
+void bm_arithmetic_cast_candidates( benchmark::State& state )
+{
+	std::vector<yan::copyable_any> a;
+	std::vector<yan::copyable_any> b;
+	make_arithmetic_source<yan::copyable_any, Mixed>( static_cast<size_t>( state.range( 0 ) ), a, b );
+	std::vector<yan::copyable_any> out( a.size() );
+	auto                           to_double = []( const yan::copyable_any& x ) {
+		if ( const int* p = yan::constrained_any_cast<int>( &x ) ) return static_cast<double>( *p );
+		if ( const int64_t* p = yan::constrained_any_cast<int64_t>( &x ) ) return static_cast<double>( *p );
+		return *yan::constrained_any_cast<double>( &x );
+	};
+	for ( auto _ : state ) {
+		for ( size_t i = 0; i < a.size(); i++ ) {
+			const int64_t* p_a = yan::constrained_any_cast<int64_t>( &a[i] );
+			const int64_t* p_b = yan::constrained_any_cast<int64_t>( &b[i] );
+			if ( ( p_a != nullptr ) && ( p_b != nullptr ) ) {
+				out[i] = *p_a + *p_b;
+			} else {
+				out[i] = to_double( a[i] ) + to_double( b[i] );
+			}
+		}
+		benchmark::DoNotOptimize( out.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( a.size() ) );
+}
+
+template <bool Mixed>
+void bm_arithmetic_add( benchmark::State& state )
+{
+	std::vector<yan::arithmetic_any> a;
+	std::vector<yan::arithmetic_any> b;
+	make_arithmetic_source<yan::arithmetic_any, Mixed>( static_cast<size_t>( state.range( 0 ) ), a, b );
+	std::vector<yan::arithmetic_any> out( a.size() );
+	for ( auto _ : state ) {
+		for ( size_t i = 0; i < a.size(); i++ ) {
+			out[i] = a[i].add( b[i] );
+		}
+		benchmark::DoNotOptimize( out.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( a.size() ) );
+}
+
+template <bool Mixed>
+void bm_arithmetic_add_batch( benchmark::State& state )
+{
+	std::vector<yan::arithmetic_any> a;
+	std::vector<yan::arithmetic_any> b;
+	make_arithmetic_source<yan::arithmetic_any, Mixed>( static_cast<size_t>( state.range( 0 ) ), a, b );
+	std::vector<yan::arithmetic_any> out( a.size() );
+	for ( auto _ : state ) {
+		yan::add_batch( a.data(), b.data(), out.data(), a.size() );
+		benchmark::DoNotOptimize( out.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( a.size() ) );
+}
+
+// keys for key_batch. if RunLength is 0, the keys are int64_t only.
+// Otherwise, the keys are the runs of RunLength keys of int64_t, double and short std::string in turn.
+template <size_t RunLength>
+std::vector<yan::keyable_any> make_key_batch_source( size_t n, size_t seed )
+{
+	std::vector<yan::keyable_any> ans;
+	ans.reserve( n );
+	for ( size_t i = 0; i < n; i++ ) {
+		int64_t v    = static_cast<int64_t>( ( i + seed ) % 1000 );
+		size_t  kind = ( RunLength == 0 ) ? 0 : ( i / std::max<size_t>( RunLength, 1 ) ) % 3;
+		if ( kind == 1 ) {
+			ans.emplace_back( static_cast<double>( v ) * 0.5 );
+		} else if ( kind == 2 ) {
+			ans.emplace_back( std::to_string( v ) );
+		} else {
+			ans.emplace_back( v );
+		}
+	}
+	return ans;
+}
+
+template <size_t RunLength>
+void bm_key_batch_hash_each( benchmark::State& state )
+{
+	std::vector<yan::keyable_any> keys = make_key_batch_source<RunLength>( static_cast<size_t>( state.range( 0 ) ), 0 );
+	std::vector<size_t>           out( keys.size() );
+	for ( auto _ : state ) {
+		for ( size_t i = 0; i < keys.size(); i++ ) {
+			out[i] = std::hash<yan::keyable_any>()( keys[i] );
+		}
+		benchmark::DoNotOptimize( out.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( keys.size() ) );
+}
+
+template <size_t RunLength>
+void bm_key_batch_hash_batch( benchmark::State& state )
+{
+	std::vector<yan::keyable_any> keys = make_key_batch_source<RunLength>( static_cast<size_t>( state.range( 0 ) ), 0 );
+	std::vector<size_t>           out( keys.size() );
+	for ( auto _ : state ) {
+		yan::hash_batch( keys.data(), out.data(), keys.size() );
+		benchmark::DoNotOptimize( out.data() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( keys.size() ) );
+}
+
+template <size_t RunLength>
+void bm_key_batch_equal_each( benchmark::State& state )
+{
+	std::vector<yan::keyable_any> a = make_key_batch_source<RunLength>( static_cast<size_t>( state.range( 0 ) ), 0 );
+	std::vector<yan::keyable_any> b = make_key_batch_source<RunLength>( static_cast<size_t>( state.range( 0 ) ), 2 );
+	std::unique_ptr<bool[]>       out( new bool[a.size()] );
+	for ( auto _ : state ) {
+		for ( size_t i = 0; i < a.size(); i++ ) {
+			out[i] = std::equal_to<yan::keyable_any>()( a[i], b[i] );
+		}
+		benchmark::DoNotOptimize( out.get() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( a.size() ) );
+}
+
+template <size_t RunLength>
+void bm_key_batch_equal_batch( benchmark::State& state )
+{
+	std::vector<yan::keyable_any> a = make_key_batch_source<RunLength>( static_cast<size_t>( state.range( 0 ) ), 0 );
+	std::vector<yan::keyable_any> b = make_key_batch_source<RunLength>( static_cast<size_t>( state.range( 0 ) ), 2 );
+	std::unique_ptr<bool[]>       out( new bool[a.size()] );
+	for ( auto _ : state ) {
+		yan::equal_batch( a.data(), b.data(), out.get(), a.size() );
+		benchmark::DoNotOptimize( out.get() );
+	}
+	state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( a.size() ) );
+}
+
+template <size_t N>
+struct bench_capture {
+	std::array<int64_t, N / sizeof( int64_t )> values_ {};
+};
+
+template <size_t N>
+auto make_bench_callable( void )
+{
+	bench_capture<N> cap;
+	cap.values_[0] = 1;
+	return [cap]( int64_t x ) { return x + cap.values_[0]; };
+}
+
+template <typename Func, size_t N>
+void bm_invoke( benchmark::State& state )
+{
+	Func    f( make_bench_callable<N>() );
+	int64_t x = 0;
+	for ( auto _ : state ) {
+		x = f( x );
+		benchmark::DoNotOptimize( x );
+	}
+	state.SetItemsProcessed( state.iterations() );
+}
+
+template <typename Func, size_t N>
+void bm_construct_invoke( benchmark::State& state )
+{
+	int64_t x = 0;
+	for ( auto _ : state ) {
+		Func f( make_bench_callable<N>() );
+		x = f( x );
+		benchmark::DoNotOptimize( x );
+	}
+	state.SetItemsProcessed( state.iterations() );
+}
+
+// ================================================
+// registration
+
+template <typename Alias, size_t N>
+void register_payload_size_benchmarks( const std::string& alias_name )
+{
+	using payload_t          = bench_payload<N>;
+	const std::string suffix = "/" + alias_name + "/" + std::to_string( N );
+
+	benchmark::RegisterBenchmark( ( "construct_from_value" + suffix ).c_str(), bm_construct_from_value<Alias, payload_t> );
+	if constexpr ( std::is_copy_constructible<Alias>::value ) {
+		benchmark::RegisterBenchmark( ( "copy_construct" + suffix ).c_str(), bm_copy_construct<Alias, payload_t> );
+		benchmark::RegisterBenchmark( ( "same_type_assign" + suffix ).c_str(), bm_same_type_assign<Alias, payload_t> );
+		benchmark::RegisterBenchmark( ( "cross_type_assign" + suffix ).c_str(), bm_cross_type_assign<Alias, payload_t> );
+	}
+	benchmark::RegisterBenchmark( ( "move_construct" + suffix ).c_str(), bm_move_construct<Alias, payload_t> );
+	benchmark::RegisterBenchmark( ( "emplace" + suffix ).c_str(), bm_emplace<Alias, payload_t> );
+	benchmark::RegisterBenchmark( ( "constrained_any_cast" + suffix ).c_str(), bm_cast<Alias, payload_t> );
+	if constexpr ( is_callable_less<Alias>::value ) {
+		benchmark::RegisterBenchmark( ( "less" + suffix ).c_str(), bm_less<Alias, payload_t> );
+	}
+	if constexpr ( is_callable_equal_to<Alias>::value ) {
+		benchmark::RegisterBenchmark( ( "equal_to" + suffix ).c_str(), bm_equal_to<Alias, payload_t> );
+	}
+	if constexpr ( is_callable_hash_value<Alias>::value ) {
+		benchmark::RegisterBenchmark( ( "hash_value" + suffix ).c_str(), bm_hash_value<Alias, payload_t> );
+	}
+}
+
+template <typename Alias, size_t... PayloadSizes>
+void register_alias_benchmarks( const std::string& alias_name, std::index_sequence<PayloadSizes...> )
+{
+	benchmark::RegisterBenchmark( ( "default_construct/" + alias_name ).c_str(), bm_default_construct<Alias> );
+
+	if constexpr ( std::is_copy_constructible<Alias>::value ) {
+		benchmark::RegisterBenchmark( ( "same_type_assign_string/" + alias_name ).c_str(), bm_same_type_assign_string<Alias> );
+		benchmark::RegisterBenchmark( ( "same_type_assign_string_value/" + alias_name ).c_str(), bm_same_type_assign_string_value<Alias> );
+	}
+	benchmark::RegisterBenchmark( ( "same_type_move_assign_string/" + alias_name ).c_str(), bm_same_type_move_assign_string<Alias> );
+
+	benchmark::RegisterBenchmark( ( "swap_sso_sso/" + alias_name ).c_str(), bm_swap<Alias, sso_payload, sso_payload> );
+	benchmark::RegisterBenchmark( ( "swap_heap_heap/" + alias_name ).c_str(), bm_swap<Alias, heap_payload, heap_payload> );
+	benchmark::RegisterBenchmark( ( "swap_sso_heap/" + alias_name ).c_str(), bm_swap<Alias, sso_payload, heap_payload> );
+	benchmark::RegisterBenchmark( ( "swap_heap_sso/" + alias_name ).c_str(), bm_swap<Alias, heap_payload, sso_payload> );
+
+	( register_payload_size_benchmarks<Alias, PayloadSizes>( alias_name ), ... );
+}
+
+template <typename Alias, size_t... PayloadSizes>
+void register_heap_carrier_pool_benchmarks( const std::string& alias_name, std::index_sequence<PayloadSizes...> )
+{
+	( benchmark::RegisterBenchmark( ( "copy_construct/" + alias_name + "/" + std::to_string( PayloadSizes ) ).c_str(), bm_copy_construct<Alias, bench_payload<PayloadSizes>> ), ... );
+	( benchmark::RegisterBenchmark( ( "cross_type_assign/" + alias_name + "/" + std::to_string( PayloadSizes ) ).c_str(), bm_cross_type_assign<Alias, bench_payload<PayloadSizes>> ), ... );
+}
+
+template <typename Alias>
+void register_fill_benchmarks( const std::string& alias_name )
+{
+	benchmark::RegisterBenchmark( ( "fill_10M/" + alias_name + "/push_back" ).c_str(), bm_fill_push_back<Alias> )->Unit( benchmark::kMillisecond );
+	benchmark::RegisterBenchmark( ( "fill_10M/" + alias_name + "/make_any_range" ).c_str(), bm_fill_make_any_range<Alias> )->Unit( benchmark::kMillisecond );
+	benchmark::RegisterBenchmark( ( "fill_10M/" + alias_name + "/assign_loop" ).c_str(), bm_fill_assign_loop<Alias> )->Unit( benchmark::kMillisecond );
+	benchmark::RegisterBenchmark( ( "fill_10M/" + alias_name + "/assign_all" ).c_str(), bm_fill_assign_all<Alias> )->Unit( benchmark::kMillisecond );
+}
+
+template <typename Alias>
+void register_column_benchmarks( const std::string& alias_name )
+{
+	benchmark::RegisterBenchmark( ( "column_scan_1M/std::vector<" + alias_name + ">" ).c_str(), bm_column_scan_vector<Alias> )->Unit( benchmark::kMicrosecond );
+	benchmark::RegisterBenchmark( ( "column_scan_1M/any_column<" + alias_name + ">" ).c_str(), bm_column_scan_any_column<Alias> )->Unit( benchmark::kMicrosecond );
+}
+
+template <typename Alias>
+void register_packed_benchmarks( const std::string& alias_name )
+{
+	benchmark::RegisterBenchmark( ( "packed_hash_1M/std::vector<" + alias_name + ">" ).c_str(), bm_packed_hash_vector<Alias> )->Unit( benchmark::kMicrosecond );
+	benchmark::RegisterBenchmark( ( "packed_hash_1M/packed_any_vector<" + alias_name + ">" ).c_str(), bm_packed_hash_packed_any_vector<Alias> )->Unit( benchmark::kMicrosecond );
+}
+
+template <size_t... PayloadSizes>
+void register_request_scope_benchmarks( std::index_sequence<PayloadSizes...> )
+{
+	( benchmark::RegisterBenchmark( ( "request_scope/copyable_any/" + std::to_string( PayloadSizes ) ).c_str(), bm_request_scope_default<bench_payload<PayloadSizes>> ), ... );
+	( benchmark::RegisterBenchmark( ( "request_scope/arena_copyable_any/" + std::to_string( PayloadSizes ) ).c_str(), bm_request_scope_arena<bench_payload<PayloadSizes>> ), ... );
+	( benchmark::RegisterBenchmark( ( "request_scope/any_arena_create/" + std::to_string( PayloadSizes ) ).c_str(), bm_request_scope_arena_create<bench_payload<PayloadSizes>> ), ... );
+}
+
+template <typename Func, size_t... CaptureSizes>
+void register_invoke_benchmarks( const std::string& func_name, std::index_sequence<CaptureSizes...> )
+{
+	( benchmark::RegisterBenchmark( ( "invoke/" + func_name + "/" + std::to_string( CaptureSizes ) ).c_str(), bm_invoke<Func, CaptureSizes> ), ... );
+	( benchmark::RegisterBenchmark( ( "construct_invoke/" + func_name + "/" + std::to_string( CaptureSizes ) ).c_str(), bm_construct_invoke<Func, CaptureSizes> ), ... );
+}
+
+using pooled_copyable_any = yan::constrained_any<yan::impl::special_operation_copyable, yan::impl::special_operation_pooled_heap>;
+
+// payload sizes that the value carrier(payload size + vptr) fits to the block of 256 bytes - 4KB of the heap carrier pool.
+using heap_carrier_pool_payload_sizes = std::index_sequence<248, 504, 1016, 2040, 4088>;
+
+// payload sizes across impl::sso_buff_size(=120). The size of carrier is payload size + vptr of carrier.
+using payload_sizes = std::index_sequence<8, 32, 64, 96, 112, 120, 128, 136, 256, 1024>;
+
+int main( int argc, char** argv )
+{
+	register_alias_benchmarks<yan::copyable_any>( "copyable_any", payload_sizes {} );
+	register_alias_benchmarks<yan::move_only_any>( "move_only_any", payload_sizes {} );
+	register_alias_benchmarks<yan::weak_ordering_any>( "weak_ordering_any", payload_sizes {} );
+	register_alias_benchmarks<yan::unordered_key_any>( "unordered_key_any", payload_sizes {} );
+	register_alias_benchmarks<yan::keyable_any>( "keyable_any", payload_sizes {} );
+	register_alias_benchmarks<yan::compact_keyable_any>( "compact_keyable_any", payload_sizes {} );
+	register_heap_carrier_pool_benchmarks<yan::copyable_any>( "copyable_any", heap_carrier_pool_payload_sizes {} );
+	register_heap_carrier_pool_benchmarks<pooled_copyable_any>( "pooled_copyable_any", heap_carrier_pool_payload_sizes {} );
+	register_request_scope_benchmarks( std::index_sequence<8, 256, 1024> {} );
+	benchmark::RegisterBenchmark( "dispatch_hash_value/keyable_any/1_type", bm_dispatch_hash_value<yan::keyable_any, 1> )->Unit( benchmark::kMicrosecond );
+	benchmark::RegisterBenchmark( "dispatch_hash_value/keyable_any/3_types", bm_dispatch_hash_value<yan::keyable_any, 3> )->Unit( benchmark::kMicrosecond );
+	benchmark::RegisterBenchmark( "dispatch_hash_value/keyable_any/6_types", bm_dispatch_hash_value<yan::keyable_any, 6> )->Unit( benchmark::kMicrosecond );
+	register_fill_benchmarks<yan::keyable_any>( "keyable_any" );
+	register_fill_benchmarks<yan::compact_keyable_any>( "compact_keyable_any" );
+	register_column_benchmarks<yan::copyable_any>( "copyable_any" );
+	register_packed_benchmarks<yan::keyable_any>( "keyable_any" );
+	benchmark::RegisterBenchmark( "serialize_1M/serialize", bm_serialize )->Unit( benchmark::kMillisecond );
+	benchmark::RegisterBenchmark( "serialize_1M/deserialize", bm_deserialize<false> )->Unit( benchmark::kMillisecond );
+	benchmark::RegisterBenchmark( "serialize_1M/deserialize_view", bm_deserialize<true> )->Unit( benchmark::kMillisecond );
+	benchmark::RegisterBenchmark( "key_archive_1M/build_sorted_vector", bm_key_archive_build_sorted_vector )->Unit( benchmark::kMillisecond );
+	benchmark::RegisterBenchmark( "key_archive_1M/open", bm_key_archive_open )->Unit( benchmark::kMicrosecond );
+	benchmark::RegisterBenchmark( "key_archive_1M/contains_sorted_vector", bm_key_archive_contains_sorted_vector );
+	benchmark::RegisterBenchmark( "key_archive_1M/contains_archive", bm_key_archive_contains_archive );
+	register_packed_benchmarks<yan::compact_keyable_any>( "compact_keyable_any" );
+	benchmark::RegisterBenchmark( "format_1M/to_string", bm_format_to_string )->Unit( benchmark::kMillisecond );
+	benchmark::RegisterBenchmark( "format_1M/format_append", bm_format_append )->Unit( benchmark::kMillisecond );
+	benchmark::RegisterBenchmark( "sort_key_1M/std_sort_less", bm_sort_key_std_sort_less )->Unit( benchmark::kMillisecond );
+	benchmark::RegisterBenchmark( "sort_key_1M/sort_by_key", bm_sort_key_sort_by_key )->Unit( benchmark::kMillisecond );
+	benchmark::RegisterBenchmark( "memory_usage_1M/accumulator_add", bm_memory_usage_accumulator_add )->Unit( benchmark::kMillisecond );
+	benchmark::RegisterBenchmark( "arithmetic/cast_candidates/same", bm_arithmetic_cast_candidates<false> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "arithmetic/cast_candidates/mixed", bm_arithmetic_cast_candidates<true> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "arithmetic/add/same", bm_arithmetic_add<false> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "arithmetic/add/mixed", bm_arithmetic_add<true> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "arithmetic/add_batch/same", bm_arithmetic_add_batch<false> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "arithmetic/add_batch/mixed", bm_arithmetic_add_batch<true> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "key_batch/hash_each/same", bm_key_batch_hash_each<0> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "key_batch/hash_each/mixed", bm_key_batch_hash_each<1> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "key_batch/hash_each/runs64", bm_key_batch_hash_each<64> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "key_batch/hash_batch/same", bm_key_batch_hash_batch<0> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "key_batch/hash_batch/mixed", bm_key_batch_hash_batch<1> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "key_batch/hash_batch/runs64", bm_key_batch_hash_batch<64> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "key_batch/equal_each/same", bm_key_batch_equal_each<0> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "key_batch/equal_each/mixed", bm_key_batch_equal_each<1> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "key_batch/equal_each/runs64", bm_key_batch_equal_each<64> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "key_batch/equal_batch/same", bm_key_batch_equal_batch<0> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "key_batch/equal_batch/mixed", bm_key_batch_equal_batch<1> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	benchmark::RegisterBenchmark( "key_batch/equal_batch/runs64", bm_key_batch_equal_batch<64> )->Unit( benchmark::kMicrosecond )->Arg( 4096 )->Arg( 1000000 );
+	auto* p_std_sort = benchmark::RegisterBenchmark( "any_sort/std_sort_less", bm_any_sort<false> )->Unit( benchmark::kMillisecond )->Arg( 1000000 )->Arg( 10000000 );
+	auto* p_any_sort = benchmark::RegisterBenchmark( "any_sort/yan_any_sort", bm_any_sort<true> )->Unit( benchmark::kMillisecond )->Arg( 1000000 )->Arg( 10000000 );
+	if ( std::getenv( "YAN_BENCHMARK_LARGE_SORT" ) != nullptr ) {
+		p_std_sort->Arg( 100000000 );
+		p_any_sort->Arg( 100000000 );
+	}
+	register_invoke_benchmarks<yan::function_any<int64_t( int64_t )>>( "function_any", std::index_sequence<8, 64> {} );
+	register_invoke_benchmarks<std::function<int64_t( int64_t )>>( "std::function", std::index_sequence<8, 64> {} );
+#if defined( __cpp_lib_move_only_function )
+	register_invoke_benchmarks<std::move_only_function<int64_t( int64_t )>>( "std::move_only_function", std::index_sequence<8, 64> {} );
+#endif
+
+	benchmark::Initialize( &argc, argv );
+	if ( benchmark::ReportUnrecognizedArguments( argc, argv ) ) {
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file test_performance_any_queue.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief throughput comparison b/w yan::any_queue and std::deque with std::mutex
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * usage: test_performance_any_queue [measurement time per case in msec]
+ *
+ * For each number of threads, a half of threads are producers and the rest are consumers.
+ * In case of 1 thread, the thread pushes and pops alternately.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "any_queue.hpp"
+
+class mutex_deque_queue {
+public:
+	explicit mutex_deque_queue( size_t capacity )
+	  : capacity_( capacity )
+	{
+	}
+
+	template <class T, class... Args>
+	bool try_emplace( Args&&... args )
+	{
+		std::lock_guard<std::mutex> lk( mtx_ );
+		if ( deq_.size() >= capacity_ ) return false;
+		deq_.emplace_back( std::in_place_type<T>, std::forward<Args>( args )... );
+		return true;
+	}
+
+	bool try_pop( yan::move_only_any& out )
+	{
+		std::lock_guard<std::mutex> lk( mtx_ );
+		if ( deq_.empty() ) return false;
+		out = std::move( deq_.front() );
+		deq_.pop_front();
+		return true;
+	}
+
+private:
+	const size_t                   capacity_;
+	std::mutex                     mtx_;
+	std::deque<yan::move_only_any> deq_;
+};
+
+template <typename Queue>
+size_t producer_consumer_loop( Queue& q, bool is_producer, bool is_consumer, std::atomic<bool>* p_stop )
+{
+	yan::move_only_any out;
+	size_t             count = 0;
+
+	while ( p_stop->load( std::memory_order_relaxed ) == false ) {
+		if ( is_producer ) {
+			if ( q.template try_emplace<size_t>( count ) ) {
+				++count;
+			} else {
+				std::this_thread::yield();
+			}
+		}
+		if ( is_consumer ) {
+			if ( q.try_pop( out ) ) {
+				++count;
+			} else if ( !is_producer ) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	return count;
+}
+
+template <typename Queue>
+double measure_ops_per_sec( Queue& q, size_t num_of_threads, std::chrono::milliseconds measurement_time )
+{
+	std::atomic<bool>   stop_flag( false );
+	std::atomic<size_t> total_count( 0 );
+
+	std::vector<std::thread> threads;
+	for ( size_t i = 0; i < num_of_threads; i++ ) {
+		bool is_producer = ( num_of_threads == 1 ) || ( ( i % 2 ) == 0 );
+		bool is_consumer = ( num_of_threads == 1 ) || ( ( i % 2 ) == 1 );
+		threads.emplace_back( [&q, &stop_flag, &total_count, is_producer, is_consumer]() {
+			total_count += producer_consumer_loop( q, is_producer, is_consumer, &stop_flag );
+		} );
+	}
+
+	std::this_thread::sleep_for( measurement_time );
+	stop_flag = true;
+
+	for ( auto& t : threads ) {
+		t.join();
+	}
+
+	return static_cast<double>( total_count.load() ) * 1000.0 / static_cast<double>( measurement_time.count() );
+}
+
+int main( int argc, char* argv[] )
+{
+	std::chrono::milliseconds measurement_time( 100 );
+	if ( argc > 1 ) {
+		measurement_time = std::chrono::milliseconds( std::atol( argv[1] ) );
+	}
+
+	printf( "threads, any_queue[ops/s], std::deque+std::mutex[ops/s]\n" );
+	for ( size_t num_of_threads = 1; num_of_threads <= 32; num_of_threads *= 2 ) {
+		yan::any_queue<yan::move_only_any> sut( 1024 );
+		double                             sut_ops = measure_ops_per_sec( sut, num_of_threads, measurement_time );
+
+		mutex_deque_queue ref( 1024 );
+		double            ref_ops = measure_ops_per_sec( ref, num_of_threads, measurement_time );
+
+		printf( "%zu, %.0f, %.0f\n", num_of_threads, sut_ops, ref_ops );
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,293 @@
+/**
+ * @file test_performance_comparison_constrained_any.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief comparison of constrained_any with std::any and std::variant on same workloads
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * usage: test_performance_comparison_constrained_any [number of elements] [number of repetitions]
+ *
+ * Workloads:
+ * @li vector fill: push_back of int, double and std::string values in turn to std::vector
+ * @li sort: std::sort of weak_ordering_any/keyable_any, their compact variants and std::variant
+ * @li unordered_map: insert and lookup of unordered_key_any/keyable_any, their compact variants and std::variant with a visitor hash
+ *
+ * Each workload reports the percentiles of latency per operation and the memory footprint per element.
+ * Latency samples are taken per batch of operations for vector fill and unordered_map, and per repetition for sort.
+ * Memory footprint is sizeof of the element type and the heap bytes per element that are counted by the replacement of global operator new/delete.
+ * The heap bytes include the storage of the container itself.
+ *
+ * This program is built for both of C++17 and C++20, because constrained_any has the different implementation for each.
+ */
+
+#include <algorithm>
+#include <any>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "constrained_any.hpp"
+
+// ================================================
+// heap usage counter as the replacement of global operator new/delete
+
+namespace {
+
+constexpr size_t alloc_header_size = alignof( std::max_align_t );
+
+std::atomic<size_t> live_heap_bytes( 0 );
+
+inline void* counted_allocate( size_t sz )
+{
+	unsigned char* p_raw = static_cast<unsigned char*>( std::malloc( alloc_header_size + sz ) );
+	if ( p_raw == nullptr ) {
+		throw std::bad_alloc();
+	}
+	*reinterpret_cast<size_t*>( p_raw ) = sz;
+	live_heap_bytes.fetch_add( sz, std::memory_order_relaxed );
+	return p_raw + alloc_header_size;
+}
+
+inline void counted_deallocate( void* p ) noexcept
+{
+	if ( p == nullptr ) return;
+
+	unsigned char* p_raw = static_cast<unsigned char*>( p ) - alloc_header_size;
+	live_heap_bytes.fetch_sub( *reinterpret_cast<size_t*>( p_raw ), std::memory_order_relaxed );
+	std::free( p_raw );
+}
+
+}   // namespace
+
+void* operator new( size_t sz )
+{
+	return counted_allocate( sz );
+}
+
+void operator delete( void* p ) noexcept
+{
+	counted_deallocate( p );
+}
+
+void operator delete( void* p, size_t ) noexcept
+{
+	counted_deallocate( p );
+}
+
+// ================================================
+
+using variant_t = std::variant<int, double, std::string>;
+
+struct variant_visitor_hash {
+	size_t operator()( const variant_t& v ) const
+	{
+		return std::visit(
+			[&v]( const auto& x ) -> size_t {
+				using x_t = std::decay_t<decltype( x )>;
+				return std::hash<x_t>()( x ) ^ v.index();
+			},
+			v );
+	}
+};
+
+struct latency_stat {
+	double p50_;
+	double p90_;
+	double p99_;
+};
+
+latency_stat calc_latency_stat( std::vector<double> samples )
+{
+	if ( samples.empty() ) return latency_stat { 0.0, 0.0, 0.0 };
+
+	std::sort( samples.begin(), samples.end() );
+	auto percentile = [&samples]( size_t p ) {
+		size_t idx = ( samples.size() - 1 ) * p / 100;
+		return samples[idx];
+	};
+	return latency_stat { percentile( 50 ), percentile( 90 ), percentile( 99 ) };
+}
+
+template <typename F>
+double measure_ns( F&& f )
+{
+	auto start = std::chrono::steady_clock::now();
+	f();
+	auto end = std::chrono::steady_clock::now();
+	return static_cast<double>( std::chrono::duration_cast<std::chrono::nanoseconds>( end - start ).count() );
+}
+
+void print_result( const char* workload, const char* type_name, const latency_stat& stat, size_t sizeof_element, double heap_bytes_per_element )
+{
+	printf( "%s, %s, %.1f, %.1f, %.1f, %zu, %.1f\n", workload, type_name, stat.p50_, stat.p90_, stat.p99_, sizeof_element, heap_bytes_per_element );
+}
+
+// ================================================
+
+constexpr size_t batch_size = 64;
+
+// int, double and std::string in turn. std::string is long enough to be stored in the heap.
+template <typename T>
+T make_element( size_t i )
+{
+	switch ( i % 3 ) {
+		case 0:
+			return T( static_cast<int>( i ) );
+		case 1:
+			return T( static_cast<double>( i ) );
+		default:
+			return T( std::string( "string value over SSO of std::string " ) + std::to_string( i ) );
+	}
+}
+
+template <typename T>
+void run_vector_fill( const char* type_name, size_t num_of_elements, size_t num_of_repetitions )
+{
+	std::vector<double> samples;
+	double              heap_bytes_per_element = 0.0;
+
+	for ( size_t r = 0; r < num_of_repetitions; r++ ) {
+		size_t before = live_heap_bytes.load();
+		{
+			std::vector<T> v;
+			v.reserve( num_of_elements );
+			for ( size_t i = 0; i < num_of_elements; i += batch_size ) {
+				size_t end = std::min( num_of_elements, i + batch_size );
+				double ns  = measure_ns( [&]() {
+					for ( size_t j = i; j < end; j++ ) {
+						v.push_back( make_element<T>( j ) );
+					}
+				} );
+				samples.push_back( ns / static_cast<double>( end - i ) );
+			}
+			heap_bytes_per_element = static_cast<double>( live_heap_bytes.load() - before ) / static_cast<double>( num_of_elements );
+		}
+	}
+
+	print_result( "vector fill", type_name, calc_latency_stat( std::move( samples ) ), sizeof( T ), heap_bytes_per_element );
+}
+
+template <typename T>
+void run_sort( const char* type_name, size_t num_of_elements, size_t num_of_repetitions )
+{
+	std::vector<double> samples;
+	double              heap_bytes_per_element = 0.0;
+
+	for ( size_t r = 0; r < num_of_repetitions; r++ ) {
+		size_t         before = live_heap_bytes.load();
+		std::vector<T> v;
+		v.reserve( num_of_elements );
+		for ( size_t i = 0; i < num_of_elements; i++ ) {
+			// scrambled order
+			v.push_back( make_element<T>( ( i * 7919 ) % num_of_elements ) );
+		}
+		heap_bytes_per_element = static_cast<double>( live_heap_bytes.load() - before ) / static_cast<double>( num_of_elements );
+
+		double ns = measure_ns( [&]() {
+			std::sort( v.begin(), v.end() );
+		} );
+		samples.push_back( ns / static_cast<double>( num_of_elements ) );
+	}
+
+	print_result( "sort", type_name, calc_latency_stat( std::move( samples ) ), sizeof( T ), heap_bytes_per_element );
+}
+
+template <typename T, typename Hash = std::hash<T>>
+void run_unordered_map( const char* type_name, size_t num_of_elements, size_t num_of_repetitions )
+{
+	std::vector<double> insert_samples;
+	std::vector<double> lookup_samples;
+	double              heap_bytes_per_element = 0.0;
+
+	for ( size_t r = 0; r < num_of_repetitions; r++ ) {
+		std::vector<T> keys;
+		keys.reserve( num_of_elements );
+		for ( size_t i = 0; i < num_of_elements; i++ ) {
+			keys.push_back( make_element<T>( i ) );
+		}
+
+		size_t before = live_heap_bytes.load();
+		{
+			std::unordered_map<T, size_t, Hash> m;
+			for ( size_t i = 0; i < num_of_elements; i += batch_size ) {
+				size_t end = std::min( num_of_elements, i + batch_size );
+				double ns  = measure_ns( [&]() {
+					for ( size_t j = i; j < end; j++ ) {
+						m.emplace( keys[j], j );
+					}
+				} );
+				insert_samples.push_back( ns / static_cast<double>( end - i ) );
+			}
+			heap_bytes_per_element = static_cast<double>( live_heap_bytes.load() - before ) / static_cast<double>( num_of_elements );
+
+			size_t found = 0;
+			for ( size_t i = 0; i < num_of_elements; i += batch_size ) {
+				size_t end = std::min( num_of_elements, i + batch_size );
+				double ns  = measure_ns( [&]() {
+					for ( size_t j = i; j < end; j++ ) {
+						found += m.count( keys[j] );
+					}
+				} );
+				lookup_samples.push_back( ns / static_cast<double>( end - i ) );
+			}
+			if ( found != num_of_elements ) {
+				fprintf( stderr, "unexpected lookup result of %s: %zu\n", type_name, found );
+				std::exit( EXIT_FAILURE );
+			}
+		}
+	}
+
+	print_result( "unordered_map insert", type_name, calc_latency_stat( std::move( insert_samples ) ), sizeof( T ), heap_bytes_per_element );
+	print_result( "unordered_map lookup", type_name, calc_latency_stat( std::move( lookup_samples ) ), sizeof( T ), heap_bytes_per_element );
+}
+
+int main( int argc, char* argv[] )
+{
+	size_t num_of_elements    = 100000;
+	size_t num_of_repetitions = 10;
+	if ( argc > 1 ) {
+		num_of_elements = std::max<size_t>( 1, static_cast<size_t>( std::atol( argv[1] ) ) );
+	}
+	if ( argc > 2 ) {
+		num_of_repetitions = std::max<size_t>( 1, static_cast<size_t>( std::atol( argv[2] ) ) );
+	}
+
+	printf( "C++ standard: %ld\n", static_cast<long>( __cplusplus ) );
+	printf( "workload, type, p50[ns/op], p90[ns/op], p99[ns/op], sizeof[bytes], heap[bytes/element]\n" );
+
+	run_vector_fill<std::any>( "std::any", num_of_elements, num_of_repetitions );
+	run_vector_fill<variant_t>( "std::variant", num_of_elements, num_of_repetitions );
+	run_vector_fill<yan::copyable_any>( "yan::copyable_any", num_of_elements, num_of_repetitions );
+	run_vector_fill<yan::move_only_any>( "yan::move_only_any", num_of_elements, num_of_repetitions );
+	run_vector_fill<yan::weak_ordering_any>( "yan::weak_ordering_any", num_of_elements, num_of_repetitions );
+	run_vector_fill<yan::unordered_key_any>( "yan::unordered_key_any", num_of_elements, num_of_repetitions );
+	run_vector_fill<yan::keyable_any>( "yan::keyable_any", num_of_elements, num_of_repetitions );
+	run_vector_fill<yan::compact_keyable_any>( "yan::compact_keyable_any", num_of_elements, num_of_repetitions );
+
+	run_sort<variant_t>( "std::variant", num_of_elements, num_of_repetitions );
+	run_sort<yan::weak_ordering_any>( "yan::weak_ordering_any", num_of_elements, num_of_repetitions );
+	run_sort<yan::keyable_any>( "yan::keyable_any", num_of_elements, num_of_repetitions );
+	run_sort<yan::compact_weak_ordering_any>( "yan::compact_weak_ordering_any", num_of_elements, num_of_repetitions );
+	run_sort<yan::compact_keyable_any>( "yan::compact_keyable_any", num_of_elements, num_of_repetitions );
+
+	run_unordered_map<variant_t, variant_visitor_hash>( "std::variant", num_of_elements, num_of_repetitions );
+	run_unordered_map<yan::unordered_key_any>( "yan::unordered_key_any", num_of_elements, num_of_repetitions );
+	run_unordered_map<yan::keyable_any>( "yan::keyable_any", num_of_elements, num_of_repetitions );
+	run_unordered_map<yan::compact_unordered_key_any>( "yan::compact_unordered_key_any", num_of_elements, num_of_repetitions );
+	run_unordered_map<yan::compact_keyable_any>( "yan::compact_keyable_any", num_of_elements, num_of_repetitions );
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,272 @@
+/**
+ * @file test_performance_scaling_constrained_any.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief multi-threaded scaling benchmark of constrained_any
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ * @details
+ * usage: test_performance_scaling_constrained_any [max number of threads] [measurement time per case in msec]
+ *
+ * This benchmark measures ops/s per thread of below combinations:
+ * @li number of threads: 1, 2, 4, ... max number of threads
+ * @li payload: SSO-sized value, heap-sized value, heap-sized value with pooled allocator
+ * @li operation mix: copy construction, move construction, assignment, swap, constrained_any_cast
+ * @li layout of working set of each thread: packed(adjacent threads share cache lines) and padded(each thread owns cache lines)
+ *
+ * The pooled allocator is the replacement of global operator new/delete in this benchmark.
+ * It is enabled on runtime, and it keeps freed blocks in the thread local freelist for each size class.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "constrained_any.hpp"
+
+// ================================================
+// pooled allocator as the replacement of global operator new/delete
+
+namespace {
+
+constexpr size_t pool_block_header_size = alignof( std::max_align_t );
+constexpr size_t pool_size_class_unit   = 64;
+constexpr size_t pool_num_of_classes    = 64;   // up to 4KB
+constexpr size_t pool_no_size_class     = SIZE_MAX;
+
+std::atomic<bool> pooled_allocator_enabled( false );
+
+struct pool_free_node {
+	pool_free_node* p_next_;
+};
+
+// This is trivially destructible to avoid the access after destruction from operator delete at thread exit.
+// Therefore, blocks in the freelist of an exited thread are not returned. That is enough for this benchmark.
+struct pool_thread_local_freelist {
+	pool_free_node* heads_[pool_num_of_classes];
+};
+
+thread_local pool_thread_local_freelist tl_freelist {};
+
+inline size_t get_size_class( size_t sz )
+{
+	size_t cls = ( sz + pool_size_class_unit - 1 ) / pool_size_class_unit;
+	if ( ( cls == 0 ) || ( cls > pool_num_of_classes ) ) return pool_no_size_class;
+	return cls - 1;
+}
+
+inline void* pool_allocate( size_t sz )
+{
+	size_t cls = pooled_allocator_enabled.load( std::memory_order_relaxed ) ? get_size_class( sz ) : pool_no_size_class;
+	if ( cls != pool_no_size_class ) {
+		pool_free_node* p_node = tl_freelist.heads_[cls];
+		if ( p_node != nullptr ) {
+			tl_freelist.heads_[cls] = p_node->p_next_;
+			return p_node;
+		}
+		sz = ( cls + 1 ) * pool_size_class_unit;
+	}
+
+	unsigned char* p_raw = static_cast<unsigned char*>( std::malloc( pool_block_header_size + sz ) );
+	if ( p_raw == nullptr ) {
+		throw std::bad_alloc();
+	}
+	*reinterpret_cast<size_t*>( p_raw ) = cls;
+	return p_raw + pool_block_header_size;
+}
+
+inline void pool_deallocate( void* p ) noexcept
+{
+	if ( p == nullptr ) return;
+
+	unsigned char* p_raw = static_cast<unsigned char*>( p ) - pool_block_header_size;
+	size_t         cls   = *reinterpret_cast<size_t*>( p_raw );
+	if ( cls != pool_no_size_class ) {
+		// a block freed by other thread moves to the freelist of this thread.
+		pool_free_node* p_node  = static_cast<pool_free_node*>( p );
+		p_node->p_next_         = tl_freelist.heads_[cls];
+		tl_freelist.heads_[cls] = p_node;
+		return;
+	}
+	std::free( p_raw );
+}
+
+}   // namespace
+
+void* operator new( size_t sz )
+{
+	return pool_allocate( sz );
+}
+
+void operator delete( void* p ) noexcept
+{
+	pool_deallocate( p );
+}
+
+void operator delete( void* p, size_t ) noexcept
+{
+	pool_deallocate( p );
+}
+
+// ================================================
+
+struct payload_sso {
+	std::array<uint64_t, 4> v_;
+};
+static_assert( sizeof( payload_sso ) < yan::impl::sso_buff_size, "payload_sso should be stored in the inline buffer" );
+
+struct payload_heap {
+	std::array<uint64_t, 64> v_;
+};
+static_assert( sizeof( payload_heap ) > yan::impl::sso_buff_size, "payload_heap should be stored in the heap" );
+
+enum class op_mix {
+	copy,
+	move,
+	assign,
+	swap,
+	cast
+};
+
+const char* op_mix_name( op_mix mix )
+{
+	switch ( mix ) {
+		case op_mix::copy:
+			return "copy";
+		case op_mix::move:
+			return "move";
+		case op_mix::assign:
+			return "assign";
+		case op_mix::swap:
+			return "swap";
+		case op_mix::cast:
+			return "cast";
+	}
+	return "unknown";
+}
+
+struct packed_working_set {
+	yan::copyable_any a_;
+	yan::copyable_any b_;
+};
+
+struct alignas( 64 ) padded_working_set {
+	yan::copyable_any a_;
+	yan::copyable_any b_;
+};
+
+template <typename Payload, typename WorkingSet>
+size_t run_op_mix( op_mix mix, WorkingSet& ws, std::atomic<bool>* p_stop )
+{
+	Payload payload {};
+	size_t  count = 0;
+
+	ws.a_ = payload;
+	ws.b_ = static_cast<int>( 1 );
+
+	while ( p_stop->load( std::memory_order_relaxed ) == false ) {
+		switch ( mix ) {
+			case op_mix::copy: {
+				yan::copyable_any tmp( ws.a_ );
+				count += tmp.has_value() ? 1U : 0U;
+			} break;
+			case op_mix::move: {
+				yan::copyable_any tmp( std::move( ws.a_ ) );
+				count += tmp.has_value() ? 1U : 0U;
+			} break;
+			case op_mix::assign: {
+				// same type assignment and type changing assignment
+				ws.a_ = payload;
+				ws.b_ = ws.a_;
+				ws.b_ = static_cast<int>( count );
+				count++;
+			} break;
+			case op_mix::swap: {
+				ws.a_.swap( ws.b_ );
+				count++;
+			} break;
+			case op_mix::cast: {
+				const Payload* p = yan::constrained_any_cast<Payload>( &ws.a_ );
+				if ( p == nullptr ) {
+					p = yan::constrained_any_cast<Payload>( &ws.b_ );
+				}
+				count += ( p != nullptr ) ? 1U : 0U;
+			} break;
+		}
+	}
+
+	return count;
+}
+
+template <typename Payload, typename WorkingSet>
+double measure_ops_per_sec_per_thread( op_mix mix, size_t num_of_threads, std::chrono::milliseconds measurement_time )
+{
+	std::vector<WorkingSet>  working_sets( num_of_threads );
+	std::atomic<bool>        stop_flag( false );
+	std::atomic<size_t>      total_count( 0 );
+	std::vector<std::thread> threads;
+
+	for ( size_t i = 0; i < num_of_threads; i++ ) {
+		threads.emplace_back( [&, i]() {
+			total_count += run_op_mix<Payload>( mix, working_sets[i], &stop_flag );
+		} );
+	}
+
+	std::this_thread::sleep_for( measurement_time );
+	stop_flag = true;
+
+	for ( auto& t : threads ) {
+		t.join();
+	}
+
+	double ops_per_sec = static_cast<double>( total_count.load() ) * 1000.0 / static_cast<double>( measurement_time.count() );
+	return ops_per_sec / static_cast<double>( num_of_threads );
+}
+
+template <typename Payload>
+void run_cases( const char* payload_name, size_t max_num_of_threads, std::chrono::milliseconds measurement_time )
+{
+	for ( op_mix mix : { op_mix::copy, op_mix::move, op_mix::assign, op_mix::swap, op_mix::cast } ) {
+		for ( size_t num_of_threads = 1; num_of_threads <= max_num_of_threads; num_of_threads *= 2 ) {
+			double packed_ops = measure_ops_per_sec_per_thread<Payload, packed_working_set>( mix, num_of_threads, measurement_time );
+			double padded_ops = measure_ops_per_sec_per_thread<Payload, padded_working_set>( mix, num_of_threads, measurement_time );
+			printf( "%s, %s, %zu, %.0f, %.0f\n", payload_name, op_mix_name( mix ), num_of_threads, packed_ops, padded_ops );
+		}
+	}
+}
+
+int main( int argc, char* argv[] )
+{
+	size_t                    max_num_of_threads = std::max<size_t>( 1, std::thread::hardware_concurrency() );
+	std::chrono::milliseconds measurement_time( 100 );
+	if ( argc > 1 ) {
+		max_num_of_threads = std::max<size_t>( 1, static_cast<size_t>( std::atol( argv[1] ) ) );
+	}
+	if ( argc > 2 ) {
+		measurement_time = std::chrono::milliseconds( std::atol( argv[2] ) );
+	}
+
+	printf( "payload, op mix, threads, packed[ops/s/thread], padded[ops/s/thread]\n" );
+
+	pooled_allocator_enabled = false;
+	run_cases<payload_sso>( "sso", max_num_of_threads, measurement_time );
+	run_cases<payload_heap>( "heap", max_num_of_threads, measurement_time );
+
+	pooled_allocator_enabled = true;
+	run_cases<payload_heap>( "heap+pool", max_num_of_threads, measurement_time );
+	pooled_allocator_enabled = false;
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file test_any_arena.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "constrained_any.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+struct TestArenaHeapPayload {
+	std::array<int, yan::impl::sso_buff_size> v_buff;
+
+	TestArenaHeapPayload( int v )
+	  : v_buff { v }
+	{
+	}
+};
+
+struct TestArenaCountDestructor {
+	int* p_cnt_;
+
+	TestArenaCountDestructor( int* p_cnt )
+	  : p_cnt_( p_cnt )
+	{
+	}
+	TestArenaCountDestructor( const TestArenaCountDestructor& ) = default;
+	~TestArenaCountDestructor()
+	{
+		( *p_cnt_ )++;
+	}
+};
+
+// ================================================
+
+TEST( TestAnyArena, HeapValue_CanConstructInScope_ThenAllocatedFromArena )
+{
+	// Arrange
+	yan::any_arena       arena;
+	yan::any_arena_scope scope( arena );
+
+	// Act
+	yan::arena_copyable_any sut( std::in_place_type<TestArenaHeapPayload>, 1 );
+
+	// Assert
+	EXPECT_GE( arena.used_bytes(), sizeof( TestArenaHeapPayload ) );
+	EXPECT_EQ( yan::constrained_any_cast<const TestArenaHeapPayload&>( sut ).v_buff[0], 1 );
+}
+
+TEST( TestAnyArena, HeapValue_CanConstructWithoutScope_ThenThrowLogicError )
+{
+	// Arrange
+
+	// Act
+	EXPECT_THROW( yan::arena_copyable_any( std::in_place_type<TestArenaHeapPayload>, 1 ), std::logic_error );
+
+	// Assert
+}
+
+TEST( TestAnyArena, NoValue_CanConstructAndResetWithoutScope_ThenNoThrow )
+{
+	// Arrange
+	yan::any_arena          arena;
+	yan::arena_copyable_any sut_in_scope;
+	{
+		yan::any_arena_scope scope( arena );
+		sut_in_scope = yan::arena_copyable_any( std::in_place_type<TestArenaHeapPayload>, 1 );
+	}
+
+	// Act
+	yan::arena_copyable_any sut;
+	sut_in_scope.reset();
+
+	// Assert
+	EXPECT_FALSE( sut.has_value() );
+	EXPECT_FALSE( sut_in_scope.has_value() );
+}
+
+TEST( TestAnyArena, HeapValue_CanCopyAndAssign_ThenValueIsKept )
+{
+	// Arrange
+	yan::any_arena          arena;
+	yan::any_arena_scope    scope( arena );
+	yan::arena_copyable_any sut_a( std::in_place_type<TestArenaHeapPayload>, 1 );
+	yan::arena_copyable_any sut_b( std::string( "b" ) );
+
+	// Act
+	yan::arena_copyable_any sut_c( sut_a );
+	sut_a = sut_b;
+	sut_b = 2;
+
+	// Assert
+	EXPECT_EQ( yan::constrained_any_cast<const std::string&>( sut_a ), std::string( "b" ) );
+	EXPECT_EQ( yan::constrained_any_cast<int>( sut_b ), 2 );
+	EXPECT_EQ( yan::constrained_any_cast<const TestArenaHeapPayload&>( sut_c ).v_buff[0], 1 );
+}
+
+TEST( TestAnyArena, OutOfScope_ThenDestructorOfValueIsCalled )
+{
+	// Arrange
+	int            cnt = 0;
+	yan::any_arena arena;
+
+	// Act
+	{
+		yan::any_arena_scope    scope( arena );
+		yan::arena_copyable_any sut( std::in_place_type<TestArenaCountDestructor>, &cnt );
+		cnt = 0;
+	}
+
+	// Assert
+	EXPECT_EQ( cnt, 1 );
+}
+
+TEST( TestAnyArena, NestedScope_ThenPreviousArenaIsRestored )
+{
+	// Arrange
+	yan::any_arena arena_outer;
+	yan::any_arena arena_inner;
+
+	// Act
+	yan::any_arena_scope scope_outer( arena_outer );
+	{
+		yan::any_arena_scope    scope_inner( arena_inner );
+		yan::arena_copyable_any sut( std::in_place_type<TestArenaHeapPayload>, 1 );
+	}
+	yan::arena_copyable_any sut( std::in_place_type<TestArenaHeapPayload>, 2 );
+
+	// Assert
+	EXPECT_EQ( yan::any_arena::get_active_arena(), &arena_outer );
+	EXPECT_GE( arena_inner.used_bytes(), sizeof( TestArenaHeapPayload ) );
+	EXPECT_GE( arena_outer.used_bytes(), sizeof( TestArenaHeapPayload ) );
+}
+
+TEST( TestAnyArena, Create_NotTriviallyDestructible_ThenDestructedByRelease )
+{
+	// Arrange
+	int            cnt = 0;
+	yan::any_arena arena;
+	auto&          sut = arena.create<yan::arena_copyable_any, TestArenaCountDestructor>( &cnt );
+	arena.create<yan::arena_copyable_any, std::string>( "string value over SSO of std::string" );
+	cnt = 0;
+
+	// Act
+	arena.release();
+
+	// Assert
+	EXPECT_EQ( cnt, 1 );
+	EXPECT_EQ( arena.used_bytes(), 0 );
+	(void)sut;
+}
+
+TEST( TestAnyArena, Create_TriviallyDestructible_ThenCanReleaseAllAtOnce )
+{
+	// Arrange
+	yan::any_arena                        arena( 1024 );
+	std::vector<yan::arena_copyable_any*> values;
+
+	// Act
+	for ( int i = 0; i < 100; i++ ) {
+		values.push_back( &arena.create<yan::arena_copyable_any, TestArenaHeapPayload>( i ) );
+	}
+	for ( int i = 0; i < 100; i++ ) {
+		EXPECT_EQ( yan::constrained_any_cast<const TestArenaHeapPayload&>( *values[static_cast<size_t>( i )] ).v_buff[0], i );
+	}
+	arena.release();
+
+	// Assert
+	EXPECT_EQ( arena.used_bytes(), 0 );
+	auto& sut = arena.create<yan::arena_copyable_any, TestArenaHeapPayload>( 3 );
+	EXPECT_EQ( yan::constrained_any_cast<const TestArenaHeapPayload&>( sut ).v_buff[0], 3 );
+}
+
+TEST( TestAnyArena, HeapValue_CanMoveAfterScopeEnds_ThenValueCarrierIsTakenOver )
+{
+	// Arrange
+	yan::any_arena                       arena;
+	std::vector<yan::arena_copyable_any> values;
+	yan::arena_copyable_any              sut_src;
+	{
+		yan::any_arena_scope scope( arena );
+		sut_src = yan::arena_copyable_any( std::in_place_type<TestArenaHeapPayload>, 1 );
+		for ( int i = 0; i < 4; i++ ) {
+			values.emplace_back( std::in_place_type<TestArenaHeapPayload>, i );
+		}
+	}
+	size_t used_bytes = arena.used_bytes();
+
+	// Act
+	yan::arena_copyable_any sut( std::move( sut_src ) );
+	values.reserve( values.capacity() * 2 );   // growth of the vector moves the values
+	yan::arena_copyable_any sut_assigned;
+	sut_assigned = std::move( values[0] );
+
+	// Assert
+	EXPECT_EQ( yan::constrained_any_cast<const TestArenaHeapPayload&>( sut ).v_buff[0], 1 );
+	EXPECT_FALSE( sut_src.has_value() );
+	EXPECT_EQ( yan::constrained_any_cast<const TestArenaHeapPayload&>( sut_assigned ).v_buff[0], 0 );
+	for ( int i = 1; i < 4; i++ ) {
+		EXPECT_EQ( yan::constrained_any_cast<const TestArenaHeapPayload&>( values[static_cast<size_t>( i )] ).v_buff[0], i );
+	}
+	EXPECT_EQ( arena.used_bytes(), used_bytes );
+	EXPECT_TRUE( std::is_nothrow_move_constructible<yan::arena_copyable_any>::value );
+}
+
+TEST( TestAnyArena, HeapValue_CanMoveInOtherScope_ThenOtherArenaIsNotUsed )
+{
+	// Arrange
+	yan::any_arena          arena;
+	yan::any_arena          arena_other;
+	yan::arena_copyable_any sut_src;
+	{
+		yan::any_arena_scope scope( arena );
+		sut_src = yan::arena_copyable_any( std::in_place_type<TestArenaHeapPayload>, 1 );
+	}
+
+	// Act
+	yan::any_arena_scope    scope_other( arena_other );
+	yan::arena_copyable_any sut( std::move( sut_src ) );
+
+	// Assert
+	EXPECT_EQ( yan::constrained_any_cast<const TestArenaHeapPayload&>( sut ).v_buff[0], 1 );
+	EXPECT_EQ( arena_other.used_bytes(), 0 );
+}
@@ -0,0 +1,160 @@
+/**
+ * @file test_any_column.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "any_column.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+TEST( TestAnyColumn, Empty_ThenSizeIsZero )
+{
+	// Arrange
+	yan::any_column<yan::copyable_any> sut;
+
+	// Act
+
+	// Assert
+	EXPECT_TRUE( sut.empty() );
+	EXPECT_EQ( sut.size(), 0 );
+	EXPECT_EQ( sut.num_of_runs(), 0 );
+	EXPECT_THROW( sut.get( 0 ), std::out_of_range );
+}
+
+TEST( TestAnyColumn, SameTypeValues_CanPushBack_ThenOneRun )
+{
+	// Arrange
+	yan::any_column<yan::copyable_any> sut;
+
+	// Act
+	for ( int64_t i = 0; i < 100; i++ ) {
+		sut.push_back( i );
+	}
+
+	// Assert
+	EXPECT_EQ( sut.size(), 100 );
+	EXPECT_EQ( sut.num_of_runs(), 1 );
+	ASSERT_NE( sut.get_if<int64_t>( 42 ), nullptr );
+	EXPECT_EQ( *sut.get_if<int64_t>( 42 ), 42 );
+	EXPECT_EQ( sut.get_if<int>( 42 ), nullptr );
+}
+
+TEST( TestAnyColumn, MixedTypeValues_CanPushBack_ThenRunIsSplitByType )
+{
+	// Arrange
+	yan::any_column<yan::copyable_any> sut;
+
+	// Act
+	sut.push_back( 1 );
+	sut.push_back( 2 );
+	sut.push_back( std::string( "3" ) );
+	sut.emplace_back<std::string>( 2, '4' );
+	sut.push_back( 5 );
+
+	// Assert
+	EXPECT_EQ( sut.size(), 5 );
+	EXPECT_EQ( sut.num_of_runs(), 3 );
+	EXPECT_EQ( sut.type( 0 ), typeid( int ) );
+	EXPECT_EQ( sut.type( 1 ), typeid( int ) );
+	EXPECT_EQ( sut.type( 2 ), typeid( std::string ) );
+	EXPECT_EQ( sut.type( 3 ), typeid( std::string ) );
+	EXPECT_EQ( sut.type( 4 ), typeid( int ) );
+	EXPECT_EQ( *sut.get_if<std::string>( 3 ), std::string( "44" ) );
+	EXPECT_EQ( *sut.get_if<int>( 4 ), 5 );
+}
+
+TEST( TestAnyColumn, Element_CanGetAsAlias )
+{
+	// Arrange
+	yan::any_column<yan::keyable_any> sut;
+	sut.push_back( 1 );
+	sut.push_back( std::string( "2" ) );
+
+	// Act
+	yan::keyable_any   a      = sut.get( 0 );
+	yan::keyable_any   b      = sut[1];
+	const std::string* p_view = sut[1].get_if<std::string>();
+
+	// Assert
+	EXPECT_EQ( yan::constrained_any_cast<int>( a ), 1 );
+	EXPECT_EQ( yan::constrained_any_cast<const std::string&>( b ), std::string( "2" ) );
+	EXPECT_EQ( b, yan::keyable_any( std::string( "2" ) ) );
+	ASSERT_NE( p_view, nullptr );
+	EXPECT_EQ( *p_view, std::string( "2" ) );
+	EXPECT_EQ( sut[0].type(), typeid( int ) );
+	EXPECT_EQ( sut[0].get_if<std::string>(), nullptr );
+}
+
+TEST( TestAnyColumn, ForEachRun_ThenCallForRunsOfTheType )
+{
+	// Arrange
+	yan::any_column<yan::copyable_any> sut;
+	for ( int i = 0; i < 10; i++ ) {
+		sut.push_back( i );
+	}
+	sut.push_back( 1.0 );
+	for ( int i = 10; i < 20; i++ ) {
+		sut.push_back( i );
+	}
+
+	// Act
+	int    sum          = 0;
+	size_t num_of_calls = 0;
+	sut.for_each_run<int>( [&sum, &num_of_calls]( const int* p, size_t n ) {
+		for ( size_t i = 0; i < n; i++ ) {
+			sum += p[i];
+		}
+		num_of_calls++;
+	} );
+
+	// Assert
+	EXPECT_EQ( sum, 190 );
+	EXPECT_EQ( num_of_calls, 2 );
+}
+
+TEST( TestAnyColumn, CanCopyAndMove )
+{
+	// Arrange
+	yan::any_column<yan::copyable_any> sut;
+	sut.push_back( 1 );
+	sut.push_back( std::string( "2" ) );
+
+	// Act
+	yan::any_column<yan::copyable_any> sut_copy( sut );
+	yan::any_column<yan::copyable_any> sut_move( std::move( sut_copy ) );
+	sut.clear();
+
+	// Assert
+	EXPECT_TRUE( sut.empty() );
+	EXPECT_EQ( sut_move.size(), 2 );
+	EXPECT_EQ( *sut_move.get_if<int>( 0 ), 1 );
+	EXPECT_EQ( *sut_move.get_if<std::string>( 1 ), std::string( "2" ) );
+}
+
+TEST( TestAnyColumn, LongRunOfScalar_ThenMemoryIsNearSizeofValuePerElement )
+{
+	// Arrange
+	constexpr size_t                   n = 1000;
+	yan::any_column<yan::copyable_any> sut;
+
+	// Act
+	for ( size_t i = 0; i < n; i++ ) {
+		sut.push_back( static_cast<int64_t>( i ) );
+	}
+
+	// Assert
+	EXPECT_GE( sut.memory_bytes(), n * sizeof( int64_t ) );
+	EXPECT_LT( sut.memory_bytes(), 2 * n * sizeof( int64_t ) + 256 );   // margin for the growth of std::vector and the run index
+}
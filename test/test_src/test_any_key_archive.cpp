@@ -0,0 +1,197 @@
+/**
+ * @file test_any_key_archive.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+#include "any_key_archive.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+class TestAnyKeyArchive : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		auto& registry = yan::serialize_registry<yan::serializable_keyable_any>::get_instance();
+		registry.register_type<int64_t>( 1 );
+		registry.register_type<double>( 2 );
+		registry.register_type<std::string>( 3 );
+
+		// the test binaries of each C++ standard may run in parallel. Therefore, the file name is unique for each test and process.
+		const ::testing::TestInfo* p_info = ::testing::UnitTest::GetInstance()->current_test_info();
+		path_                             = ::testing::TempDir() + "test_any_key_archive_" + p_info->name() + "_" + std::to_string( ::getpid() ) + ".bin";
+	}
+	void TearDown() override
+	{
+		std::remove( path_.c_str() );
+	}
+
+	std::vector<yan::serializable_keyable_any> make_keys( void )
+	{
+		std::vector<yan::serializable_keyable_any> ans;
+		for ( int64_t i = 0; i < 100; i += 2 ) {
+			ans.emplace_back( i );
+			ans.emplace_back( static_cast<double>( i ) + 0.5 );
+			ans.emplace_back( "key_" + std::to_string( i ) );
+		}
+		ans.emplace_back( int64_t { 0 } );   // duplicated
+		return ans;
+	}
+
+	std::string path_;
+};
+
+TEST_F( TestAnyKeyArchive, WriteAndOpen_ThenSizeIsNumberOfUniqueKeys )
+{
+	// Arrange
+	yan::write_any_key_archive( path_, make_keys() );
+
+	// Act
+	yan::any_key_archive<yan::serializable_keyable_any> sut( path_ );
+
+	// Assert
+	EXPECT_EQ( sut.size(), 150 );
+	EXPECT_EQ( sut.num_of_partitions(), 3 );
+}
+
+TEST_F( TestAnyKeyArchive, Contains_ThenSameToSetOfKeys )
+{
+	// Arrange
+	yan::write_any_key_archive( path_, make_keys() );
+	yan::any_key_archive<yan::serializable_keyable_any> sut( path_ );
+
+	// Act
+	// Assert
+	EXPECT_TRUE( sut.contains( int64_t { 0 } ) );
+	EXPECT_TRUE( sut.contains( int64_t { 98 } ) );
+	EXPECT_FALSE( sut.contains( int64_t { 1 } ) );
+	EXPECT_TRUE( sut.contains( 2.5 ) );
+	EXPECT_FALSE( sut.contains( 2.0 ) );
+	EXPECT_TRUE( sut.contains( std::string( "key_42" ) ) );
+	EXPECT_FALSE( sut.contains( std::string( "key_43" ) ) );
+	EXPECT_FALSE( sut.contains( 1.0F ) );   // type that is not in the archive
+}
+
+TEST_F( TestAnyKeyArchive, LowerBound_ThenSameToSortedVectorByLess )
+{
+	// Arrange
+	std::vector<yan::serializable_keyable_any> keys = make_keys();
+	yan::write_any_key_archive( path_, keys );
+	yan::any_key_archive<yan::serializable_keyable_any> sut( path_ );
+
+	std::sort( keys.begin(), keys.end() );
+	keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+
+	auto expected_lower_bound = [&keys]( const yan::serializable_keyable_any& k ) {
+		return static_cast<size_t>( std::lower_bound( keys.begin(), keys.end(), k ) - keys.begin() );
+	};
+
+	// Act
+	// Assert
+	EXPECT_EQ( sut.lower_bound( int64_t { -1 } ), expected_lower_bound( yan::serializable_keyable_any( int64_t { -1 } ) ) );
+	EXPECT_EQ( sut.lower_bound( int64_t { 41 } ), expected_lower_bound( yan::serializable_keyable_any( int64_t { 41 } ) ) );
+	EXPECT_EQ( sut.lower_bound( int64_t { 42 } ), expected_lower_bound( yan::serializable_keyable_any( int64_t { 42 } ) ) );
+	EXPECT_EQ( sut.lower_bound( 1000.0 ), expected_lower_bound( yan::serializable_keyable_any( 1000.0 ) ) );
+	EXPECT_EQ( sut.lower_bound( std::string( "key_5" ) ), expected_lower_bound( yan::serializable_keyable_any( std::string( "key_5" ) ) ) );
+}
+
+TEST_F( TestAnyKeyArchive, Load_ThenSameToSortedVectorByLess )
+{
+	// Arrange
+	std::vector<yan::serializable_keyable_any> keys = make_keys();
+	yan::write_any_key_archive( path_, keys );
+	yan::any_key_archive<yan::serializable_keyable_any> sut( path_ );
+
+	std::sort( keys.begin(), keys.end() );
+	keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+
+	// Act
+	// Assert
+	ASSERT_EQ( sut.size(), keys.size() );
+	for ( size_t i = 0; i < keys.size(); i++ ) {
+		yan::serializable_keyable_any v;
+		sut.load( i, v );
+		EXPECT_EQ( v, keys[i] );
+		EXPECT_EQ( sut.type( i ), keys[i].type() );
+	}
+}
+
+TEST_F( TestAnyKeyArchive, String_CanLoadAsView )
+{
+	// Arrange
+	yan::write_any_key_archive( path_, std::vector<yan::serializable_keyable_any> { std::string( "abc" ) } );
+	yan::any_key_archive<yan::serializable_keyable_any> sut( path_ );
+	yan::serializable_keyable_any                       v;
+
+	// Act
+	sut.load( 0, v, true );
+
+	// Assert
+	ASSERT_EQ( v.type(), typeid( std::string_view ) );
+	EXPECT_EQ( yan::constrained_any_cast<std::string_view>( v ), std::string_view( "abc" ) );
+}
+
+TEST_F( TestAnyKeyArchive, InvalidFile_ThenThrow )
+{
+	// Arrange
+	{
+		std::ofstream ofs( path_, std::ios::binary | std::ios::trunc );
+		ofs << "not an archive of keys";
+	}
+
+	// Act
+	// Assert
+	EXPECT_THROW( yan::any_key_archive<yan::serializable_keyable_any> { path_ }, std::invalid_argument );
+	EXPECT_THROW( yan::any_key_archive<yan::serializable_keyable_any> { path_ + ".not_exist" }, std::system_error );
+}
+
+TEST_F( TestAnyKeyArchive, Overwrite_ThenNewKeysAreWritten )
+{
+	// Arrange
+	yan::write_any_key_archive( path_, make_keys() );
+
+	// Act
+	yan::write_any_key_archive( path_, std::vector<yan::serializable_keyable_any> { std::string( "abc" ) } );
+
+	// Assert
+	yan::any_key_archive<yan::serializable_keyable_any> sut( path_ );
+	EXPECT_EQ( sut.size(), 1 );
+	EXPECT_TRUE( sut.contains( std::string( "abc" ) ) );
+}
+
+TEST_F( TestAnyKeyArchive, WriteFailure_ThenThrowIoErrorAndNoFileIsLeft )
+{
+	// Arrange
+	std::string path_in_no_dir = path_ + ".not_exist/keys.bin";
+
+	// Act
+	std::error_code ec;
+	try {
+		yan::write_any_key_archive( path_in_no_dir, make_keys() );
+	} catch ( const std::system_error& e ) {
+		ec = e.code();
+	}
+
+	// Assert
+	EXPECT_EQ( ec, std::make_error_code( std::errc::io_error ) );
+	std::ifstream ifs( path_in_no_dir );
+	EXPECT_FALSE( ifs.is_open() );
+}
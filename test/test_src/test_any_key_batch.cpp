@@ -0,0 +1,265 @@
+/**
+ * @file test_any_key_batch.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "any_key_batch.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+namespace {
+
+struct test_key_t {
+	int a_;
+
+	bool operator==( const test_key_t& rhs ) const
+	{
+		return a_ == rhs.a_;
+	}
+	bool operator<( const test_key_t& rhs ) const
+	{
+		return a_ < rhs.a_;
+	}
+};
+
+template <size_t N>
+struct test_tag_t {
+	int v_;
+
+	bool operator==( const test_tag_t& rhs ) const
+	{
+		return v_ == rhs.v_;
+	}
+	bool operator<( const test_tag_t& rhs ) const
+	{
+		return v_ < rhs.v_;
+	}
+};
+
+}   // namespace
+
+namespace std {
+template <>
+struct hash<test_key_t> {
+	size_t operator()( const test_key_t& v ) const
+	{
+		return std::hash<int>()( v.a_ ) * 31U;
+	}
+};
+template <size_t N>
+struct hash<test_tag_t<N>> {
+	size_t operator()( const test_tag_t<N>& v ) const
+	{
+		return std::hash<int>()( v.v_ ) + N;
+	}
+};
+}   // namespace std
+
+namespace {
+
+std::vector<yan::keyable_any> make_mixed_keys( size_t n, int seed )
+{
+	std::vector<yan::keyable_any> ans;
+	for ( size_t i = 0; i < n; i++ ) {
+		int v = static_cast<int>( ( i * 7 + static_cast<size_t>( seed ) ) % 13 );
+		switch ( ( i + static_cast<size_t>( seed ) ) % 6 ) {
+			case 0: ans.emplace_back( v ); break;
+			case 1: ans.emplace_back( static_cast<int64_t>( v ) ); break;
+			case 2: ans.emplace_back( static_cast<double>( v ) / 2.0 ); break;
+			case 3: ans.emplace_back( std::to_string( v ) ); break;
+			case 4: ans.emplace_back( test_key_t { v } ); break;
+			default: ans.emplace_back(); break;
+		}
+	}
+	return ans;
+}
+
+}   // namespace
+
+TEST( TestAnyKeyBatch, HashBatchOfMixedKeys_ThenSameToHashValue )
+{
+	// Arrange
+	std::vector<yan::keyable_any> sut = make_mixed_keys( 1000, 0 );
+	std::vector<size_t>           out( sut.size() );
+
+	// Act
+	yan::hash_batch( sut.data(), out.data(), sut.size() );
+
+	// Assert
+	for ( size_t i = 0; i < sut.size(); i++ ) {
+		EXPECT_EQ( out[i], sut[i].hash_value() ) << "index " << i;
+	}
+}
+
+TEST( TestAnyKeyBatch, HashBatchOfSpecifiedTypes_ThenSameToHashValue )
+{
+	// Arrange
+	std::vector<yan::keyable_any> sut = make_mixed_keys( 1000, 1 );
+	std::vector<size_t>           out( sut.size() );
+
+	// Act
+	yan::hash_batch<test_key_t, int64_t>( sut.data(), out.data(), sut.size() );
+
+	// Assert
+	for ( size_t i = 0; i < sut.size(); i++ ) {
+		EXPECT_EQ( out[i], sut[i].hash_value() ) << "index " << i;
+	}
+}
+
+TEST( TestAnyKeyBatch, HashBatchOfManyTypes_ThenSameToHashValue )
+{
+	// Arrange
+	// more types than the groups of one chunk
+	std::vector<yan::unordered_key_any> sut;
+	for ( int i = 0; i < 300; i++ ) {
+		switch ( i % 20 ) {
+			case 0: sut.emplace_back( test_tag_t<0> { i } ); break;
+			case 1: sut.emplace_back( test_tag_t<1> { i } ); break;
+			case 2: sut.emplace_back( test_tag_t<2> { i } ); break;
+			case 3: sut.emplace_back( test_tag_t<3> { i } ); break;
+			case 4: sut.emplace_back( test_tag_t<4> { i } ); break;
+			case 5: sut.emplace_back( test_tag_t<5> { i } ); break;
+			case 6: sut.emplace_back( test_tag_t<6> { i } ); break;
+			case 7: sut.emplace_back( test_tag_t<7> { i } ); break;
+			case 8: sut.emplace_back( test_tag_t<8> { i } ); break;
+			case 9: sut.emplace_back( test_tag_t<9> { i } ); break;
+			case 10: sut.emplace_back( test_tag_t<10> { i } ); break;
+			case 11: sut.emplace_back( test_tag_t<11> { i } ); break;
+			case 12: sut.emplace_back( test_tag_t<12> { i } ); break;
+			case 13: sut.emplace_back( test_tag_t<13> { i } ); break;
+			case 14: sut.emplace_back( test_tag_t<14> { i } ); break;
+			case 15: sut.emplace_back( test_tag_t<15> { i } ); break;
+			case 16: sut.emplace_back( test_tag_t<16> { i } ); break;
+			case 17: sut.emplace_back( static_cast<unsigned int>( i ) ); break;
+			case 18: sut.emplace_back( static_cast<float>( i ) ); break;
+			default: sut.emplace_back( i ); break;
+		}
+	}
+	std::vector<size_t> out( sut.size() );
+
+	// Act
+	yan::hash_batch( sut.data(), out.data(), sut.size() );
+
+	// Assert
+	for ( size_t i = 0; i < sut.size(); i++ ) {
+		EXPECT_EQ( out[i], sut[i].hash_value() ) << "index " << i;
+	}
+}
+
+TEST( TestAnyKeyBatch, EqualBatchOfMixedKeys_ThenSameToEqualTo )
+{
+	// Arrange
+	std::vector<yan::keyable_any> sut_a = make_mixed_keys( 1000, 0 );
+	std::vector<yan::keyable_any> sut_b = make_mixed_keys( 1000, 0 );
+	std::vector<yan::keyable_any> sut_c = make_mixed_keys( 1000, 6 );
+	std::vector<yan::keyable_any> sut_d = make_mixed_keys( 1000, 3 );
+	std::unique_ptr<bool[]>       out_b( new bool[sut_a.size()] );
+	std::unique_ptr<bool[]>       out_c( new bool[sut_a.size()] );
+	std::unique_ptr<bool[]>       out_d( new bool[sut_a.size()] );
+
+	// Act
+	yan::equal_batch( sut_a.data(), sut_b.data(), out_b.get(), sut_a.size() );
+	yan::equal_batch( sut_a.data(), sut_c.data(), out_c.get(), sut_a.size() );
+	yan::equal_batch( sut_a.data(), sut_d.data(), out_d.get(), sut_a.size() );
+
+	// Assert
+	size_t num_of_equal_c = 0;
+	for ( size_t i = 0; i < sut_a.size(); i++ ) {
+		EXPECT_TRUE( out_b[i] ) << "index " << i;
+		EXPECT_EQ( out_c[i], sut_a[i].equal_to( sut_c[i] ) ) << "index " << i;
+		EXPECT_EQ( out_d[i], sut_a[i].equal_to( sut_d[i] ) ) << "index " << i;
+		num_of_equal_c += out_c[i] ? 1U : 0U;
+	}
+	EXPECT_LT( num_of_equal_c, sut_a.size() );
+}
+
+TEST( TestAnyKeyBatch, HashAndEqualBatchOfVariousRunLengths_ThenSameToEachOperation )
+{
+	// Arrange
+	// short runs, runs around the minimum run length and a run across the chunk boundary
+	const size_t                  run_lengths[] = { 1, 3, 7, 8, 9, 300, 1, 1, 1, 1, 1, 64, 2, 9 };
+	std::vector<yan::keyable_any> sut_a;
+	std::vector<yan::keyable_any> sut_b;
+	size_t                        kind = 0;
+	for ( size_t run_length : run_lengths ) {
+		for ( size_t i = 0; i < run_length; i++ ) {
+			int v = static_cast<int>( ( sut_a.size() * 5 ) % 11 );
+			switch ( kind % 3 ) {
+				case 0:
+					sut_a.emplace_back( static_cast<int64_t>( v ) );
+					sut_b.emplace_back( static_cast<int64_t>( v % 2 ) );
+					break;
+				case 1:
+					sut_a.emplace_back( static_cast<double>( v ) );
+					sut_b.emplace_back( static_cast<double>( v % 3 ) );
+					break;
+				default:
+					sut_a.emplace_back( std::to_string( v ) );
+					sut_b.emplace_back( std::to_string( v % 4 ) );
+					break;
+			}
+		}
+		kind++;
+	}
+	std::vector<size_t>     out_hash( sut_a.size() );
+	std::unique_ptr<bool[]> out_equal( new bool[sut_a.size()] );
+
+	// Act
+	yan::hash_batch( sut_a.data(), out_hash.data(), sut_a.size() );
+	yan::equal_batch( sut_a.data(), sut_b.data(), out_equal.get(), sut_a.size() );
+
+	// Assert
+	for ( size_t i = 0; i < sut_a.size(); i++ ) {
+		EXPECT_EQ( out_hash[i], sut_a[i].hash_value() ) << "index " << i;
+		EXPECT_EQ( out_equal[i], sut_a[i].equal_to( sut_b[i] ) ) << "index " << i;
+	}
+}
+
+TEST( TestAnyKeyBatch, Empty_ThenNothingHappens )
+{
+	// Arrange
+	std::vector<yan::keyable_any> sut;
+	size_t                        out = 123;
+
+	// Act
+	yan::hash_batch( sut.data(), &out, 0 );
+
+	// Assert
+	EXPECT_EQ( out, 123U );
+}
+
+TEST( TestAnyKeyBatch, HashAndEqualBatchOfCompactKeyableAny_ThenSameToEachOperation )
+{
+	// Arrange
+	std::vector<yan::compact_keyable_any> sut_a;
+	std::vector<yan::compact_keyable_any> sut_b;
+	for ( int i = 0; i < 300; i++ ) {
+		sut_a.emplace_back( i % 3 == 0 ? yan::compact_keyable_any( i ) : yan::compact_keyable_any( std::to_string( i ) ) );
+		sut_b.emplace_back( i % 2 == 0 ? yan::compact_keyable_any( i ) : yan::compact_keyable_any( std::to_string( i ) ) );
+	}
+	std::vector<size_t>     out_hash( sut_a.size() );
+	std::unique_ptr<bool[]> out_equal( new bool[sut_a.size()] );
+
+	// Act
+	yan::hash_batch( sut_a.data(), out_hash.data(), sut_a.size() );
+	yan::equal_batch( sut_a.data(), sut_b.data(), out_equal.get(), sut_a.size() );
+
+	// Assert
+	for ( size_t i = 0; i < sut_a.size(); i++ ) {
+		EXPECT_EQ( out_hash[i], sut_a[i].hash_value() ) << "index " << i;
+		EXPECT_EQ( out_equal[i], sut_a[i].equal_to( sut_b[i] ) ) << "index " << i;
+	}
+}
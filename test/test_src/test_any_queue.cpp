@@ -0,0 +1,291 @@
+/**
+ * @file test_any_queue.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "any_queue.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+struct TestQueueOverSSOSize {
+	std::array<int, yan::impl::sso_buff_size> v_buff;
+
+	TestQueueOverSSOSize( int v )
+	  : v_buff { v }
+	{
+	}
+};
+
+struct TestQueueThrowAtConstruction {
+	TestQueueThrowAtConstruction( int )
+	{
+		throw std::runtime_error( "construction error" );
+	}
+};
+
+struct TestQueueThrowAtMove {
+	int v_;
+
+	TestQueueThrowAtMove( int v )
+	  : v_( v )
+	{
+	}
+	TestQueueThrowAtMove( TestQueueThrowAtMove&& )
+	{
+		throw std::runtime_error( "move error" );
+	}
+};
+
+// ================================================
+
+TEST( TestAnyQueue, CanConstruct_ThenCapacityIsPowerOf2 )
+{
+	// Arrange
+
+	// Act
+	yan::any_queue<yan::move_only_any> sut( 5 );
+
+	// Assert
+	EXPECT_EQ( sut.capacity(), 8 );
+	EXPECT_EQ( sut.size_approx(), 0 );
+}
+
+TEST( TestAnyQueue, ZeroCapacity_ThenThrowInvalidArgument )
+{
+	// Arrange
+
+	// Act
+	// Assert
+	EXPECT_THROW( yan::any_queue<yan::move_only_any>( 0 ), std::invalid_argument );
+}
+
+TEST( TestAnyQueue, TooLargeCapacity_ThenThrowLengthError )
+{
+	// Arrange
+
+	// Act
+	// Assert
+	EXPECT_THROW( yan::any_queue<yan::move_only_any>( std::numeric_limits<size_t>::max() ), std::length_error );
+}
+
+TEST( TestAnyQueue, Empty_CanTryPop_ThenReturnFalse )
+{
+	// Arrange
+	yan::any_queue<yan::move_only_any> sut( 4 );
+	yan::move_only_any                 out;
+
+	// Act
+	bool ret = sut.try_pop( out );
+
+	// Assert
+	EXPECT_FALSE( ret );
+	EXPECT_FALSE( out.has_value() );
+}
+
+TEST( TestAnyQueue, CanEmplaceAndPop_ThenFifoOrder )
+{
+	// Arrange
+	yan::any_queue<yan::move_only_any> sut( 4 );
+
+	// Act
+	EXPECT_TRUE( sut.try_emplace<std::unique_ptr<int>>( std::make_unique<int>( 1 ) ) );
+	EXPECT_TRUE( sut.try_emplace<std::string>( "2" ) );
+	EXPECT_TRUE( sut.try_push( 3.0 ) );
+
+	// Assert
+	EXPECT_EQ( sut.size_approx(), 3 );
+	yan::move_only_any out;
+	ASSERT_TRUE( sut.try_pop( out ) );
+	EXPECT_EQ( out.type(), typeid( std::unique_ptr<int> ) );
+	EXPECT_EQ( *( yan::constrained_any_cast<std::unique_ptr<int>&>( out ) ), 1 );
+	ASSERT_TRUE( sut.try_pop( out ) );
+	EXPECT_EQ( out.type(), typeid( std::string ) );
+	EXPECT_EQ( yan::constrained_any_cast<std::string&>( out ), std::string( "2" ) );
+	ASSERT_TRUE( sut.try_pop( out ) );
+	EXPECT_EQ( out.type(), typeid( double ) );
+	EXPECT_EQ( yan::constrained_any_cast<double>( out ), 3.0 );
+	EXPECT_FALSE( sut.try_pop( out ) );
+}
+
+TEST( TestAnyQueue, Full_CanTryPush_ThenReturnFalse )
+{
+	// Arrange
+	yan::any_queue<yan::copyable_any> sut( 2 );
+	ASSERT_TRUE( sut.try_push( 1 ) );
+	ASSERT_TRUE( sut.try_push( 2 ) );
+
+	// Act
+	bool ret = sut.try_push( 3 );
+
+	// Assert
+	EXPECT_FALSE( ret );
+	EXPECT_EQ( sut.size_approx(), 2 );
+}
+
+TEST( TestAnyQueue, CanPushAlias_ThenPopSameValue )
+{
+	// Arrange
+	yan::any_queue<yan::keyable_any> sut( 2 );
+	yan::keyable_any                 v = std::string( "key" );
+
+	// Act
+	ASSERT_TRUE( sut.try_push( v ) );
+
+	// Assert
+	yan::keyable_any out;
+	ASSERT_TRUE( sut.try_pop( out ) );
+	EXPECT_TRUE( out == v );
+}
+
+TEST( TestAnyQueue, LargerThanSSOSizeValue_CanEmplaceAndConsume )
+{
+	// Arrange
+	yan::any_queue<yan::move_only_any> sut( 2 );
+	ASSERT_TRUE( sut.try_emplace<TestQueueOverSSOSize>( 7 ) );
+
+	// Act
+	int  consumed_value = 0;
+	bool ret            = sut.try_consume( [&consumed_value]( yan::move_only_any& v ) {
+		consumed_value = yan::constrained_any_cast<TestQueueOverSSOSize&>( v ).v_buff[0];
+	} );
+
+	// Assert
+	EXPECT_TRUE( ret );
+	EXPECT_EQ( consumed_value, 7 );
+}
+
+TEST( TestAnyQueue, ThrowAtConstruction_ThenSlotIsSkipped )
+{
+	// Arrange
+	yan::any_queue<yan::move_only_any> sut( 4 );
+	ASSERT_TRUE( sut.try_push( 1 ) );
+
+	// Act
+	EXPECT_THROW( sut.try_emplace<TestQueueThrowAtConstruction>( 2 ), std::runtime_error );
+	ASSERT_TRUE( sut.try_push( 3 ) );
+
+	// Assert
+	yan::move_only_any out;
+	ASSERT_TRUE( sut.try_pop( out ) );
+	EXPECT_EQ( yan::constrained_any_cast<int>( out ), 1 );
+	ASSERT_TRUE( sut.try_pop( out ) );
+	EXPECT_EQ( yan::constrained_any_cast<int>( out ), 3 );
+	EXPECT_FALSE( sut.try_pop( out ) );
+}
+
+TEST( TestAnyQueue, ValueWithThrowingMove_CanTryPop_ThenNoException )
+{
+	// Arrange
+	yan::any_queue<yan::move_only_any> sut( 2 );
+	ASSERT_TRUE( sut.try_emplace<TestQueueThrowAtMove>( 5 ) );
+	yan::move_only_any out = 1;
+
+	// Act
+	bool ret = false;
+	EXPECT_NO_THROW( ret = sut.try_pop( out ) );
+
+	// Assert
+	EXPECT_TRUE( ret );
+	EXPECT_EQ( yan::constrained_any_cast<TestQueueThrowAtMove&>( out ).v_, 5 );
+	EXPECT_EQ( sut.size_approx(), 0 );
+}
+
+TEST( TestAnyQueue, ThrowInConsume_ThenValueIsDestructedAndSlotIsReleased )
+{
+	// Arrange
+	auto                              sp_value = std::make_shared<int>( 1 );
+	yan::any_queue<yan::copyable_any> sut( 2 );
+	ASSERT_TRUE( sut.try_push( sp_value ) );
+	ASSERT_TRUE( sut.try_push( 2 ) );
+
+	// Act
+	EXPECT_THROW( sut.try_consume( []( yan::copyable_any& ) { throw std::runtime_error( "consume error" ); } ), std::runtime_error );
+
+	// Assert
+	EXPECT_EQ( sp_value.use_count(), 1 );
+	ASSERT_TRUE( sut.try_push( 3 ) );
+	yan::copyable_any out;
+	ASSERT_TRUE( sut.try_pop( out ) );
+	EXPECT_EQ( yan::constrained_any_cast<int>( out ), 2 );
+	ASSERT_TRUE( sut.try_pop( out ) );
+	EXPECT_EQ( yan::constrained_any_cast<int>( out ), 3 );
+}
+
+TEST( TestAnyQueue, RemainingValues_ThenDestructedByQueueDestructor )
+{
+	// Arrange
+	auto sp_value = std::make_shared<int>( 1 );
+
+	// Act
+	{
+		yan::any_queue<yan::copyable_any> sut( 4 );
+		ASSERT_TRUE( sut.try_push( sp_value ) );
+		ASSERT_TRUE( sut.try_push( sp_value ) );
+		EXPECT_EQ( sp_value.use_count(), 3 );
+	}
+
+	// Assert
+	EXPECT_EQ( sp_value.use_count(), 1 );
+}
+
+TEST( TestAnyQueue, MultiProducerMultiConsumer_ThenAllValuesArePopped )
+{
+	// Arrange
+	constexpr size_t                   num_of_threads     = 4;
+	constexpr size_t                   num_of_each_values = 10000;
+	yan::any_queue<yan::move_only_any> sut( 64 );
+	std::atomic<size_t>                total_popped_count( 0 );
+	std::atomic<size_t>                total_popped_sum( 0 );
+
+	// Act
+	std::vector<std::thread> threads;
+	for ( size_t i = 0; i < num_of_threads; i++ ) {
+		threads.emplace_back( [&sut]() {
+			for ( size_t v = 1; v <= num_of_each_values; v++ ) {
+				while ( !sut.try_emplace<size_t>( v ) ) {
+					std::this_thread::yield();
+				}
+			}
+		} );
+		threads.emplace_back( [&sut, &total_popped_count, &total_popped_sum]() {
+			yan::move_only_any out;
+			size_t             count = 0;
+			size_t             sum   = 0;
+			while ( count < num_of_each_values ) {
+				if ( sut.try_pop( out ) ) {
+					sum += yan::constrained_any_cast<size_t>( out );
+					count++;
+				} else {
+					std::this_thread::yield();
+				}
+			}
+			total_popped_count += count;
+			total_popped_sum += sum;
+		} );
+	}
+	for ( auto& t : threads ) {
+		t.join();
+	}
+
+	// Assert
+	EXPECT_EQ( total_popped_count.load(), num_of_threads * num_of_each_values );
+	EXPECT_EQ( total_popped_sum.load(), num_of_threads * ( num_of_each_values * ( num_of_each_values + 1 ) / 2 ) );
+	EXPECT_EQ( sut.size_approx(), 0 );
+}
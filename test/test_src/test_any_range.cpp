@@ -0,0 +1,134 @@
+/**
+ * @file test_any_range.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "constrained_any.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+TEST( TestAnyRange, MakeAnyRange_ToVector_ThenAppended )
+{
+	// Arrange
+	std::vector<int>              src { 1, 2, 3 };
+	std::vector<yan::keyable_any> sut;
+	sut.emplace_back( std::string( "0" ) );
+
+	// Act
+	yan::make_any_range<yan::keyable_any>( src.begin(), src.end(), sut );
+
+	// Assert
+	ASSERT_EQ( sut.size(), 4 );
+	EXPECT_EQ( yan::constrained_any_cast<const std::string&>( sut[0] ), std::string( "0" ) );
+	EXPECT_EQ( yan::constrained_any_cast<int>( sut[1] ), 1 );
+	EXPECT_EQ( yan::constrained_any_cast<int>( sut[3] ), 3 );
+}
+
+TEST( TestAnyRange, MakeAnyRange_ByInputIterator_ThenAppended )
+{
+	// Arrange
+	std::istringstream            iss( "1 2 3" );
+	std::vector<yan::keyable_any> sut;
+
+	// Act
+	yan::make_any_range<yan::keyable_any>( std::istream_iterator<int>( iss ), std::istream_iterator<int>(), sut );
+
+	// Assert
+	ASSERT_EQ( sut.size(), 3 );
+	EXPECT_EQ( yan::constrained_any_cast<int>( sut[2] ), 3 );
+}
+
+TEST( TestAnyRange, MakeAnyRange_ToOutputIterator_ThenReturnEnd )
+{
+	// Arrange
+	std::list<std::string>         src { "a", "b" };
+	std::list<yan::copyable_any>   sut;
+	std::vector<yan::copyable_any> sut_v( 2 );
+
+	// Act
+	yan::make_any_range<yan::copyable_any>( src.begin(), src.end(), std::back_inserter( sut ) );
+	auto it_end = yan::make_any_range<yan::copyable_any>( src.begin(), src.end(), sut_v.begin() );
+
+	// Assert
+	ASSERT_EQ( sut.size(), 2 );
+	EXPECT_EQ( yan::constrained_any_cast<const std::string&>( sut.back() ), std::string( "b" ) );
+	EXPECT_EQ( it_end, sut_v.end() );
+	EXPECT_EQ( yan::constrained_any_cast<const std::string&>( sut_v[0] ), std::string( "a" ) );
+}
+
+TEST( TestAnyRange, MakeAnyRange_MoveOnlyAny_ThenAppended )
+{
+	// Arrange
+	std::vector<std::string>        src { "a", "b" };
+	std::vector<yan::move_only_any> sut;
+
+	// Act
+	yan::make_any_range<yan::move_only_any>( std::make_move_iterator( src.begin() ), std::make_move_iterator( src.end() ), sut );
+
+	// Assert
+	ASSERT_EQ( sut.size(), 2 );
+	EXPECT_EQ( yan::constrained_any_cast<const std::string&>( sut[1] ), std::string( "b" ) );
+}
+
+TEST( TestAnyRange, AssignAll_ByIterator_ThenSameAndOtherTypesAreAssigned )
+{
+	// Arrange
+	std::vector<int>              src { 10, 20, 30 };
+	std::vector<yan::keyable_any> sut;
+	sut.emplace_back( 1 );
+	sut.emplace_back( std::string( "2" ) );
+	sut.emplace_back();
+
+	// Act
+	auto it_src = yan::assign_all( sut.begin(), sut.end(), src.begin() );
+
+	// Assert
+	EXPECT_EQ( it_src, src.end() );
+	EXPECT_EQ( yan::constrained_any_cast<int>( sut[0] ), 10 );
+	EXPECT_EQ( yan::constrained_any_cast<int>( sut[1] ), 20 );
+	EXPECT_EQ( yan::constrained_any_cast<int>( sut[2] ), 30 );
+}
+
+TEST( TestAnyRange, AssignAll_LongerRange_ThenVectorIsExtended )
+{
+	// Arrange
+	std::vector<int>              src { 10, 20, 30 };
+	std::vector<yan::keyable_any> sut;
+	sut.emplace_back( 1 );
+
+	// Act
+	yan::assign_all( sut, src );
+
+	// Assert
+	ASSERT_EQ( sut.size(), 3 );
+	EXPECT_EQ( yan::constrained_any_cast<int>( sut[0] ), 10 );
+	EXPECT_EQ( yan::constrained_any_cast<int>( sut[2] ), 30 );
+}
+
+TEST( TestAnyRange, AssignAll_ShorterRange_ThenVectorIsShrunk )
+{
+	// Arrange
+	std::vector<std::string>       src { "a" };
+	std::vector<yan::copyable_any> sut( 3 );
+
+	// Act
+	yan::assign_all( sut, src );
+
+	// Assert
+	ASSERT_EQ( sut.size(), 1 );
+	EXPECT_EQ( yan::constrained_any_cast<const std::string&>( sut[0] ), std::string( "a" ) );
+}
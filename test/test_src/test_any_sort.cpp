@@ -0,0 +1,216 @@
+/**
+ * @file test_any_sort.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "any_sort.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+namespace {
+
+struct test_key_t {
+	int a_;
+	int b_;
+
+	bool operator<( const test_key_t& rhs ) const
+	{
+		return a_ < rhs.a_;
+	}
+};
+
+template <int N>
+struct test_throwing_key_t {
+	int a_;
+
+	bool operator<( const test_throwing_key_t& ) const
+	{
+		throw std::runtime_error( "test_throwing_key_t" );
+	}
+};
+
+std::vector<yan::weak_ordering_any> make_mixed_values( size_t n, uint64_t seed )
+{
+	std::mt19937_64                     rng( seed );
+	std::vector<yan::weak_ordering_any> ans;
+	for ( size_t i = 0; i < n; i++ ) {
+		switch ( rng() % 7 ) {
+			case 0: ans.emplace_back( static_cast<int>( rng() % 100 ) - 50 ); break;
+			case 1: ans.emplace_back( static_cast<int64_t>( rng() ) ); break;
+			case 2: ans.emplace_back( static_cast<double>( static_cast<int64_t>( rng() % 2000 ) - 1000 ) / 8.0 ); break;
+			case 3: ans.emplace_back( std::to_string( rng() % 1000 ) ); break;
+			case 4: ans.emplace_back( test_key_t { static_cast<int>( rng() % 10 ), static_cast<int>( i ) } ); break;
+			case 5: ans.emplace_back( static_cast<uint16_t>( rng() ) ); break;
+			default: ans.emplace_back(); break;
+		}
+	}
+	return ans;
+}
+
+void expect_same_order( const std::vector<yan::weak_ordering_any>& actual, const std::vector<yan::weak_ordering_any>& expected )
+{
+	ASSERT_EQ( actual.size(), expected.size() );
+	for ( size_t i = 0; i < actual.size(); i++ ) {
+		ASSERT_EQ( actual[i].type(), expected[i].type() ) << "index " << i;
+		EXPECT_FALSE( actual[i] < expected[i] ) << "index " << i;
+		EXPECT_FALSE( expected[i] < actual[i] ) << "index " << i;
+		if ( actual[i].type() == typeid( double ) ) {
+			// -0.0 and 0.0 are equivalent, but the sign should be kept.
+			EXPECT_EQ( std::signbit( yan::constrained_any_cast<double>( actual[i] ) ), std::signbit( yan::constrained_any_cast<double>( expected[i] ) ) ) << "index " << i;
+		}
+		if ( actual[i].type() == typeid( test_key_t ) ) {
+			// stable
+			EXPECT_EQ( yan::constrained_any_cast<const test_key_t&>( actual[i] ).b_, yan::constrained_any_cast<const test_key_t&>( expected[i] ).b_ );
+		}
+	}
+}
+
+}   // namespace
+
+TEST( TestAnySort, MixedValues_ThenSameToStableSortByLess )
+{
+	// Arrange
+	std::vector<yan::weak_ordering_any> sut      = make_mixed_values( 5000, 1 );
+	std::vector<yan::weak_ordering_any> expected = sut;
+	std::stable_sort( expected.begin(), expected.end() );
+
+	// Act
+	yan::any_sort( sut );
+
+	// Assert
+	expect_same_order( sut, expected );
+}
+
+TEST( TestAnySort, Parallel_ThenSameToStableSortByLess )
+{
+	// Arrange
+	std::vector<yan::weak_ordering_any> sut      = make_mixed_values( 100000, 2 );
+	std::vector<yan::weak_ordering_any> expected = sut;
+	std::stable_sort( expected.begin(), expected.end() );
+
+	// Act
+	yan::any_sort( sut.begin(), sut.end(), 4 );
+
+	// Assert
+	expect_same_order( sut, expected );
+}
+
+TEST( TestAnySort, SpecifiedTypes_ThenOthersAreSortedByLess )
+{
+	// Arrange
+	std::vector<yan::weak_ordering_any> sut      = make_mixed_values( 5000, 3 );
+	std::vector<yan::weak_ordering_any> expected = sut;
+	std::stable_sort( expected.begin(), expected.end() );
+
+	// Act
+	yan::any_sort<int64_t, test_key_t>( sut );
+
+	// Assert
+	expect_same_order( sut, expected );
+}
+
+TEST( TestAnySort, ExtremeValues_ThenSameToLess )
+{
+	// Arrange
+	std::vector<yan::weak_ordering_any> sut {
+		std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(), int64_t { 0 }, int64_t { -1 },
+		std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), 0.0, -0.0, 0.0, -0.0, -1e300, 1e-300,
+		std::numeric_limits<unsigned long long>::max(), 0ULL };
+	std::vector<yan::weak_ordering_any> expected = sut;
+	std::stable_sort( expected.begin(), expected.end() );
+
+	// Act
+	yan::any_sort( sut );
+
+	// Assert
+	expect_same_order( sut, expected );
+}
+
+TEST( TestAnySort, StringsWithCommonPrefix_ThenSameToLess )
+{
+	// Arrange
+	std::vector<yan::weak_ordering_any> sut;
+	for ( int i = 0; i < 1000; i++ ) {
+		sut.emplace_back( "common_prefix_" + std::to_string( ( i * 7919 ) % 1000 ) );
+	}
+	sut.emplace_back( std::string( "common_prefix_" ) );
+	sut.emplace_back( std::string( "common_prefix_\xff" ) );
+	sut.emplace_back( std::string( "common_prefix_1\0", 16 ) );
+	sut.emplace_back( std::string( "common_prefix_1" ) );
+	std::vector<yan::weak_ordering_any> expected = sut;
+	std::stable_sort( expected.begin(), expected.end() );
+
+	// Act
+	yan::any_sort( sut );
+
+	// Assert
+	expect_same_order( sut, expected );
+	for ( size_t i = 0; i < sut.size(); i++ ) {
+		EXPECT_EQ( yan::constrained_any_cast<const std::string&>( sut[i] ), yan::constrained_any_cast<const std::string&>( expected[i] ) );
+	}
+}
+
+TEST( TestAnySort, EmptyAndSingle_ThenNothingHappens )
+{
+	// Arrange
+	std::vector<yan::weak_ordering_any> sut_empty;
+	std::vector<yan::weak_ordering_any> sut_single { 1 };
+
+	// Act
+	yan::any_sort( sut_empty );
+	yan::any_sort( sut_single );
+
+	// Assert
+	EXPECT_TRUE( sut_empty.empty() );
+	ASSERT_EQ( sut_single.size(), 1 );
+	EXPECT_EQ( yan::constrained_any_cast<int>( sut_single[0] ), 1 );
+}
+
+TEST( TestAnySort, ComparisonThrowsInThreads_ThenRethrowAfterJoin )
+{
+	// Arrange
+	std::vector<yan::weak_ordering_any> sut;
+	for ( int i = 0; i < 10000; i++ ) {
+		sut.emplace_back( test_throwing_key_t<0> { i } );
+		sut.emplace_back( test_throwing_key_t<1> { i } );
+		sut.emplace_back( test_throwing_key_t<2> { i } );
+		sut.emplace_back( test_throwing_key_t<3> { i } );
+	}
+
+	// Act
+	// Assert
+	EXPECT_THROW( yan::any_sort( sut.begin(), sut.end(), 4 ), std::runtime_error );
+	EXPECT_EQ( sut.size(), 40000 );
+}
+
+TEST( TestAnySort, UnqualifiedSortWithUsingStdSort_ThenStdSortIsCalled )
+{
+	// Arrange
+	std::vector<yan::weak_ordering_any> sut { 3, 1, 2 };
+
+	// Act
+	using std::sort;
+	sort( sut.begin(), sut.end() );
+
+	// Assert
+	EXPECT_EQ( yan::constrained_any_cast<int>( sut[0] ), 1 );
+	EXPECT_EQ( yan::constrained_any_cast<int>( sut[1] ), 2 );
+	EXPECT_EQ( yan::constrained_any_cast<int>( sut[2] ), 3 );
+}
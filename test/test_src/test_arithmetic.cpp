@@ -0,0 +1,171 @@
+/**
+ * @file test_arithmetic.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <any>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "constrained_any_arithmetic.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+TEST( TestArithmetic, SameType_ThenResultIsSameType )
+{
+	// Arrange
+	yan::arithmetic_any a( 3 );
+	yan::arithmetic_any b( 4 );
+
+	// Act
+	yan::arithmetic_any r_add = a.add( b );
+	yan::arithmetic_any r_sub = a - b;
+	yan::arithmetic_any r_mul = a * b;
+
+	// Assert
+	ASSERT_EQ( r_add.type(), typeid( int ) );
+	EXPECT_EQ( yan::constrained_any_cast<int>( r_add ), 7 );
+	EXPECT_EQ( yan::constrained_any_cast<int>( r_sub ), -1 );
+	EXPECT_EQ( yan::constrained_any_cast<int>( r_mul ), 12 );
+}
+
+TEST( TestArithmetic, DifferentTypes_ThenResultTypeIsSameToBuiltinOperator )
+{
+	// Arrange
+	using int_int64_t   = decltype( int {} + int64_t {} );
+	using short_short_t = decltype( short {} + short {} );
+	yan::arithmetic_any a_int( 3 );
+	yan::arithmetic_any a_int64( int64_t { 1 } << 40 );
+	yan::arithmetic_any a_double( 0.5 );
+	yan::arithmetic_any a_short( short { 2 } );
+
+	// Act
+	yan::arithmetic_any r_int_double  = a_int + a_double;
+	yan::arithmetic_any r_int_int64   = a_int + a_int64;
+	yan::arithmetic_any r_int64_int   = a_int64 - a_int;
+	yan::arithmetic_any r_short_short = a_short * a_short;
+
+	// Assert
+	ASSERT_EQ( r_int_double.type(), typeid( double ) );
+	EXPECT_EQ( yan::constrained_any_cast<double>( r_int_double ), 3.5 );
+	ASSERT_EQ( r_int_int64.type(), typeid( int_int64_t ) );
+	EXPECT_EQ( yan::constrained_any_cast<int_int64_t>( r_int_int64 ), ( int64_t { 1 } << 40 ) + 3 );
+	EXPECT_EQ( yan::constrained_any_cast<int_int64_t>( r_int64_int ), ( int64_t { 1 } << 40 ) - 3 );
+	ASSERT_EQ( r_short_short.type(), typeid( short_short_t ) );
+	EXPECT_EQ( yan::constrained_any_cast<short_short_t>( r_short_short ), 4 );
+}
+
+TEST( TestArithmetic, SignedOverflow_ThenWrapsAround )
+{
+	// Arrange
+	yan::arithmetic_any a( std::numeric_limits<int>::max() );
+	yan::arithmetic_any b( 1 );
+
+	// Act
+	yan::arithmetic_any r = a + b;
+
+	// Assert
+	EXPECT_EQ( yan::constrained_any_cast<int>( r ), std::numeric_limits<int>::min() );
+}
+
+TEST( TestArithmetic, Compare_ThenOrderingOfValues )
+{
+	// Arrange
+	yan::arithmetic_any a_minus( -1 );
+	yan::arithmetic_any a_unsigned( 0U );
+	yan::arithmetic_any a_double( -1.0 );
+	yan::arithmetic_any a_nan( std::numeric_limits<double>::quiet_NaN() );
+	yan::arithmetic_any a_uint64( std::numeric_limits<uint64_t>::max() );
+
+	// Act & Assert
+	EXPECT_EQ( a_minus.compare( a_unsigned ), yan::arithmetic_ordering::less );
+	EXPECT_EQ( a_unsigned.compare( a_minus ), yan::arithmetic_ordering::greater );
+	EXPECT_EQ( a_minus.compare( a_double ), yan::arithmetic_ordering::equivalent );
+	EXPECT_EQ( a_minus.compare( a_minus ), yan::arithmetic_ordering::equivalent );
+	EXPECT_EQ( a_minus.compare( a_uint64 ), yan::arithmetic_ordering::less );
+	EXPECT_EQ( a_nan.compare( a_minus ), yan::arithmetic_ordering::unordered );
+	EXPECT_EQ( a_nan.compare( a_nan ), yan::arithmetic_ordering::unordered );
+}
+
+TEST( TestArithmetic, NoValue_ThenThrow )
+{
+	// Arrange
+	yan::arithmetic_any a_empty;
+	yan::arithmetic_any a( 1 );
+
+	// Act & Assert
+	EXPECT_THROW( a.add( a_empty ), std::bad_any_cast );
+	EXPECT_THROW( a_empty.compare( a ), std::bad_any_cast );
+}
+
+TEST( TestArithmetic, Batch_ThenSameToEachOperation )
+{
+	// Arrange
+	std::vector<yan::arithmetic_any> a_same;
+	std::vector<yan::arithmetic_any> b_same;
+	std::vector<yan::arithmetic_any> a_mixed;
+	std::vector<yan::arithmetic_any> b_mixed;
+	for ( int i = 0; i < 1000; i++ ) {
+		a_same.emplace_back( static_cast<int64_t>( i * 3 ) );
+		b_same.emplace_back( static_cast<int64_t>( 500 - i ) );
+		if ( i % 2 == 0 ) {
+			a_mixed.emplace_back( i );
+		} else {
+			a_mixed.emplace_back( static_cast<double>( i ) / 4.0 );
+		}
+		b_mixed.emplace_back( static_cast<int64_t>( 500 - i ) );
+	}
+
+	for ( auto* p_pair : { &a_same, &a_mixed } ) {
+		const std::vector<yan::arithmetic_any>& a = *p_pair;
+		const std::vector<yan::arithmetic_any>& b = ( p_pair == &a_same ) ? b_same : b_mixed;
+		std::vector<yan::arithmetic_any>        r_add( a.size() );
+		std::vector<yan::arithmetic_any>        r_sub( a.size() );
+		std::vector<yan::arithmetic_any>        r_mul( a.size() );
+		std::vector<yan::arithmetic_ordering>   r_cmp( a.size() );
+
+		// Act
+		yan::add_batch( a.data(), b.data(), r_add.data(), a.size() );
+		yan::sub_batch( a.data(), b.data(), r_sub.data(), a.size() );
+		yan::mul_batch( a.data(), b.data(), r_mul.data(), a.size() );
+		yan::compare_batch( a.data(), b.data(), r_cmp.data(), a.size() );
+
+		// Assert
+		for ( size_t i = 0; i < a.size(); i++ ) {
+			yan::arithmetic_any e_add = a[i].add( b[i] );
+			yan::arithmetic_any e_sub = a[i].sub( b[i] );
+			yan::arithmetic_any e_mul = a[i].mul( b[i] );
+			ASSERT_EQ( r_add[i].type(), e_add.type() );
+			EXPECT_EQ( r_add[i].compare( e_add ), yan::arithmetic_ordering::equivalent );
+			EXPECT_EQ( r_sub[i].compare( e_sub ), yan::arithmetic_ordering::equivalent );
+			EXPECT_EQ( r_mul[i].compare( e_mul ), yan::arithmetic_ordering::equivalent );
+			EXPECT_EQ( r_cmp[i], a[i].compare( b[i] ) );
+		}
+	}
+}
+
+TEST( TestArithmetic, BatchInPlace_ThenAccumulated )
+{
+	// Arrange
+	std::vector<yan::arithmetic_any> acc( 300, yan::arithmetic_any( 1.5 ) );
+	std::vector<yan::arithmetic_any> b( 300, yan::arithmetic_any( 2.0 ) );
+
+	// Act
+	yan::add_batch( acc.data(), b.data(), acc.data(), acc.size() );
+	yan::add_batch( acc.data(), b.data(), acc.data(), acc.size() );
+
+	// Assert
+	for ( const auto& e : acc ) {
+		EXPECT_EQ( yan::constrained_any_cast<double>( e ), 5.5 );
+	}
+}
@@ -0,0 +1,125 @@
+/**
+ * @file test_compact_any.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "constrained_any.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+TEST( TestCompactAny, Sizeof_ThenNotLargerThan32Bytes )
+{
+	EXPECT_LE( sizeof( yan::compact_copyable_any ), 32 );
+	EXPECT_LE( sizeof( yan::compact_weak_ordering_any ), 32 );
+	EXPECT_LE( sizeof( yan::compact_unordered_key_any ), 32 );
+	EXPECT_LE( sizeof( yan::compact_keyable_any ), 32 );
+}
+
+#if __cpp_concepts >= 201907L
+
+TEST( TestCompactAny, ScalarValue_ThenInline )
+{
+	EXPECT_EQ( ( yan::storage_traits<yan::compact_keyable_any, int64_t>::inline_buffer_size ), 32 - sizeof( void* ) );
+	EXPECT_TRUE( ( yan::storage_traits<yan::compact_keyable_any, int64_t>::is_inline ) );
+	EXPECT_TRUE( ( yan::storage_traits<yan::compact_keyable_any, std::string_view>::is_inline ) );
+	EXPECT_TRUE( ( yan::storage_traits<yan::compact_keyable_any, double>::is_inline ) );
+	EXPECT_TRUE( ( yan::storage_traits<yan::compact_keyable_any, int>::is_inline ) );
+}
+
+TEST( TestCompactAny, String_ThenSpillBySize )
+{
+	using sut_t = yan::storage_traits<yan::compact_keyable_any, std::string>;
+
+	EXPECT_FALSE( sut_t::is_inline );
+	EXPECT_EQ( sut_t::spill_reason, yan::storage_spill_reason::size );
+}
+
+#endif
+
+TEST( TestCompactAny, InlineAndHeap_CanSwap )
+{
+	// Arrange
+	yan::compact_keyable_any sut_a( int64_t { 1 } );
+	yan::compact_keyable_any sut_b( std::string( "string value over SSO of std::string" ) );
+
+	// Act
+	sut_a.swap( sut_b );
+
+	// Assert
+	EXPECT_EQ( yan::constrained_any_cast<const std::string&>( sut_a ), std::string( "string value over SSO of std::string" ) );
+	EXPECT_EQ( yan::constrained_any_cast<int64_t>( sut_b ), 1 );
+}
+
+TEST( TestCompactAny, HasValue_CanCopyAndAssign )
+{
+	// Arrange
+	yan::compact_copyable_any sut_a( 1.0 );
+	yan::compact_copyable_any sut_b( std::string( "a" ) );
+
+	// Act
+	yan::compact_copyable_any sut_c( sut_b );
+	sut_b = sut_a;
+	sut_a = std::string( "b" );
+
+	// Assert
+	EXPECT_EQ( yan::constrained_any_cast<double>( sut_b ), 1.0 );
+	EXPECT_EQ( yan::constrained_any_cast<const std::string&>( sut_a ), std::string( "b" ) );
+	EXPECT_EQ( yan::constrained_any_cast<const std::string&>( sut_c ), std::string( "a" ) );
+}
+
+TEST( TestCompactAny, CompactKeyableAny_CanUseAsKeyOfMapAndUnorderedMap )
+{
+	// Arrange
+	std::map<yan::compact_keyable_any, int>           sut_map;
+	std::unordered_map<yan::compact_keyable_any, int> sut_umap;
+
+	// Act
+	sut_map.emplace( int64_t { 1 }, 1 );
+	sut_map.emplace( 2.0, 2 );
+	sut_map.emplace( std::string( "3" ), 3 );
+	sut_umap.emplace( int64_t { 1 }, 1 );
+	sut_umap.emplace( 2.0, 2 );
+	sut_umap.emplace( std::string( "3" ), 3 );
+
+	// Assert
+	EXPECT_EQ( sut_map.size(), 3 );
+	EXPECT_EQ( sut_umap.size(), 3 );
+	EXPECT_EQ( sut_map.at( yan::compact_keyable_any( std::string( "3" ) ) ), 3 );
+	EXPECT_EQ( sut_umap.at( yan::compact_keyable_any( 2.0 ) ), 2 );
+	EXPECT_EQ( sut_map.count( yan::compact_keyable_any( int64_t { 4 } ) ), 0 );
+}
+
+TEST( TestCompactAny, CompactWeakOrderingAndUnorderedKeyAny_CanUseAsKey )
+{
+	// Arrange
+	std::set<yan::compact_weak_ordering_any>           sut_set;
+	std::unordered_set<yan::compact_unordered_key_any> sut_uset;
+
+	// Act
+	sut_set.emplace( 1 );
+	sut_set.emplace( 1 );
+	sut_set.emplace( std::string( "1" ) );
+	sut_uset.emplace( 1 );
+	sut_uset.emplace( 1 );
+	sut_uset.emplace( std::string( "1" ) );
+
+	// Assert
+	EXPECT_EQ( sut_set.size(), 2 );
+	EXPECT_EQ( sut_uset.size(), 2 );
+}
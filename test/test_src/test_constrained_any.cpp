@@ -531,6 +531,36 @@ TEST( TestConstrainedAny, HasValue_CanMoveAssignBySameType )
 	EXPECT_EQ( yan::constrained_any_cast<TestCopyOnlyType&>( sut ).v_, 42 );
 }
 
+TEST( TestConstrainedAny, LargerThanSSOSizeValue_CanCopyAssignBySameType )
+{
+	// Arrange
+	yan::copyable_any src = TestOverSSOSize( 3 );
+	yan::copyable_any sut = TestOverSSOSize( 4 );
+
+	// Act
+	sut = src;
+
+	// Assert
+	EXPECT_EQ( src.type(), typeid( TestOverSSOSize ) );
+	EXPECT_EQ( yan::constrained_any_cast<TestOverSSOSize&>( src ).v_buff[0], 3 );
+	EXPECT_EQ( sut.type(), typeid( TestOverSSOSize ) );
+	EXPECT_EQ( yan::constrained_any_cast<TestOverSSOSize&>( sut ).v_buff[0], 3 );
+}
+
+TEST( TestConstrainedAny, LargerThanSSOSizeValue_CanMoveAssignBySameType )
+{
+	// Arrange
+	yan::copyable_any src = TestOverSSOSize( 3 );
+	yan::copyable_any sut = TestOverSSOSize( 4 );
+
+	// Act
+	sut = std::move( src );
+
+	// Assert
+	EXPECT_EQ( sut.type(), typeid( TestOverSSOSize ) );
+	EXPECT_EQ( yan::constrained_any_cast<TestOverSSOSize&>( sut ).v_buff[0], 3 );
+}
+
 TEST( TestConstrainedAny, CanTranslationConstructorFromLValue )
 {
 	// Arrange
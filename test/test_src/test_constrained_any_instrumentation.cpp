@@ -0,0 +1,213 @@
+/**
+ * @file test_constrained_any_instrumentation.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+// test_constrained_any_instrumentation_disabled builds this file without instrumentation.
+#ifndef YAN_TEST_INSTRUMENTATION_DISABLED
+#define YAN_CONSTRAINED_ANY_ENABLE_INSTRUMENTATION
+#endif
+
+#include <array>
+#include <string>
+#include <thread>
+
+#include "constrained_any.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+struct TestInstrumentationOverSSOSize {
+	std::array<int, yan::impl::sso_buff_size> v_buff;
+
+	TestInstrumentationOverSSOSize( int v )
+	  : v_buff { v }
+	{
+	}
+};
+
+#if __cpp_concepts >= 201907L
+static constexpr bool is_small_value_inline = true;
+#else
+static constexpr bool is_small_value_inline = false;
+#endif
+
+class TestConstrainedAnyInstrumentation : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		yan::reset_instrumentation_counters();
+	}
+};
+
+// ================================================
+
+#ifdef YAN_CONSTRAINED_ANY_ENABLE_INSTRUMENTATION
+
+TEST_F( TestConstrainedAnyInstrumentation, IsEnabled )
+{
+	EXPECT_TRUE( yan::is_instrumentation_enabled );
+}
+
+TEST_F( TestConstrainedAnyInstrumentation, SmallValue_CanConstruct_ThenCountStorageClass )
+{
+	// Arrange
+
+	// Act
+	yan::copyable_any sut( 1 );
+
+	// Assert
+	auto cnt = yan::get_instrumentation_counters();
+	if ( is_small_value_inline ) {
+		EXPECT_EQ( cnt.inline_constructions_, 1 );
+		EXPECT_EQ( cnt.heap_constructions_, 0 );
+		EXPECT_EQ( cnt.heap_bytes_, 0 );
+	} else {
+		EXPECT_EQ( cnt.inline_constructions_, 0 );
+		EXPECT_EQ( cnt.heap_constructions_, 1 );
+		EXPECT_GE( cnt.heap_bytes_, sizeof( int ) );
+	}
+}
+
+TEST_F( TestConstrainedAnyInstrumentation, LargerThanSSOSizeValue_CanConstruct_ThenCountHeap )
+{
+	// Arrange
+
+	// Act
+	yan::copyable_any sut( std::in_place_type<TestInstrumentationOverSSOSize>, 1 );
+
+	// Assert
+	auto cnt = yan::get_instrumentation_counters();
+	EXPECT_EQ( cnt.inline_constructions_, 0 );
+	EXPECT_EQ( cnt.heap_constructions_, 1 );
+	EXPECT_GE( cnt.heap_bytes_, sizeof( TestInstrumentationOverSSOSize ) );
+}
+
+TEST_F( TestConstrainedAnyInstrumentation, HasValue_CanCopyConstruct_ThenCountClone )
+{
+	// Arrange
+	yan::copyable_any src( std::string( "a" ) );
+	yan::reset_instrumentation_counters();
+
+	// Act
+	yan::copyable_any sut( src );
+
+	// Assert
+	auto cnt = yan::get_instrumentation_counters();
+	EXPECT_EQ( cnt.clones_, 1 );
+	EXPECT_EQ( cnt.inline_constructions_ + cnt.heap_constructions_, 1 );
+}
+
+TEST_F( TestConstrainedAnyInstrumentation, HasValue_CanAssignBySameType_ThenCountSameTypeAssign )
+{
+	// Arrange
+	yan::copyable_any src( 1 );
+	yan::copyable_any sut( 2 );
+	yan::reset_instrumentation_counters();
+
+	// Act
+	sut = src;
+	sut = 3;
+
+	// Assert
+	auto cnt = yan::get_instrumentation_counters();
+	EXPECT_EQ( cnt.same_type_assigns_, 2 );
+	EXPECT_EQ( cnt.type_changing_reconstructs_, 0 );
+}
+
+TEST_F( TestConstrainedAnyInstrumentation, HasValue_CanAssignByOtherType_ThenCountReconstruct )
+{
+	// Arrange
+	yan::copyable_any src( 1 );
+	yan::copyable_any sut( std::string( "a" ) );
+	yan::reset_instrumentation_counters();
+
+	// Act
+	sut = src;
+	sut = 2.0;
+	sut.emplace<std::string>( "b" );
+	sut.reset();
+
+	// Assert
+	auto cnt = yan::get_instrumentation_counters();
+	EXPECT_EQ( cnt.same_type_assigns_, 0 );
+	EXPECT_EQ( cnt.type_changing_reconstructs_, 4 );
+}
+
+TEST_F( TestConstrainedAnyInstrumentation, HasValue_CanEmplaceOrResetBySameType_ThenNotCountReconstruct )
+{
+	// Arrange
+	yan::copyable_any sut( std::string( "a" ) );
+	yan::copyable_any sut_empty;
+	yan::reset_instrumentation_counters();
+
+	// Act
+	sut.emplace<std::string>( "b" );
+	sut_empty.reset();
+
+	// Assert
+	auto cnt = yan::get_instrumentation_counters();
+	EXPECT_EQ( cnt.type_changing_reconstructs_, 0 );
+	EXPECT_EQ( yan::constrained_any_cast<std::string>( sut ), "b" );
+}
+
+TEST_F( TestConstrainedAnyInstrumentation, OutOfScope_ThenConstructionsAndDestructionsAreBalanced )
+{
+	// Arrange
+
+	// Act
+	{
+		yan::keyable_any a( 1 );
+		yan::keyable_any b( std::string( "a" ) );
+		a = b;
+		a.swap( b );
+	}
+
+	// Assert
+	auto cnt = yan::get_instrumentation_counters();
+	EXPECT_GT( cnt.destructions_, 0 );
+	EXPECT_EQ( cnt.inline_constructions_ + cnt.heap_constructions_, cnt.destructions_ );
+}
+
+TEST_F( TestConstrainedAnyInstrumentation, OtherThread_CanConstruct_ThenAggregateAfterThreadExit )
+{
+	// Arrange
+
+	// Act
+	std::thread t( []() {
+		yan::copyable_any sut( std::in_place_type<TestInstrumentationOverSSOSize>, 1 );
+	} );
+	t.join();
+
+	// Assert
+	auto cnt = yan::get_instrumentation_counters();
+	EXPECT_EQ( cnt.heap_constructions_, 1 );
+	EXPECT_EQ( cnt.destructions_, 1 );
+}
+
+#else
+
+TEST_F( TestConstrainedAnyInstrumentation, NotEnabled_ThenCountersAreZero )
+{
+	// Arrange
+	yan::copyable_any src( 1 );
+
+	// Act
+	yan::copyable_any sut( src );
+
+	// Assert
+	EXPECT_FALSE( yan::is_instrumentation_enabled );
+	auto cnt = yan::get_instrumentation_counters();
+	EXPECT_EQ( cnt.inline_constructions_, 0 );
+	EXPECT_EQ( cnt.heap_constructions_, 0 );
+	EXPECT_EQ( cnt.clones_, 0 );
+}
+
+#endif
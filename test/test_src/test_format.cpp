@@ -0,0 +1,141 @@
+/**
+ * @file test_format.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "constrained_any_format.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+namespace {
+
+struct test_point_t {
+	int x_;
+	int y_;
+};
+
+struct test_not_formattable_t {
+	int a_;
+};
+
+}   // namespace
+
+template <>
+struct yan::format_traits<test_point_t> {
+	static size_t format( const test_point_t& v, char* p_buff, size_t buff_size ) noexcept
+	{
+		char   tmp[64];
+		size_t len = 0;
+		tmp[len++] = '(';
+		len += yan::format_traits<int>::format( v.x_, tmp + len, sizeof( tmp ) - len );
+		tmp[len++] = ',';
+		len += yan::format_traits<int>::format( v.y_, tmp + len, sizeof( tmp ) - len );
+		tmp[len++] = ')';
+		return yan::impl::format_copy_to( tmp, len, p_buff, buff_size );
+	}
+};
+
+TEST( TestFormat, Values_ThenFormattedText )
+{
+	// Arrange
+
+	// Act
+	// Assert
+	EXPECT_EQ( yan::formattable_any( 123 ).to_string(), "123" );
+	EXPECT_EQ( yan::formattable_any( int64_t { -9223372036854775807 } ).to_string(), "-9223372036854775807" );
+	EXPECT_EQ( yan::formattable_any( 0.1 ).to_string(), "0.1" );
+	EXPECT_EQ( yan::formattable_any( 1.5F ).to_string(), "1.5" );
+	EXPECT_EQ( yan::formattable_any( true ).to_string(), "true" );
+	EXPECT_EQ( yan::formattable_any( 'x' ).to_string(), "x" );
+	EXPECT_EQ( yan::formattable_any( "c string" ).to_string(), "c string" );
+	EXPECT_EQ( yan::formattable_any( std::string( "string" ) ).to_string(), "string" );
+	EXPECT_EQ( yan::formattable_any( std::string_view( "view" ) ).to_string(), "view" );
+	EXPECT_EQ( yan::formattable_any( test_point_t { 1, -2 } ).to_string(), "(1,-2)" );
+	EXPECT_EQ( yan::formattable_any().to_string(), "" );
+}
+
+TEST( TestFormat, SmallBuffer_ThenTruncatedAndReturnWholeLength )
+{
+	// Arrange
+	yan::formattable_any sut( 123456 );
+	char                 buff[4] = { '#', '#', '#', '#' };
+
+	// Act
+	size_t len = sut.format_to( buff, 3 );
+
+	// Assert
+	EXPECT_EQ( len, 6 );
+	EXPECT_EQ( std::string_view( buff, 4 ), "123#" );
+}
+
+TEST( TestFormat, FormatAppend_ThenAppendToEnd )
+{
+	// Arrange
+	std::string          out = "a=";
+	yan::formattable_any a( 1 );
+	yan::formattable_any b( std::string( 200, 'z' ) );
+
+	// Act
+	a.format_append( out );
+	out += ", b=";
+	b.format_append( out );
+
+	// Assert
+	EXPECT_EQ( out, "a=1, b=" + std::string( 200, 'z' ) );
+}
+
+TEST( TestFormat, FormatAppend_WithEnoughCapacity_ThenNoReallocation )
+{
+	// Arrange
+	std::string out;
+	out.reserve( 256 );
+	const char*          p_data = out.data();
+	yan::formattable_any sut( 3.25 );
+
+	// Act
+	for ( int i = 0; i < 10; i++ ) {
+		sut.format_append( out );
+	}
+
+	// Assert
+	EXPECT_EQ( out.size(), 40 );
+	EXPECT_EQ( out.data(), p_data );
+}
+
+TEST( TestFormat, OutputStream_ThenSameToToString )
+{
+	// Arrange
+	std::ostringstream   oss;
+	yan::formattable_any a( 42 );
+	yan::formattable_any b( std::string( 300, 'y' ) );
+
+	// Act
+	oss << a << ' ' << b << ' ' << yan::formattable_any();
+
+	// Assert
+	EXPECT_EQ( oss.str(), "42 " + std::string( 300, 'y' ) + " " );
+}
+
+TEST( TestFormat, NotFormattableType_ThenNotConstructible )
+{
+	// Arrange
+
+	// Act
+	// Assert
+	EXPECT_TRUE( ( std::is_constructible<yan::formattable_any, int>::value ) );
+	EXPECT_FALSE( ( std::is_constructible<yan::formattable_any, test_not_formattable_t>::value ) );
+}
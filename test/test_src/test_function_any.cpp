@@ -0,0 +1,150 @@
+/**
+ * @file test_function_any.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "function_any.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+namespace {
+
+int test_add( int a, int b )
+{
+	return a + b;
+}
+
+struct test_counter_t {
+	int operator()( int d )
+	{
+		count_ += d;
+		return count_;
+	}
+
+	int count_ = 0;
+};
+
+}   // namespace
+
+TEST( TestFunctionAny, Lambda_CanInvoke )
+{
+	// Arrange
+	int                           base = 10;
+	yan::function_any<int( int )> sut( [base]( int x ) { return base + x; } );
+
+	// Act
+	int ret = sut( 5 );
+
+	// Assert
+	EXPECT_EQ( ret, 15 );
+}
+
+TEST( TestFunctionAny, FunctionPointer_CanInvoke )
+{
+	// Arrange
+	yan::function_any<int( int, int )> sut( &test_add );
+
+	// Act
+	int ret = sut( 1, 2 );
+
+	// Assert
+	EXPECT_EQ( ret, 3 );
+}
+
+TEST( TestFunctionAny, StatefulCallable_ThenStateIsKept )
+{
+	// Arrange
+	yan::function_any<int( int )> sut( test_counter_t {} );
+
+	// Act
+	sut( 1 );
+	sut( 2 );
+	int ret = sut( 3 );
+
+	// Assert
+	EXPECT_EQ( ret, 6 );
+	EXPECT_EQ( yan::constrained_any_cast<const test_counter_t&>( sut ).count_, 6 );
+}
+
+TEST( TestFunctionAny, MoveOnlyCapture_CanHoldAndMove )
+{
+	// Arrange
+	auto                           up = std::make_unique<int>( 7 );
+	yan::function_any<int( void )> src( [up = std::move( up )]() { return *up; } );
+
+	// Act
+	yan::function_any<int( void )> sut( std::move( src ) );
+
+	// Assert
+	EXPECT_EQ( sut(), 7 );
+	EXPECT_FALSE( std::is_copy_constructible<yan::function_any<int( void )>>::value );
+}
+
+TEST( TestFunctionAny, LargeCapture_CanInvoke )
+{
+	// Arrange
+	std::array<int, 64> values {};
+	values[63] = 9;
+	yan::function_any<int( size_t )> sut( [values]( size_t i ) { return values[i]; } );
+
+	// Act
+	int ret = sut( 63 );
+
+	// Assert
+	EXPECT_EQ( ret, 9 );
+}
+
+TEST( TestFunctionAny, ArgumentsAndResult_ThenForwarded )
+{
+	// Arrange
+	std::string                                            moved_to;
+	yan::function_any<void( std::string&&, std::string& )> sut_a( []( std::string&& src, std::string& dst ) { dst = std::move( src ); } );
+	yan::function_any<std::unique_ptr<int>( int )>         sut_b( []( int v ) { return std::make_unique<int>( v ); } );
+	yan::function_any<long( int )>                         sut_c( []( int v ) { return v * 2; } );
+
+	// Act
+	sut_a( std::string( "moved" ), moved_to );
+	std::unique_ptr<int> up = sut_b( 3 );
+
+	// Assert
+	EXPECT_EQ( moved_to, "moved" );
+	ASSERT_NE( up, nullptr );
+	EXPECT_EQ( *up, 3 );
+	EXPECT_EQ( sut_c( 21 ), 42L );
+}
+
+TEST( TestFunctionAny, Empty_ThenThrowBadFunctionCall )
+{
+	// Arrange
+	yan::function_any<int( int )> sut;
+
+	// Act
+	// Assert
+	EXPECT_THROW( sut( 1 ), std::bad_function_call );
+}
+
+TEST( TestFunctionAny, NotInvocable_ThenNotConstructible )
+{
+	// Arrange
+
+	// Act
+	// Assert
+	EXPECT_TRUE( ( std::is_constructible<yan::function_any<int( int )>, int ( * )( int )>::value ) );
+	EXPECT_FALSE( ( std::is_constructible<yan::function_any<int( int )>, int>::value ) );
+	EXPECT_FALSE( ( std::is_constructible<yan::function_any<int( int )>, void ( * )( std::string )>::value ) );
+}
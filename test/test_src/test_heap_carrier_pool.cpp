@@ -0,0 +1,195 @@
+/**
+ * @file test_heap_carrier_pool.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "constrained_any.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+using pooled_copyable_any = yan::constrained_any<yan::impl::special_operation_copyable, yan::impl::special_operation_pooled_heap>;
+
+template <size_t N>
+struct TestPoolPayload {
+	std::array<int, N / sizeof( int )> v_buff;
+
+	TestPoolPayload( int v )
+	  : v_buff { v }
+	{
+	}
+};
+
+using TestPoolHeapPayload      = TestPoolPayload<2 * yan::impl::sso_buff_size>;
+using TestPoolOverBlockPayload = TestPoolPayload<2 * yan::impl::heap_carrier_pool_max_block_size>;
+
+struct alignas( 2 * alignof( std::max_align_t ) ) TestPoolOverAligned {
+	int v_;
+};
+
+class TestHeapCarrierPool : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		yan::reset_heap_carrier_pool_stats();
+	}
+};
+
+// ================================================
+
+TEST( TestHeapCarrierPoolSizeClass, SizeClassOf_ThenBlockIsNotSmallerThanSize )
+{
+	EXPECT_EQ( yan::impl::heap_carrier_pool_size_class_of( 1 ), 0 );
+	EXPECT_EQ( yan::impl::heap_carrier_pool_size_class_of( 16 ), 0 );
+	EXPECT_EQ( yan::impl::heap_carrier_pool_size_class_of( 17 ), 1 );
+	EXPECT_EQ( yan::impl::heap_carrier_pool_size_class_of( 264 ), 5 );
+	EXPECT_EQ( yan::impl::heap_carrier_pool_block_size_of( 5 ), 512 );
+	EXPECT_EQ( yan::impl::heap_carrier_pool_size_class_of( yan::impl::heap_carrier_pool_max_block_size ), yan::impl::heap_carrier_pool_num_of_classes - 1 );
+}
+
+TEST_F( TestHeapCarrierPool, NotPooledAlias_CanConstruct_ThenPoolIsNotUsed )
+{
+	// Arrange
+
+	// Act
+	yan::copyable_any sut( std::in_place_type<TestPoolHeapPayload>, 1 );
+
+	// Assert
+	auto stats = yan::get_heap_carrier_pool_stats();
+	EXPECT_EQ( stats.allocations_, 0 );
+}
+
+TEST_F( TestHeapCarrierPool, HeapValue_CanConstructTwice_ThenSecondIsFreelistHit )
+{
+	// Arrange
+	{
+		pooled_copyable_any warm_up( std::in_place_type<TestPoolHeapPayload>, 1 );
+	}
+	yan::reset_heap_carrier_pool_stats();
+
+	// Act
+	pooled_copyable_any sut( std::in_place_type<TestPoolHeapPayload>, 2 );
+
+	// Assert
+	auto stats = yan::get_heap_carrier_pool_stats();
+	EXPECT_EQ( stats.allocations_, 1 );
+	EXPECT_EQ( stats.freelist_hits_, 1 );
+	EXPECT_EQ( stats.fallbacks_, 0 );
+	EXPECT_EQ( yan::constrained_any_cast<const TestPoolHeapPayload&>( sut ).v_buff[0], 2 );
+}
+
+TEST_F( TestHeapCarrierPool, HeapValue_CanCopyAndAssign_ThenAllocationsAndDeallocationsAreBalanced )
+{
+	// Arrange
+
+	// Act
+	{
+		pooled_copyable_any sut_a( std::in_place_type<TestPoolHeapPayload>, 1 );
+		pooled_copyable_any sut_b( sut_a );
+		pooled_copyable_any sut_c( std::string( "c" ) );
+		for ( int i = 0; i < 100; i++ ) {
+			sut_c = sut_a;
+			sut_c = std::string( "c" );
+		}
+		sut_b = sut_c;
+
+		EXPECT_EQ( yan::constrained_any_cast<const TestPoolHeapPayload&>( sut_a ).v_buff[0], 1 );
+		EXPECT_EQ( yan::constrained_any_cast<const std::string&>( sut_b ), std::string( "c" ) );
+	}
+
+	// Assert
+	auto stats = yan::get_heap_carrier_pool_stats();
+	EXPECT_GT( stats.allocations_, 100 );
+	EXPECT_EQ( stats.allocations_, stats.deallocations_ );
+	EXPECT_GT( stats.hit_rate(), 0.9 );
+}
+
+TEST_F( TestHeapCarrierPool, OverBlockSizeValue_CanConstruct_ThenFallback )
+{
+	// Arrange
+
+	// Act
+	pooled_copyable_any sut( std::in_place_type<TestPoolOverBlockPayload>, 1 );
+
+	// Assert
+	auto stats = yan::get_heap_carrier_pool_stats();
+	EXPECT_EQ( stats.allocations_, 1 );
+	EXPECT_EQ( stats.fallbacks_, 1 );
+	EXPECT_EQ( yan::constrained_any_cast<const TestPoolOverBlockPayload&>( sut ).v_buff[0], 1 );
+}
+
+TEST_F( TestHeapCarrierPool, OverAlignedValue_CanConstruct_ThenFallbackAndAligned )
+{
+	// Arrange
+
+	// Act
+	pooled_copyable_any sut( TestPoolOverAligned { 3 } );
+
+	// Assert
+	const TestPoolOverAligned* p = yan::constrained_any_cast<TestPoolOverAligned>( &sut );
+	ASSERT_NE( p, nullptr );
+	EXPECT_EQ( reinterpret_cast<uintptr_t>( p ) % alignof( TestPoolOverAligned ), 0 );
+	EXPECT_EQ( p->v_, 3 );
+	auto stats = yan::get_heap_carrier_pool_stats();
+	EXPECT_EQ( stats.fallbacks_, 1 );
+}
+
+TEST_F( TestHeapCarrierPool, OtherThreadAllocated_CanDestructInThisThread_ThenReturnToCentral )
+{
+	// Arrange
+	constexpr size_t                 num_of_values = 4 * yan::impl::heap_carrier_pool_local_limit;
+	std::vector<pooled_copyable_any> values;
+	values.reserve( num_of_values );
+
+	// Act
+	std::thread t( [&values]() {
+		for ( size_t i = 0; i < num_of_values; i++ ) {
+			values.emplace_back( std::in_place_type<TestPoolHeapPayload>, static_cast<int>( i ) );
+		}
+	} );
+	t.join();
+	for ( size_t i = 0; i < num_of_values; i++ ) {
+		EXPECT_EQ( yan::constrained_any_cast<const TestPoolHeapPayload&>( values[i] ).v_buff[0], static_cast<int>( i ) );
+	}
+	values.clear();
+	values.shrink_to_fit();
+
+	// Assert
+	auto stats = yan::get_heap_carrier_pool_stats();
+	EXPECT_EQ( stats.allocations_, num_of_values );
+	EXPECT_EQ( stats.deallocations_, num_of_values );
+	EXPECT_GT( stats.central_returns_, 0 );
+}
+
+TEST_F( TestHeapCarrierPool, ExitedThreadBlocks_CanReuseInOtherThread_ThenRefillFromCentral )
+{
+	// Arrange
+	std::thread t( []() {
+		pooled_copyable_any sut( std::in_place_type<TestPoolHeapPayload>, 1 );
+	} );
+	t.join();
+
+	// Act
+	std::thread t2( []() {
+		pooled_copyable_any sut( std::in_place_type<TestPoolHeapPayload>, 2 );
+	} );
+	t2.join();
+
+	// Assert
+	auto stats = yan::get_heap_carrier_pool_stats();
+	EXPECT_EQ( stats.allocations_, 2 );
+	EXPECT_GE( stats.central_refills_, 1 );
+}
@@ -0,0 +1,151 @@
+/**
+ * @file test_memory_usage.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "constrained_any_memory_usage.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+namespace {
+
+struct test_blob_t {
+	std::vector<char> data_;
+};
+
+struct test_large_t {
+	char buff_[512];
+};
+
+}   // namespace
+
+template <>
+struct yan::memory_usage_traits<test_blob_t> {
+	static size_t heap_bytes( const test_blob_t& v ) noexcept
+	{
+		return v.data_.capacity();
+	}
+};
+
+TEST( TestMemoryUsage, Empty_ThenOnlyInlineBytes )
+{
+	// Arrange
+	yan::memory_accounted_any sut;
+
+	// Act
+	yan::memory_usage ret = sut.memory_usage();
+
+	// Assert
+	EXPECT_EQ( ret.inline_bytes_, sizeof( yan::memory_accounted_any ) );
+	EXPECT_EQ( ret.heap_carrier_bytes_, 0 );
+	EXPECT_EQ( ret.payload_heap_bytes_, 0 );
+	EXPECT_EQ( ret.total_bytes(), sizeof( yan::memory_accounted_any ) );
+}
+
+TEST( TestMemoryUsage, HeapCarrier_ThenSameToStorageTraits )
+{
+	// Arrange
+	using traits       = yan::storage_traits<yan::memory_accounted_any, test_large_t>;
+	using traits_small = yan::storage_traits<yan::memory_accounted_any, int64_t>;
+	yan::memory_accounted_any sut_small( int64_t { 1 } );
+	yan::memory_accounted_any sut_large( test_large_t {} );
+
+	// Act
+	yan::memory_usage ret_small = sut_small.memory_usage();
+	yan::memory_usage ret_large = sut_large.memory_usage();
+
+	// Assert
+	EXPECT_EQ( ret_small.heap_carrier_bytes_, traits_small::is_inline ? 0 : traits_small::carrier_size );
+	EXPECT_EQ( ret_small.payload_heap_bytes_, 0 );
+	EXPECT_EQ( ret_large.heap_carrier_bytes_, traits::carrier_size );
+	EXPECT_EQ( ret_large.payload_heap_bytes_, 0 );
+}
+
+TEST( TestMemoryUsage, String_ThenHeapBufferIsPayload )
+{
+	// Arrange
+	std::string               long_str( 1000, 'a' );
+	yan::memory_accounted_any sut_short( std::string( "a" ) );
+	yan::memory_accounted_any sut_long( long_str );
+
+	// Act
+	yan::memory_usage ret_short = sut_short.memory_usage();
+	yan::memory_usage ret_long  = sut_long.memory_usage();
+
+	// Assert
+	EXPECT_EQ( ret_short.payload_heap_bytes_, 0 );
+	EXPECT_EQ( ret_long.payload_heap_bytes_, yan::constrained_any_cast<const std::string&>( sut_long ).capacity() + 1 );
+}
+
+TEST( TestMemoryUsage, Containers_ThenCountElementsRecursively )
+{
+	// Arrange
+	std::vector<std::string> vec { std::string( 100, 'a' ), std::string( 200, 'b' ) };
+	vec.reserve( 4 );
+	std::map<int, std::string> map { { 1, std::string( 100, 'c' ) } };
+	std::list<int64_t>         lst { 1, 2, 3 };
+	std::array<std::string, 2> arr { std::string( 100, 'd' ), std::string() };
+
+	// Act
+	size_t ret_vec = yan::memory_usage_traits<std::vector<std::string>>::heap_bytes( vec );
+	size_t ret_map = yan::memory_usage_traits<std::map<int, std::string>>::heap_bytes( map );
+	size_t ret_lst = yan::memory_usage_traits<std::list<int64_t>>::heap_bytes( lst );
+	size_t ret_arr = yan::memory_usage_traits<std::array<std::string, 2>>::heap_bytes( arr );
+
+	// Assert
+	EXPECT_EQ( ret_vec, 4 * sizeof( std::string ) + ( vec[0].capacity() + 1 ) + ( vec[1].capacity() + 1 ) );
+	EXPECT_EQ( ret_map, sizeof( std::pair<const int, std::string> ) + 4 * sizeof( void* ) + ( map[1].capacity() + 1 ) );
+	EXPECT_EQ( ret_lst, 3 * ( sizeof( int64_t ) + 2 * sizeof( void* ) ) );
+	EXPECT_EQ( ret_arr, arr[0].capacity() + 1 );
+}
+
+TEST( TestMemoryUsage, CustomizationPoint_ThenUsed )
+{
+	// Arrange
+	yan::memory_accounted_any sut( test_blob_t { std::vector<char>( 300 ) } );
+
+	// Act
+	yan::memory_usage ret = sut.memory_usage();
+
+	// Assert
+	EXPECT_EQ( ret.payload_heap_bytes_, 300 );
+}
+
+TEST( TestMemoryUsage, Accumulator_ThenSumOfValues )
+{
+	// Arrange
+	std::vector<yan::memory_accounted_any>                   values { int64_t { 1 }, std::string( 500, 'x' ), test_large_t {} };
+	yan::memory_usage_accumulator<yan::memory_accounted_any> sut;
+
+	size_t expected = 0;
+	for ( const auto& v : values ) {
+		expected += v.memory_usage().total_bytes();
+	}
+
+	// Act
+	for ( const auto& v : values ) {
+		sut.add( v );
+	}
+	size_t total_after_add = sut.total_bytes();
+	sut.remove( values[1] );
+
+	// Assert
+	EXPECT_EQ( total_after_add, expected );
+	EXPECT_EQ( sut.total_bytes(), expected - values[1].memory_usage().total_bytes() );
+	EXPECT_EQ( sut.num_of_values(), 2 );
+}
@@ -0,0 +1,228 @@
+/**
+ * @file test_packed_any_vector.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "packed_any_vector.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+struct alignas( 16 ) TestPackedAligned {
+	int v_;
+};
+
+TEST( TestPackedAnyVector, Empty_ThenSizeIsZero )
+{
+	// Arrange
+	yan::packed_any_vector<yan::copyable_any> sut;
+
+	// Act
+
+	// Assert
+	EXPECT_TRUE( sut.empty() );
+	EXPECT_EQ( sut.size(), 0 );
+	EXPECT_THROW( sut.get( 0 ), std::out_of_range );
+}
+
+TEST( TestPackedAnyVector, MixedTypeValues_CanPushBack_ThenCanAccessByIndex )
+{
+	// Arrange
+	yan::packed_any_vector<yan::copyable_any> sut;
+
+	// Act
+	sut.push_back( 1 );
+	sut.push_back( std::string( "2" ) );
+	sut.push_back( 3.0 );
+	sut.emplace_back<TestPackedAligned>( TestPackedAligned { 4 } );
+	sut.push_back( 'c' );
+
+	// Assert
+	ASSERT_EQ( sut.size(), 5 );
+	EXPECT_EQ( sut.type( 0 ), typeid( int ) );
+	EXPECT_EQ( *sut.get_if<int>( 0 ), 1 );
+	EXPECT_EQ( *sut.get_if<std::string>( 1 ), std::string( "2" ) );
+	EXPECT_EQ( *sut.get_if<double>( 2 ), 3.0 );
+	ASSERT_NE( sut.get_if<TestPackedAligned>( 3 ), nullptr );
+	EXPECT_EQ( reinterpret_cast<uintptr_t>( sut.get_if<TestPackedAligned>( 3 ) ) % alignof( TestPackedAligned ), 0 );
+	EXPECT_EQ( sut.get_if<TestPackedAligned>( 3 )->v_, 4 );
+	EXPECT_EQ( *sut.get_if<char>( 4 ), 'c' );
+	EXPECT_EQ( sut.get_if<double>( 0 ), nullptr );
+}
+
+TEST( TestPackedAnyVector, ManyValues_ThenValuesAreKeptOverGrowth )
+{
+	// Arrange
+	yan::packed_any_vector<yan::copyable_any> sut;
+
+	// Act
+	for ( int i = 0; i < 1000; i++ ) {
+		if ( ( i % 2 ) == 0 ) {
+			sut.push_back( i );
+		} else {
+			sut.push_back( std::to_string( i ) + " string value over SSO of std::string" );
+		}
+	}
+
+	// Assert
+	ASSERT_EQ( sut.size(), 1000 );
+	EXPECT_EQ( *sut.get_if<int>( 998 ), 998 );
+	EXPECT_EQ( *sut.get_if<std::string>( 999 ), std::string( "999 string value over SSO of std::string" ) );
+}
+
+TEST( TestPackedAnyVector, PushBackOfOwnElement_ThenValueIsCopiedOverGrowth )
+{
+	// Arrange
+	yan::packed_any_vector<yan::copyable_any> sut;
+	sut.push_back( std::string( 100, 'a' ) );
+
+	// Act
+	// the argument refers to the element in the buffer that is released by the growth
+	for ( int i = 0; i < 100; i++ ) {
+		sut.push_back( *sut.get_if<std::string>( 0 ) );
+	}
+
+	// Assert
+	ASSERT_EQ( sut.size(), 101 );
+	for ( size_t i = 0; i < sut.size(); i++ ) {
+		EXPECT_EQ( *sut.get_if<std::string>( i ), std::string( 100, 'a' ) ) << "index " << i;
+	}
+}
+
+TEST( TestPackedAnyVector, Element_CanGetAsAlias )
+{
+	// Arrange
+	yan::packed_any_vector<yan::keyable_any> sut;
+	sut.push_back( 1 );
+	sut.push_back( std::string( "2" ) );
+
+	// Act
+	yan::keyable_any   a      = sut.get( 0 );
+	yan::keyable_any   b      = sut[1];
+	const std::string* p_view = sut[1].get_if<std::string>();
+
+	// Assert
+	EXPECT_EQ( a, yan::keyable_any( 1 ) );
+	EXPECT_EQ( b, yan::keyable_any( std::string( "2" ) ) );
+	ASSERT_NE( p_view, nullptr );
+	EXPECT_EQ( *p_view, std::string( "2" ) );
+	EXPECT_EQ( sut[0].type(), typeid( int ) );
+}
+
+TEST( TestPackedAnyVector, Visit_ThenCallForTheElementsOfListedTypes )
+{
+	// Arrange
+	yan::packed_any_vector<yan::copyable_any> sut;
+	sut.push_back( 1 );
+	sut.push_back( std::string( "2" ) );
+	sut.push_back( 3 );
+	sut.push_back( 4.0 );
+
+	// Act
+	int         sum_int = 0;
+	std::string str;
+	sut.visit<int, std::string>( [&sum_int, &str]( const auto& v ) {
+		if constexpr ( std::is_same<std::decay_t<decltype( v )>, int>::value ) {
+			sum_int += v;
+		} else {
+			str += v;
+		}
+	} );
+	size_t num_of_elements = 0;
+	sut.for_each( [&num_of_elements]( yan::packed_any_vector<yan::copyable_any>::const_reference ) { num_of_elements++; } );
+
+	// Assert
+	EXPECT_EQ( sum_int, 4 );
+	EXPECT_EQ( str, std::string( "2" ) );
+	EXPECT_EQ( num_of_elements, 4 );
+}
+
+TEST( TestPackedAnyVector, KeyableAny_ThenLessEqualToAndHashValueAreSameToAlias )
+{
+	// Arrange
+	yan::packed_any_vector<yan::keyable_any> sut;
+	sut.push_back( 1 );
+	sut.push_back( 2 );
+	sut.push_back( std::string( "1" ) );
+	sut.push_back( 1 );
+
+	// Act
+	// Assert
+	for ( size_t i = 0; i < sut.size(); i++ ) {
+		for ( size_t j = 0; j < sut.size(); j++ ) {
+			EXPECT_EQ( sut.less( i, j ), sut.get( i ) < sut.get( j ) );
+			EXPECT_EQ( sut.equal_to( i, j ), sut.get( i ) == sut.get( j ) );
+		}
+		EXPECT_EQ( sut.hash_value( i ), sut.get( i ).hash_value() );
+	}
+	EXPECT_TRUE( sut.less( 0, 1 ) );
+	EXPECT_TRUE( sut.equal_to( 0, 3 ) );
+}
+
+TEST( TestPackedAnyVector, CanCopyMoveAndPopBack )
+{
+	// Arrange
+	yan::packed_any_vector<yan::copyable_any> sut;
+	sut.push_back( 1 );
+	sut.push_back( std::string( "2" ) );
+
+	// Act
+	yan::packed_any_vector<yan::copyable_any> sut_copy( sut );
+	yan::packed_any_vector<yan::copyable_any> sut_move( std::move( sut ) );
+	sut_copy.pop_back();
+	sut_copy.push_back( 3.0 );
+
+	// Assert
+	EXPECT_TRUE( sut.empty() );
+	ASSERT_EQ( sut_move.size(), 2 );
+	EXPECT_EQ( *sut_move.get_if<std::string>( 1 ), std::string( "2" ) );
+	ASSERT_EQ( sut_copy.size(), 2 );
+	EXPECT_EQ( *sut_copy.get_if<double>( 1 ), 3.0 );
+}
+
+TEST( TestPackedAnyVector, MoveOnlyAny_CanHoldMoveOnlyValue_ThenCopyThrows )
+{
+	// Arrange
+	yan::packed_any_vector<yan::move_only_any> sut;
+
+	// Act
+	sut.push_back( std::make_unique<int>( 1 ) );
+	for ( int i = 0; i < 100; i++ ) {
+		sut.push_back( std::make_unique<int>( i ) );
+	}
+
+	// Assert
+	EXPECT_EQ( **sut.get_if<std::unique_ptr<int>>( 0 ), 1 );
+	EXPECT_EQ( **sut.get_if<std::unique_ptr<int>>( 100 ), 99 );
+	EXPECT_THROW( yan::packed_any_vector<yan::move_only_any> { sut }, std::logic_error );
+	EXPECT_THROW( sut.get( 0 ), std::logic_error );
+}
+
+TEST( TestPackedAnyVector, SmallScalars_ThenMemoryIsSmallerThanVectorOfAlias )
+{
+	// Arrange
+	constexpr size_t                          n = 1000;
+	yan::packed_any_vector<yan::copyable_any> sut;
+	sut.reserve( n );
+
+	// Act
+	for ( size_t i = 0; i < n; i++ ) {
+		sut.push_back( static_cast<int>( i ) );
+	}
+
+	// Assert
+	// header(8 bytes) + int(4 bytes) with padding and index(8 bytes)
+	EXPECT_LE( sut.memory_bytes(), n * 24 );
+}
@@ -0,0 +1,264 @@
+/**
+ * @file test_serialize.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include "constrained_any_serialize.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+using TestOtherSerializableAny = yan::constrained_any<yan::impl::special_operation_copyable, yan::impl::special_operation_serialize>;
+
+class TestSerialize : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		auto& registry = yan::serialize_registry<yan::serializable_keyable_any>::get_instance();
+		registry.register_type<int64_t>( 1 );
+		registry.register_type<double>( 2 );
+		registry.register_type<std::string>( 3 );
+		registry.register_type<std::string_view>( 4 );
+	}
+
+	template <typename T>
+	yan::serializable_keyable_any round_trip( const T& v )
+	{
+		yan::serializable_keyable_any src( v );
+		std::vector<unsigned char>    buff( src.serialized_size() );
+		EXPECT_EQ( src.serialize( buff.data(), buff.size() ), buff.size() );
+
+		yan::serializable_keyable_any ans;
+		EXPECT_EQ( yan::deserialize( buff.data(), buff.size(), ans ), buff.size() );
+		return ans;
+	}
+};
+
+TEST_F( TestSerialize, Values_CanRoundTrip )
+{
+	// Arrange
+
+	// Act
+	yan::serializable_keyable_any a = round_trip( int64_t { -1234567890123 } );
+	yan::serializable_keyable_any b = round_trip( 3.5 );
+	yan::serializable_keyable_any c = round_trip( std::string( "string value over SSO of std::string" ) );
+	yan::serializable_keyable_any d = round_trip( std::string() );
+
+	// Assert
+	EXPECT_EQ( a, yan::serializable_keyable_any( int64_t { -1234567890123 } ) );
+	EXPECT_EQ( b, yan::serializable_keyable_any( 3.5 ) );
+	EXPECT_EQ( c, yan::serializable_keyable_any( std::string( "string value over SSO of std::string" ) ) );
+	EXPECT_EQ( d, yan::serializable_keyable_any( std::string() ) );
+}
+
+TEST_F( TestSerialize, Empty_CanRoundTrip )
+{
+	// Arrange
+	yan::serializable_keyable_any src;
+	unsigned char                 buff[2];
+
+	// Act
+	size_t                        written = src.serialize( buff, sizeof( buff ) );
+	yan::serializable_keyable_any sut( 1.0 );
+	size_t                        consumed = yan::deserialize( buff, sizeof( buff ), sut );
+
+	// Assert
+	EXPECT_EQ( src.serialized_size(), 2 );
+	EXPECT_EQ( written, 2 );
+	EXPECT_EQ( consumed, 2 );
+	EXPECT_FALSE( sut.has_value() );
+}
+
+TEST_F( TestSerialize, Int64_ThenEncodedFormIsCompact )
+{
+	// Arrange
+	yan::serializable_keyable_any sut( int64_t { 1 } );
+	unsigned char                 buff[16];
+
+	// Act
+	size_t written = sut.serialize( buff, sizeof( buff ) );
+
+	// Assert
+	ASSERT_EQ( written, 1 + 1 + sizeof( int64_t ) );
+	EXPECT_EQ( buff[0], 1 );   // type id
+	EXPECT_EQ( buff[1], 8 );   // payload size
+	EXPECT_EQ( buff[2], 1 );   // little endian
+	EXPECT_EQ( buff[9], 0 );
+}
+
+TEST_F( TestSerialize, String_CanDeserializeView_ThenRefersInputBuffer )
+{
+	// Arrange
+	yan::serializable_keyable_any src( std::string( "abc" ) );
+	std::vector<unsigned char>    buff( src.serialized_size() );
+	src.serialize( buff.data(), buff.size() );
+	yan::serializable_keyable_any sut;
+
+	// Act
+	size_t consumed = yan::deserialize_view( buff.data(), buff.size(), sut );
+
+	// Assert
+	EXPECT_EQ( consumed, buff.size() );
+	ASSERT_EQ( sut.type(), typeid( std::string_view ) );
+	std::string_view sv = yan::constrained_any_cast<std::string_view>( sut );
+	EXPECT_EQ( sv, std::string_view( "abc" ) );
+	EXPECT_EQ( reinterpret_cast<const unsigned char*>( sv.data() ), buff.data() + 2 );
+}
+
+TEST_F( TestSerialize, SequenceOfKeys_CanDecodeConsecutively )
+{
+	// Arrange
+	std::vector<yan::serializable_keyable_any> src { int64_t { 1 }, std::string( "2" ), 3.0, yan::serializable_keyable_any() };
+	std::vector<unsigned char>                 buff;
+	for ( const auto& v : src ) {
+		size_t pos = buff.size();
+		buff.resize( pos + v.serialized_size() );
+		v.serialize( buff.data() + pos, buff.size() - pos );
+	}
+
+	// Act
+	std::vector<yan::serializable_keyable_any> sut;
+	size_t                                     pos = 0;
+	while ( pos < buff.size() ) {
+		sut.emplace_back();
+		pos += yan::deserialize( buff.data() + pos, buff.size() - pos, sut.back() );
+	}
+
+	// Assert
+	ASSERT_EQ( sut.size(), src.size() );
+	for ( size_t i = 0; i < src.size(); i++ ) {
+		EXPECT_EQ( sut[i], src[i] );
+	}
+}
+
+TEST_F( TestSerialize, SmallBufferOrUnregisteredType_ThenThrow )
+{
+	// Arrange
+	yan::serializable_keyable_any sut_a( int64_t { 1 } );
+	yan::serializable_keyable_any sut_b( 1.0F );
+	unsigned char                 buff[16];
+
+	// Act
+	// Assert
+	EXPECT_THROW( sut_a.serialize( buff, 4 ), std::length_error );
+	EXPECT_THROW( sut_b.serialize( buff, sizeof( buff ) ), std::logic_error );
+	EXPECT_THROW( sut_b.serialized_size(), std::logic_error );
+}
+
+TEST_F( TestSerialize, MalformedInput_ThenThrowInvalidArgument )
+{
+	// Arrange
+	const unsigned char truncated[]  = { 1, 8, 0, 0 };
+	const unsigned char unknown_id[] = { 100, 0 };
+	const unsigned char wrong_size[] = { 1, 1, 0 };
+	const unsigned char no_size[]    = { 0x81 };
+	const unsigned char over_64bit[] = { 0x81, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02, 8, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+	yan::serializable_keyable_any sut;
+
+	// Act
+	// Assert
+	EXPECT_THROW( yan::deserialize( truncated, sizeof( truncated ), sut ), std::invalid_argument );
+	EXPECT_THROW( yan::deserialize( unknown_id, sizeof( unknown_id ), sut ), std::invalid_argument );
+	EXPECT_THROW( yan::deserialize( wrong_size, sizeof( wrong_size ), sut ), std::invalid_argument );
+	EXPECT_THROW( yan::deserialize( no_size, sizeof( no_size ), sut ), std::invalid_argument );
+	EXPECT_THROW( yan::deserialize( over_64bit, sizeof( over_64bit ), sut ), std::invalid_argument );
+}
+
+TEST_F( TestSerialize, Bool_CanRoundTrip_ThenOtherByteThanZeroOrOneIsMalformed )
+{
+	// Arrange
+	yan::serialize_registry<yan::serializable_keyable_any>::get_instance().register_type<bool>( 9 );
+	const unsigned char invalid_bool[] = { 9, 1, 2 };
+
+	// Act
+	yan::serializable_keyable_any a = round_trip( true );
+	yan::serializable_keyable_any b = round_trip( false );
+	yan::serializable_keyable_any sut;
+
+	// Assert
+	EXPECT_EQ( yan::constrained_any_cast<bool>( a ), true );
+	EXPECT_EQ( yan::constrained_any_cast<bool>( b ), false );
+	EXPECT_THROW( yan::deserialize( invalid_bool, sizeof( invalid_bool ), sut ), std::invalid_argument );
+}
+
+TEST_F( TestSerialize, ConflictRegistration_ThenThrowLogicError )
+{
+	// Arrange
+	auto& registry = yan::serialize_registry<yan::serializable_keyable_any>::get_instance();
+
+	// Act
+	// Assert
+	EXPECT_NO_THROW( registry.register_type<int64_t>( 1 ) );
+	EXPECT_THROW( registry.register_type<int64_t>( 5 ), std::logic_error );
+	EXPECT_THROW( registry.register_type<int32_t>( 1 ), std::logic_error );
+	EXPECT_THROW( registry.register_type<int32_t>( 0 ), std::logic_error );
+}
+
+TEST_F( TestSerialize, OtherAlias_CanRegisterSameTypeWithOtherId_ThenEachAliasUsesItsId )
+{
+	// Arrange
+	yan::serialize_registry<TestOtherSerializableAny>::get_instance().register_type<int64_t>( 7 );
+	yan::serializable_keyable_any src_a( int64_t { 5 } );
+	TestOtherSerializableAny      src_b( int64_t { 5 } );
+	unsigned char                 buff_a[16];
+	unsigned char                 buff_b[16];
+
+	// Act
+	src_a.serialize( buff_a, sizeof( buff_a ) );
+	size_t                   written = src_b.serialize( buff_b, sizeof( buff_b ) );
+	TestOtherSerializableAny sut;
+	yan::deserialize( buff_b, written, sut );
+
+	// Assert
+	EXPECT_EQ( buff_a[0], 1 );
+	EXPECT_EQ( buff_b[0], 7 );
+	EXPECT_EQ( yan::constrained_any_cast<int64_t>( sut ), 5 );
+}
+
+TEST_F( TestSerialize, TypeOfTypeRegistry_CanRegisterWithStableTypeId_ThenRoundTrip )
+{
+	// Arrange
+	uint64_t id = yan::type_registry::get_instance().register_type<uint16_t>( "test.serialize.uint16" );
+	yan::serialize_registry<TestOtherSerializableAny>::get_instance().register_type<uint16_t>();
+	TestOtherSerializableAny   src( uint16_t { 42 } );
+	std::vector<unsigned char> buff( src.serialized_size() );
+
+	// Act
+	src.serialize( buff.data(), buff.size() );
+	TestOtherSerializableAny sut;
+	yan::deserialize( buff.data(), buff.size(), sut );
+
+	// Assert
+	EXPECT_EQ( yan::serialize_registry<TestOtherSerializableAny>::get_instance().find_type( id ), &typeid( uint16_t ) );
+	EXPECT_EQ( yan::constrained_any_cast<uint16_t>( sut ), 42 );
+	EXPECT_EQ( sut.stable_type_id(), id );
+	EXPECT_THROW( yan::serialize_registry<TestOtherSerializableAny>::get_instance().register_type<uint8_t>(), std::logic_error );
+}
+
+TEST( TestSerializeTraits, ArithmeticTypeOfUnsupportedSize_ThenNotAcceptable )
+{
+	// Arrange
+
+	// Act
+	bool is_acceptable = std::is_constructible<yan::serializable_keyable_any, long double>::value;
+
+	// Assert
+	EXPECT_EQ( is_acceptable, sizeof( long double ) == 8 );
+	EXPECT_TRUE( ( std::is_constructible<yan::serializable_keyable_any, double>::value ) );
+}
@@ -0,0 +1,131 @@
+/**
+ * @file test_sort_key.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "constrained_any_sort_key.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+class TestSortKey : public ::testing::Test {
+protected:
+	void SetUp() override
+	{
+		auto& registry = yan::sort_key_type_registry::get_instance();
+		registry.register_type<int32_t>();
+		registry.register_type<int64_t>();
+		registry.register_type<uint64_t>();
+		registry.register_type<double>();
+		registry.register_type<std::string>();
+	}
+
+	static bool key_less( const yan::sortable_any& a, const yan::sortable_any& b )
+	{
+		return a.sort_key() < b.sort_key();
+	}
+};
+
+TEST_F( TestSortKey, SameType_ThenAgreeWithLess )
+{
+	// Arrange
+	std::vector<yan::sortable_any> values {
+		int64_t { std::numeric_limits<int64_t>::min() }, int64_t { -1 }, int64_t { 0 }, int64_t { 1 }, int64_t { std::numeric_limits<int64_t>::max() },
+		uint64_t { 0 }, uint64_t { 1 }, uint64_t { std::numeric_limits<uint64_t>::max() },
+		-std::numeric_limits<double>::infinity(), -1.5, -0.0, 0.0, 1e-300, 2.5, std::numeric_limits<double>::infinity(),
+		std::string(), std::string( "a" ), std::string( "a\0", 2 ), std::string( "ab" ), std::string( "b" ), std::string( "\xff" ) };
+
+	// Act
+	// Assert
+	for ( const auto& a : values ) {
+		for ( const auto& b : values ) {
+			EXPECT_EQ( key_less( a, b ), a < b );
+		}
+	}
+}
+
+TEST_F( TestSortKey, MixedTypes_ThenSortedOrderIsSameToLess )
+{
+	// Arrange
+	std::mt19937_64                rng( 1 );
+	std::vector<yan::sortable_any> values;
+	for ( int i = 0; i < 2000; i++ ) {
+		switch ( rng() % 5 ) {
+			case 0: values.emplace_back( static_cast<int32_t>( rng() % 200 ) - 100 ); break;
+			case 1: values.emplace_back( static_cast<int64_t>( rng() ) ); break;
+			case 2: values.emplace_back( static_cast<double>( static_cast<int64_t>( rng() % 2000 ) - 1000 ) / 7.0 ); break;
+			case 3: values.emplace_back( std::to_string( rng() % 1000 ) ); break;
+			default: values.emplace_back(); break;
+		}
+	}
+	std::vector<yan::sortable_any> expected = values;
+	std::stable_sort( expected.begin(), expected.end() );
+
+	// Act
+	std::stable_sort( values.begin(), values.end(), key_less );
+
+	// Assert
+	ASSERT_EQ( values.size(), expected.size() );
+	for ( size_t i = 0; i < values.size(); i++ ) {
+		EXPECT_EQ( values[i].type(), expected[i].type() );
+		EXPECT_FALSE( values[i] < expected[i] );
+		EXPECT_FALSE( expected[i] < values[i] );
+	}
+}
+
+TEST_F( TestSortKey, Int64_ThenEncodedFormIsBigEndianWithFlippedSignBit )
+{
+	// Arrange
+	yan::sortable_any sut( int64_t { 1 } );
+	unsigned char     buff[16];
+
+	// Act
+	size_t written = sut.write_sort_key( buff, sizeof( buff ) );
+
+	// Assert
+	ASSERT_EQ( written, 4 + sizeof( int64_t ) );
+	EXPECT_EQ( sut.sort_key_size(), written );
+	EXPECT_EQ( buff[4], 0x80 );
+	EXPECT_EQ( buff[11], 0x01 );
+}
+
+TEST_F( TestSortKey, String_ThenZeroIsEscaped )
+{
+	// Arrange
+	yan::sortable_any sut( std::string( "a\0b", 3 ) );
+
+	// Act
+	std::string key = sut.sort_key();
+
+	// Assert
+	EXPECT_EQ( key.substr( 4 ), std::string( "a\0\xff" "b\0\0", 6 ) );
+}
+
+TEST_F( TestSortKey, SmallBufferOrUnregisteredType_ThenThrow )
+{
+	// Arrange
+	yan::sortable_any sut_a( int64_t { 1 } );
+	yan::sortable_any sut_b( int16_t { 1 } );
+	unsigned char     buff[16];
+
+	// Act
+	// Assert
+	EXPECT_THROW( sut_a.write_sort_key( buff, 8 ), std::length_error );
+	EXPECT_THROW( sut_b.write_sort_key( buff, sizeof( buff ) ), std::logic_error );
+}
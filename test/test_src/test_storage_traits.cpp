@@ -0,0 +1,265 @@
+/**
+ * @file test_storage_traits.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "constrained_any.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+struct TestTraitsOverSSOSize {
+	std::array<unsigned char, yan::impl::sso_buff_size> v_buff;
+};
+
+struct alignas( 2 * yan::impl::sso_buff_alignment ) TestTraitsOverAligned {
+	int v_;
+};
+
+struct alignas( yan::impl::sso_buff_alignment ) TestTraitsMaxAligned {
+	int v_;
+
+	TestTraitsMaxAligned( int v )
+	  : v_( v )
+	{
+	}
+};
+
+struct TestTraitsThrowingMove {
+	int v_;
+
+	TestTraitsThrowingMove()
+	  : v_( 0 )
+	{
+	}
+	TestTraitsThrowingMove( const TestTraitsThrowingMove& ) = default;
+	TestTraitsThrowingMove( TestTraitsThrowingMove&& src ) noexcept( false )
+	  : v_( src.v_ )
+	{
+	}
+	TestTraitsThrowingMove& operator=( const TestTraitsThrowingMove& ) = default;
+};
+
+struct TestTraitsHasKey {
+	int key_;
+
+	int get_key( void ) const
+	{
+		return key_;
+	}
+};
+
+struct special_operation_get_key_if {
+	virtual ~special_operation_get_key_if() = default;
+
+	virtual int specialized_operation_get_key_proxy( const yan::impl::value_carrier_if_common& a ) const = 0;
+};
+
+template <typename Carrier>
+class special_operation_get_key_dispatcher : public special_operation_get_key_if {
+private:
+	int specialized_operation_get_key_proxy( const yan::impl::value_carrier_if_common& a ) const override
+	{
+		if constexpr ( yan::is_value_carrier_of_constrained_any<Carrier>::value ) {
+			return static_cast<const Carrier&>( a ).ref().get_key();
+		} else {
+			return -1;
+		}
+	}
+};
+
+// shared special operation defined by user
+template <typename Carrier>
+class special_operation_get_key : public yan::special_operation_dispatcher_base_t<Carrier, special_operation_get_key_dispatcher<Carrier>> {
+public:
+	static constexpr bool share_special_operation    = true;
+	static constexpr bool require_copy_constructible = true;
+
+	template <typename U = Carrier, typename std::enable_if<yan::is_specialized_of_constrained_any<U>::value>::type* = nullptr>
+	int get_key( void ) const
+	{
+		const Carrier* p = static_cast<const Carrier*>( this );
+
+		const special_operation_get_key_if* p_soi = p->template get_special_operation_if<special_operation_get_key_if>();
+		if ( p_soi == nullptr ) {
+			return -1;
+		}
+		return p_soi->specialized_operation_get_key_proxy( p->get_value_carrier() );
+	}
+};
+
+// ================================================
+
+TEST( TestStorageTraits, Int_ThenOverheadIsCarrierSizeMinusValueSize )
+{
+	using sut_t = yan::storage_traits<yan::copyable_any, int>;
+
+	EXPECT_EQ( sut_t::value_size, sizeof( int ) );
+	EXPECT_EQ( sut_t::carrier_size, sizeof( sut_t::carrier_type ) );
+	EXPECT_EQ( sut_t::overhead_bytes, sut_t::carrier_size - sizeof( int ) );
+	EXPECT_GE( sut_t::overhead_bytes, sizeof( void* ) );
+}
+
+TEST( TestStorageTraits, KeyableAny_ThenOverheadIsNotSmallerThanCopyableAny )
+{
+	using copyable_t = yan::storage_traits<yan::copyable_any, int64_t>;
+	using keyable_t  = yan::storage_traits<yan::keyable_any, int64_t>;
+
+	EXPECT_GE( keyable_t::overhead_bytes, copyable_t::overhead_bytes );
+}
+
+TEST( TestStorageTraits, KeyableAny_ThenCarrierHasOnlyOneVptr )
+{
+	using copyable_t      = yan::storage_traits<yan::copyable_any, int64_t>;
+	using weak_ordering_t = yan::storage_traits<yan::weak_ordering_any, int64_t>;
+	using unordered_key_t = yan::storage_traits<yan::unordered_key_any, int64_t>;
+	using keyable_t       = yan::storage_traits<yan::keyable_any, int64_t>;
+
+	EXPECT_EQ( copyable_t::overhead_bytes, sizeof( void* ) );
+	EXPECT_EQ( weak_ordering_t::overhead_bytes, copyable_t::overhead_bytes );
+	EXPECT_EQ( unordered_key_t::overhead_bytes, copyable_t::overhead_bytes );
+	EXPECT_EQ( keyable_t::overhead_bytes, copyable_t::overhead_bytes );
+}
+
+TEST( TestStorageTraits, SharedSpecialOperation_ThenCarrierHasOnlyOneVptr )
+{
+	using get_key_any = yan::constrained_any<yan::impl::special_operation_copyable, special_operation_get_key>;
+
+	EXPECT_EQ( ( yan::storage_traits<get_key_any, TestTraitsHasKey>::carrier_size ), ( yan::storage_traits<yan::copyable_any, TestTraitsHasKey>::carrier_size ) );
+	EXPECT_EQ( sizeof( get_key_any ), sizeof( yan::copyable_any ) );
+}
+
+TEST( TestStorageTraits, KeyableAny_ThenSizeIsSameToCopyableAny )
+{
+	EXPECT_EQ( sizeof( yan::keyable_any ), sizeof( yan::copyable_any ) );
+}
+
+TEST( TestStorageTraits, SharedSpecialOperation_CanCall )
+{
+	// Arrange
+	using sut_t = yan::constrained_any<special_operation_get_key>;
+	sut_t sut_a( TestTraitsHasKey { 3 } );
+	sut_t sut_b( TestTraitsHasKey { 5 } );
+	sut_t sut_empty;
+
+	// Act
+	int key_a     = sut_a.get_key();
+	int key_b     = sut_b.get_key();
+	int key_empty = sut_empty.get_key();
+
+	// Assert
+	EXPECT_EQ( key_a, 3 );
+	EXPECT_EQ( key_b, 5 );
+	EXPECT_EQ( key_empty, -1 );
+}
+
+#if __cpp_concepts >= 201907L
+
+TEST( TestStorageTraits, Int_ThenInline )
+{
+	using sut_t = yan::storage_traits<yan::keyable_any, int>;
+
+	EXPECT_TRUE( sut_t::is_inline );
+	EXPECT_EQ( sut_t::spill_reason, yan::storage_spill_reason::none );
+	EXPECT_EQ( sut_t::inline_buffer_size, yan::impl::sso_buff_size );
+	static_assert( yan::require_inline<yan::keyable_any, int>::value );
+	static_assert( yan::require_inline_v<yan::move_only_any, std::string> );
+}
+
+TEST( TestStorageTraits, WeakOrderingAny_ThenInlineCapacityIsSameToCopyableAny )
+{
+	using payload_t = std::array<int64_t, ( yan::impl::sso_buff_size - 2 * sizeof( void* ) ) / sizeof( int64_t )>;
+
+	EXPECT_TRUE( ( yan::storage_traits<yan::copyable_any, payload_t>::is_inline ) );
+	EXPECT_TRUE( ( yan::storage_traits<yan::weak_ordering_any, payload_t>::is_inline ) );
+}
+
+TEST( TestStorageTraits, Sizeof_ThenInlineBufferAndOneCarrierPointer )
+{
+	EXPECT_EQ( sizeof( yan::copyable_any ), yan::impl::sso_buff_size + sizeof( void* ) );
+	EXPECT_EQ( sizeof( yan::keyable_any ), yan::impl::sso_buff_size + sizeof( void* ) );
+}
+
+TEST( TestStorageTraits, OverSSOSize_ThenSpillBySize )
+{
+	using sut_t = yan::storage_traits<yan::copyable_any, TestTraitsOverSSOSize>;
+
+	EXPECT_FALSE( sut_t::is_inline );
+	EXPECT_TRUE( sut_t::spills_by_size );
+	EXPECT_EQ( sut_t::spill_reason, yan::storage_spill_reason::size );
+}
+
+TEST( TestStorageTraits, OverAligned_ThenSpillByAlignment )
+{
+	using sut_t = yan::storage_traits<yan::copyable_any, TestTraitsOverAligned>;
+
+	EXPECT_FALSE( sut_t::is_inline );
+	EXPECT_FALSE( sut_t::spills_by_size );
+	EXPECT_TRUE( sut_t::spills_by_alignment );
+	EXPECT_EQ( sut_t::spill_reason, yan::storage_spill_reason::alignment );
+}
+
+TEST( TestStorageTraits, ThrowingMove_ThenSpillByNonNoexceptMove )
+{
+	using sut_t = yan::storage_traits<yan::copyable_any, TestTraitsThrowingMove>;
+
+	EXPECT_FALSE( sut_t::is_inline );
+	EXPECT_TRUE( sut_t::spills_by_non_noexcept_move );
+	EXPECT_EQ( sut_t::spill_reason, yan::storage_spill_reason::non_noexcept_move );
+}
+
+#else
+
+TEST( TestStorageTraits, Int_ThenNoInlineBuffer )
+{
+	using sut_t = yan::storage_traits<yan::keyable_any, int>;
+
+	EXPECT_FALSE( sut_t::is_inline );
+	EXPECT_EQ( sut_t::spill_reason, yan::storage_spill_reason::no_inline_buffer );
+	EXPECT_EQ( sut_t::inline_buffer_size, 0 );
+}
+
+#endif
+
+TEST( TestStorageTraits, MaxAlignedValue_CanStore_ThenAddressIsAligned )
+{
+	// Arrange
+	yan::copyable_any sut_a( std::in_place_type<TestTraitsMaxAligned>, 1 );
+	yan::copyable_any sut_c( sut_a );
+
+	// Act
+	const TestTraitsMaxAligned* p_a = yan::constrained_any_cast<TestTraitsMaxAligned>( &sut_a );
+	const TestTraitsMaxAligned* p_c = yan::constrained_any_cast<TestTraitsMaxAligned>( &sut_c );
+
+	// Assert
+	ASSERT_NE( p_a, nullptr );
+	ASSERT_NE( p_c, nullptr );
+	EXPECT_EQ( reinterpret_cast<uintptr_t>( p_a ) % alignof( TestTraitsMaxAligned ), 0 );
+	EXPECT_EQ( reinterpret_cast<uintptr_t>( p_c ) % alignof( TestTraitsMaxAligned ), 0 );
+	EXPECT_EQ( p_c->v_, 1 );
+}
+
+TEST( TestStorageTraits, OverAlignedValue_CanStore_ThenAddressIsAligned )
+{
+	// Arrange
+	yan::copyable_any sut( TestTraitsOverAligned { 3 } );
+
+	// Act
+	const TestTraitsOverAligned* p = yan::constrained_any_cast<TestTraitsOverAligned>( &sut );
+
+	// Assert
+	ASSERT_NE( p, nullptr );
+	EXPECT_EQ( reinterpret_cast<uintptr_t>( p ) % alignof( TestTraitsOverAligned ), 0 );
+	EXPECT_EQ( p->v_, 3 );
+}
@@ -0,0 +1,149 @@
+/**
+ * @file test_type_registry.cpp
+ * @author Teruaki Ata (PFA03027@nifty.com)
+ * @brief
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2025, Teruaki Ata (PFA03027@nifty.com)
+ *
+ */
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+
+#include "constrained_any.hpp"
+
+#include <gtest/gtest.h>
+
+// ================================================
+
+namespace {
+
+struct test_registered_t {
+	int a_;
+};
+struct test_not_registered_t {
+	int a_;
+};
+struct test_large_registered_t {
+	char buff_[256];
+};
+struct test_named_registered_t {
+	int a_;
+};
+
+}   // namespace
+
+TEST( TestTypeRegistry, Fnv1a_ThenSameToKnownValue )
+{
+	// Arrange
+
+	// Act
+	constexpr uint32_t h32 = yan::fnv1a_32( "a" );
+	constexpr uint64_t h64 = yan::fnv1a_64( "a" );
+
+	// Assert
+	EXPECT_EQ( h32, 0xE40C292CU );
+	EXPECT_EQ( h64, 0xAF63DC4C8601EC8CULL );
+	EXPECT_EQ( yan::fnv1a_64( "" ), 14695981039346656037ULL );
+}
+
+TEST( TestTypeRegistry, StableTypeName_ThenNameOfType )
+{
+	// Arrange
+
+	// Act
+	constexpr std::string_view name_int    = yan::stable_type_name<int>();
+	constexpr std::string_view name_double = yan::stable_type_name<double>();
+	constexpr uint64_t         hash_int    = yan::stable_type_hash<int>();
+
+	// Assert
+	EXPECT_EQ( name_int, "int" );
+	EXPECT_EQ( name_double, "double" );
+	EXPECT_EQ( hash_int, yan::fnv1a_64( "int" ) );
+}
+
+using TestArrayOfArray3 = std::array<int[2], 3>;
+using TestArrayOfArray4 = std::array<int[2], 4>;
+
+TEST( TestTypeRegistry, StableTypeNameOfArrayTemplateArgument_ThenWholeNameIsUsed )
+{
+	// Arrange
+	auto& sut = yan::type_registry::get_instance();
+
+	// Act
+	constexpr std::string_view name_a = yan::stable_type_name<TestArrayOfArray3>();
+	constexpr std::string_view name_b = yan::stable_type_name<TestArrayOfArray4>();
+	sut.register_type<TestArrayOfArray3>();
+
+	// Assert
+	EXPECT_NE( name_a, name_b );
+	EXPECT_EQ( name_a.back(), '>' );
+	EXPECT_NE( yan::stable_type_hash<TestArrayOfArray3>(), yan::stable_type_hash<TestArrayOfArray4>() );
+	EXPECT_NO_THROW( sut.register_type<TestArrayOfArray4>() );
+}
+
+TEST( TestTypeRegistry, Register_ThenCanLookupBothWays )
+{
+	// Arrange
+	auto& sut = yan::type_registry::get_instance();
+
+	// Act
+	uint64_t id_a = sut.register_type<test_registered_t>( 0x1234 );
+	uint64_t id_b = sut.register_type<test_named_registered_t>( "test_named_registered_t" );
+	uint64_t id_c = sut.register_type<float>();
+
+	// Assert
+	EXPECT_EQ( id_a, 0x1234 );
+	EXPECT_EQ( id_b, yan::fnv1a_64( "test_named_registered_t" ) );
+	EXPECT_EQ( id_c, yan::stable_type_hash<float>() );
+	EXPECT_EQ( yan::type_registry::id_of<test_registered_t>(), id_a );
+	EXPECT_EQ( yan::type_registry::id_of<test_named_registered_t>(), id_b );
+	EXPECT_EQ( yan::type_registry::id_of<test_not_registered_t>(), 0 );
+	ASSERT_NE( sut.find_type( id_a ), nullptr );
+	EXPECT_EQ( *sut.find_type( id_a ), typeid( test_registered_t ) );
+	EXPECT_EQ( *sut.find_type( id_c ), typeid( float ) );
+	EXPECT_EQ( sut.find_type( 0x5678 ), nullptr );
+}
+
+TEST( TestTypeRegistry, ConflictRegistration_ThenThrowLogicError )
+{
+	// Arrange
+	auto& sut = yan::type_registry::get_instance();
+	sut.register_type<test_registered_t>( 0x1234 );
+
+	// Act
+	// Assert
+	EXPECT_NO_THROW( sut.register_type<test_registered_t>( 0x1234 ) );
+	EXPECT_THROW( sut.register_type<test_registered_t>( 0x1235 ), std::logic_error );
+	EXPECT_THROW( sut.register_type<test_not_registered_t>( 0x1234 ), std::logic_error );
+	EXPECT_THROW( sut.register_type<test_not_registered_t>( 0 ), std::logic_error );
+	EXPECT_EQ( yan::type_registry::id_of<test_not_registered_t>(), 0 );
+}
+
+TEST( TestTypeRegistry, ConstrainedAny_ThenStableTypeIdOfValue )
+{
+	// Arrange
+	auto& registry = yan::type_registry::get_instance();
+	registry.register_type<test_registered_t>( 0x1234 );
+	uint64_t id_large = registry.register_type<test_large_registered_t>( "test_large_registered_t" );
+
+	// Act
+	yan::copyable_any sut_empty;
+	yan::copyable_any sut_small( test_registered_t { 1 } );
+	yan::copyable_any sut_large( test_large_registered_t {} );
+	yan::copyable_any sut_not_registered( test_not_registered_t { 1 } );
+	yan::keyable_any  sut_keyable( std::string( "a" ) );
+
+	// Assert
+	EXPECT_EQ( sut_empty.stable_type_id(), 0 );
+	EXPECT_EQ( sut_small.stable_type_id(), 0x1234 );
+	EXPECT_EQ( sut_large.stable_type_id(), id_large );
+	EXPECT_EQ( sut_not_registered.stable_type_id(), 0 );
+	EXPECT_EQ( sut_keyable.stable_type_id(), yan::type_registry::id_of<std::string>() );
+}